@@ -29,6 +29,9 @@
 
 #include <gpgme.h>
 
+#include <atomic>
+#include <mutex>
+
 #include "core/function/CoreSignalStation.h"
 #include "core/function/GlobalSettingStation.h"
 #include "core/function/basic/ChannelObject.h"
@@ -36,7 +39,7 @@
 #include "core/function/gpg/GpgContext.h"
 #include "core/function/gpg/GpgKeyGetter.h"
 #include "core/module/ModuleManager.h"
-#include "core/thread/Task.h"
+#include "core/thread/ReadinessBarrier.h"
 #include "core/thread/TaskRunnerGetter.h"
 #include "core/utils/CommonUtils.h"
 #include "core/utils/GpgUtils.h"
@@ -461,18 +464,154 @@ auto InitBasicPath() -> bool {
   return true;
 }
 
+/**
+ * @brief fill the key cache of the channel. a valid key snapshot is shown
+ * right away and checked against a full listing in the background, which
+ * reports the rows that differ through SignalKeysChanged.
+ *
+ */
+auto LoadKeyCache(int channel) -> bool {
+  auto& getter = GpgKeyGetter::GetInstance(channel);
+  if (!getter.LoadKeyCacheSnapshot()) return getter.FlushKeyCache();
+
+  // the full listing blocks on gpg, keep it away from the shared executor
+  Thread::TaskRunnerGetter::GetInstance()
+      .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_Key_Database)
+      ->PostTask(
+          "reconcile_key_cache",
+          [channel](const DataObjectPtr&) -> int {
+            QElapsedTimer timer;
+            timer.start();
+
+            auto fprs = GpgKeyGetter::GetInstance(channel).ReconcileKeyCache();
+            LOG_I() << "key snapshot of channel" << channel
+                    << "reconciled in" << timer.elapsed() << "ms,"
+                    << fprs.size() << "key(s) changed";
+
+            if (fprs.isEmpty()) return 0;
+            emit CoreSignalStation::GetInstance()->SignalKeysChanged(channel,
+                                                                     fprs);
+            return 0;
+          },
+          nullptr, nullptr);
+  return true;
+}
+
+/**
+ * @brief create the context of a key database at the channel and list its
+ * keys, may run on any thread.
+ *
+ */
+auto InitKeyDatabase(int channel, const KeyDatabaseInfo& key_db,
+                     GpgContextInitArgs args) -> bool {
+  // set key database path
+  if (!key_db.path.isEmpty()) {
+    args.db_name = key_db.name;
+    args.db_path = key_db.path;
+  }
+
+  LOG_D() << "new gpgme context, channel" << channel << ", key db name"
+          << args.db_name << "key db path" << args.db_path;
+
+  // build the context before taking the singleton lock, so that key
+  // databases being loaded at the same time do not wait for each other
+  auto ctx_obj = ConvertToChannelObjectPtr<>(
+      SecureCreateUniqueObject<GpgContext>(args, channel));
+  auto& ctx = GpgFrontend::GpgContext::CreateInstance(
+      channel, [&ctx_obj]() -> ChannelObjectPtr { return std::move(ctx_obj); });
+
+  if (!ctx.Good()) {
+    LOG_E() << "gpgme context init failed, channel:" << channel;
+    GpgContext::ReleaseChannel(channel);
+    return false;
+  }
+
+  if (!LoadKeyCache(channel)) {
+    LOG_E() << "gpgme context init key cache failed, channel:" << channel;
+    GpgKeyGetter::ReleaseChannel(channel);
+    GpgContext::ReleaseChannel(channel);
+    return false;
+  }
+
+  return true;
+}
+
+namespace {
+
+constexpr qint64 kExecutorStatisticsIntervalMs = 5000;
+
+// every stage has to resolve before the core is fully loaded
+const QStringList kCoreInitStages = {"gpgme", "basic", "modules"};
+
+std::mutex core_init_barrier_mutex;
+QSharedPointer<Thread::ReadinessBarrier> core_init_barrier;
+
+auto AcquireCoreInitBarrier() -> QSharedPointer<Thread::ReadinessBarrier> {
+  std::lock_guard<std::mutex> lock(core_init_barrier_mutex);
+  return core_init_barrier;
+}
+
+void ReleaseCoreInitBarrier() {
+  std::lock_guard<std::mutex> lock(core_init_barrier_mutex);
+  core_init_barrier.reset();
+}
+
+/**
+ * @brief publish the counters of the concurrent executor to the global
+ * register table every few seconds.
+ *
+ */
+void StartPublishExecutorStatistics() {
+  auto& getter = Thread::TaskRunnerGetter::GetInstance();
+  getter.GetTaskScheduler()->PostPeriodicTask(
+      "core_executor_statistics",
+      getter.GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_IO),
+      []() {
+        auto stats = Thread::TaskRunnerGetter::GetInstance()
+                         .GetConcurrentExecutor()
+                         ->GetStatistics();
+
+        int queued = 0;
+        QStringList depths;
+        for (const auto depth : stats.queue_depths) {
+          queued += depth;
+          depths.append(QString::number(depth));
+        }
+
+        Module::UpsertRTValues(
+            "core",
+            {{"thread.executor.workers", stats.workers},
+             {"thread.executor.queued", queued},
+             {"thread.executor.queue_depths", depths.join(',')},
+             {"thread.executor.steals", static_cast<qint64>(stats.steals)},
+             {"thread.executor.executed",
+              static_cast<qint64>(stats.executed)}});
+      },
+      kExecutorStatisticsIntervalMs);
+}
+
+}  // namespace
+
 auto InitGpgFrontendCore(CoreInitArgs args) -> int {
+  StartPublishExecutorStatistics();
+
   // initialize gpgme
+  BeginCoreInitStage("gpgme");
   if (!InitGpgME()) {
     LOG_E() << "Oops, GpgME init failed!"
             << "GpgFrontend cannot start under this situation!";
     Module::UpsertRTValue("core", "env.state.gpgme", -1);
+    ResolveCoreInitStage("gpgme", false);
     CoreSignalStation::GetInstance()->SignalBadGnupgEnv(
         QCoreApplication::tr("GpgME Initiation Failed"));
     return -1;
   }
 
   Module::UpsertRTValue("core", "env.state.gpgme", 1);
+  ResolveCoreInitStage("gpgme");
+
+  // the caller reports a failure of this stage for every early return
+  BeginCoreInitStage("basic", {"gpgme"});
 
   // decide gpgconf, gnupg and default home path
   if (!InitBasicPath()) {
@@ -506,6 +645,7 @@ auto InitGpgFrontendCore(CoreInitArgs args) -> int {
   // unit test mode
   if (args.unit_test_mode) {
     Module::UpsertRTValue("core", "env.state.basic", 1);
+    ResolveCoreInitStage("basic");
     Module::UpsertRTValue("core", "env.state.key_dbs", 1);
     CoreSignalStation::GetInstance()->SignalGoodGnupgEnv();
     LOG_I() << "Basic ENV Checking Finished";
@@ -556,7 +696,7 @@ auto InitGpgFrontendCore(CoreInitArgs args) -> int {
 
   Module::UpsertRTValue("core", "env.state.ctx", 1);
 
-  if (!GpgKeyGetter::GetInstance(kGpgFrontendDefaultChannel).FlushKeyCache()) {
+  if (!LoadKeyCache(kGpgFrontendDefaultChannel)) {
     LOG_E() << "Init GpgME Default Key Database failed!"
             << "GpgFrontend cannot start under this situation!";
     Module::UpsertRTValue("core", "env.state.ctx", -1);
@@ -566,130 +706,117 @@ auto InitGpgFrontendCore(CoreInitArgs args) -> int {
   };
 
   Module::UpsertRTValue("core", "env.state.basic", 1);
+  ResolveCoreInitStage("basic");
   CoreSignalStation::GetInstance()->SignalGoodGnupgEnv();
   LOG_I() << "Basic ENV Checking Finished";
 
-  auto* task = new Thread::Task(
-      [=](const DataObjectPtr&) -> int {
-        int channel_index = kGpgFrontendDefaultChannel + 1;
-        for (int i = 1; i < key_dbs.size(); i++) {
-          const auto& key_db = key_dbs[i];
-
-          // init ctx, also checking the basic env
-          auto& ctx = GpgFrontend::GpgContext::CreateInstance(
-              channel_index, [=]() -> ChannelObjectPtr {
-                GpgFrontend::GpgContextInitArgs args;
-
-                // set key database path
-                if (!key_db.path.isEmpty()) {
-                  args.db_name = key_db.name;
-                  args.db_path = key_db.path;
-                }
-
-                args.offline_mode = forbid_all_gnupg_connection;
-                args.auto_import_missing_key = auto_import_missing_key;
-                args.use_pinentry = use_pinentry_as_password_input_dialog;
-
-                LOG_D() << "new gpgme context, channel" << channel_index
-                        << ", key db name" << args.db_name << "key db path"
-                        << args.db_path << "";
-
-                return ConvertToChannelObjectPtr<>(
-                    SecureCreateUniqueObject<GpgContext>(args, channel_index));
-              });
-
-          if (!ctx.Good()) {
-            LOG_E() << "gpgme context init failed, index:" << channel_index;
-            continue;
-          }
-
-          if (!GpgKeyGetter::GetInstance(ctx.GetChannel()).FlushKeyCache()) {
-            LOG_E() << "gpgme context init key cache failed, index:"
-                    << channel_index;
-            continue;
-          }
-
-          channel_index++;
-        }
+  Module::UpsertRTValue(
+      "core", QString("env.state.key_db.%1").arg(kGpgFrontendDefaultChannel),
+      1);
 
-        Module::UpsertRTValue("core", "env.state.key_dbs", 1);
+  if (key_dbs.size() <= 1) {
+    Module::UpsertRTValue("core", "env.state.key_dbs", 1);
+    return 0;
+  }
 
-        return 0;
-      },
-      "core_key_dbs_init_task");
+  GpgContextInitArgs key_db_args;
+  key_db_args.offline_mode = forbid_all_gnupg_connection;
+  key_db_args.auto_import_missing_key = auto_import_missing_key;
+  key_db_args.use_pinentry = use_pinentry_as_password_input_dialog;
 
-  QObject::connect(task, &Thread::Task::SignalTaskEnd, []() {
-    LOG_I() << "All Key Database(s) Initialize Finished";
-  });
+  // the ui only needs the default key database, the others are loaded in
+  // the background on the key database runners, which block on gpg instead
+  // of the shared executor. a key database keeps its position in the
+  // settings as its channel.
+  const auto others = static_cast<int>(key_dbs.size()) - 1;
+  auto pending = SecureCreateSharedObject<std::atomic_int>(others);
+  QElapsedTimer timer;
+  timer.start();
+
+  for (int i = 1; i < key_dbs.size(); i++) {
+    const auto channel = kGpgFrontendDefaultChannel + i;
+
+    Module::UpsertRTValue("core", QString("env.state.key_db.%1").arg(channel),
+                          0);
+    auto init = [=, key_db = key_dbs[i]](const DataObjectPtr&) -> int {
+      const auto succeed = InitKeyDatabase(channel, key_db, key_db_args);
+
+      Module::UpsertRTValue("core",
+                            QString("env.state.key_db.%1").arg(channel),
+                            succeed ? 1 : -1);
+      if (succeed) {
+        emit CoreSignalStation::GetInstance()->SignalKeyDatabaseReady(channel);
+      }
 
-  // start the thread to check ctx and gnupg state
-  // it may take a few seconds or minutes
-  GpgFrontend::Thread::TaskRunnerGetter::GetInstance()
-      .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_Default)
-      ->PostTask(task);
+      if (--(*pending) != 0) return 0;
+
+      Module::UpsertRTValue("core", "env.state.key_dbs", 1);
+      LOG_I() << "All Key Database(s) Initialize Finished in"
+              << timer.elapsed() << "ms";
+      return 0;
+    };
+
+    Thread::TaskRunnerGetter::GetInstance()
+        .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_Key_Database)
+        ->PostTask("init_key_database", init, nullptr, nullptr);
+  }
 
   return 0;
 }
 
 void StartMonitorCoreInitializationStatus() {
-  auto* task = new Thread::Task(
-      [=](const DataObjectPtr&) -> int {
-        int core_init_state = Module::RetrieveRTValueTypedOrDefault<>(
-            "core", "env.state.basic", 0);
-        for (;;) {
-          if (core_init_state != 0) break;
-          core_init_state = Module::RetrieveRTValueTypedOrDefault<>(
-              "core", "env.state.basic", 0);
-
-          LOG_D() << "monitor: core env is still initializing, waiting...";
-          QThread::msleep(100);
-        }
+  auto barrier = SecureCreateSharedObject<Thread::ReadinessBarrier>();
 
-        if (core_init_state < 0) return -1;
+  // the stages declare their dependencies when they begin, the barrier
+  // only needs to know what to wait for
+  for (const auto& stage : kCoreInitStages) barrier->AddStage(stage);
 
-        // waiting for module first
-        bool module_init_done =
-            Module::ModuleManager::GetInstance().IsAllModulesRegistered();
-        for (;;) {
-          if (module_init_done) break;
-          module_init_done =
-              Module::ModuleManager::GetInstance().IsAllModulesRegistered();
+  barrier->OnReady([barrier = barrier.get()](bool succeed) {
+    if (!succeed) {
+      LOG_W() << "monitor: core initialization failed.";
+      ReleaseCoreInitBarrier();
+      return;
+    }
 
-          LOG_D() << "monitor: some modules are still going to be registered, "
-                     "waiting...";
-          QThread::msleep(15);
-        }
-        LOG_D() << "monitor: good, all module are registered.";
+    Module::KVList kvs;
+    for (const auto& t : barrier->GetTimings()) {
+      kvs.append({QString("env.startup.%1.started_ms").arg(t.stage),
+                  t.started_ms});
+      kvs.append({QString("env.startup.%1.resolved_ms").arg(t.stage),
+                  t.resolved_ms});
+      kvs.append({QString("env.startup.%1.own_ms").arg(t.stage), t.own_ms});
+      LOG_I() << "startup stage" << t.stage << "started at" << t.started_ms
+              << "ms, resolved at" << t.resolved_ms << "ms, took" << t.own_ms
+              << "ms";
+    }
+    Module::UpsertRTValues("core", kvs);
 
-        int key_db_init_state = Module::RetrieveRTValueTypedOrDefault<>(
-            "core", "env.state.key_dbs", 0);
-        for (;;) {
-          if (key_db_init_state != 0) break;
-          key_db_init_state = Module::RetrieveRTValueTypedOrDefault<>(
-              "core", "env.state.key_dbs", 0);
+    LOG_D() << "monitor: core is fully initialized, sending signal to ui...";
+    Module::UpsertRTValue("core", "env.state.all", 1);
+    emit CoreSignalStation::GetInstance()->SignalCoreFullyLoaded();
 
-          LOG_D() << "monitor: key dbs are still initializing, waiting...";
-          QThread::msleep(15);
-        }
-        LOG_D() << "monitor: good, all key db are loaded.";
+    // nothing reports to it anymore, the resolving caller still holds it
+    ReleaseCoreInitBarrier();
+  });
 
-        LOG_D()
-            << "monitor: core is fully initialized, sending signal to ui...";
-        Module::UpsertRTValue("core", "env.state.all", 1);
-        CoreSignalStation::GetInstance()->SignalCoreFullyLoaded();
-        return 0;
-      },
-      "waiting_core_init_task");
+  std::lock_guard<std::mutex> lock(core_init_barrier_mutex);
+  core_init_barrier = barrier;
+}
 
-  QObject::connect(task, &Thread::Task::SignalTaskEnd, [=]() {
-    LOG_D() << "monitor: monitor task ended, call back to main thead.";
-  });
+void BeginCoreInitStage(const QString& stage,
+                        const QStringList& dependencies) {
+  auto barrier = AcquireCoreInitBarrier();
+  if (barrier == nullptr) return;
+
+  barrier->AddStage(stage, dependencies);
+  barrier->Start(stage);
+}
+
+void ResolveCoreInitStage(const QString& stage, bool succeed) {
+  auto barrier = AcquireCoreInitBarrier();
+  if (barrier == nullptr) return;
 
-  // start the thread to check ctx and gnupg state
-  // it may take a few seconds or minutes
-  GpgFrontend::Thread::TaskRunnerGetter::GetInstance()
-      .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_External_Process)
-      ->PostTask(task);
+  barrier->Resolve(stage, succeed);
 }
 
 }  // namespace GpgFrontend
\ No newline at end of file
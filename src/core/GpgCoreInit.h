@@ -50,11 +50,32 @@ void GF_CORE_EXPORT DestroyGpgFrontendCore();
 auto GF_CORE_EXPORT InitGpgFrontendCore(CoreInitArgs) -> int;
 
 /**
- * @brief
+ * @brief create the barrier of the core initialization stages, must be
+ * called before any stage begins. SignalCoreFullyLoaded is emitted the
+ * moment the last stage resolves.
  *
  */
 void GF_CORE_EXPORT StartMonitorCoreInitializationStatus();
 
+/**
+ * @brief declare the dependencies of a core initialization stage and mark
+ * the start of its work. does nothing once the core is fully loaded.
+ *
+ * @param stage
+ * @param dependencies
+ */
+void GF_CORE_EXPORT BeginCoreInitStage(const QString& stage,
+                                       const QStringList& dependencies = {});
+
+/**
+ * @brief report the work of a core initialization stage as done
+ *
+ * @param stage
+ * @param succeed
+ */
+void GF_CORE_EXPORT ResolveCoreInitStage(const QString& stage,
+                                         bool succeed = true);
+
 /**
  * @brief
  *
@@ -61,7 +61,7 @@ auto CopyData(struct archive *ar, struct archive *aw) -> int {
 
 struct ArchiveReadClientData {
   GFDataExchanger *ex;
-  std::array<std::byte, 1024> buf;
+  std::array<std::byte, 32 * 1024> buf;
   const std::byte *p_buf = buf.data();
 };
 
@@ -29,9 +29,13 @@
 #include "CacheManager.h"
 
 #include <algorithm>
+#include <list>
 #include <shared_mutex>
+#include <utility>
 
 #include "core/function/DataObjectOperator.h"
+#include "core/module/ModuleManager.h"
+#include "core/thread/TaskRunnerGetter.h"
 #include "core/utils/MemoryUtils.h"
 
 namespace GpgFrontend {
@@ -89,36 +93,234 @@ class ThreadSafeMap {
   mutable std::shared_mutex mutex_;
 };
 
+/**
+ * @brief memory bounded LRU cache of the runtime values. the namespace of
+ * a key is the part in front of its first ':', every namespace has its own
+ * quota and evicts its own least recently used entries first.
+ *
+ */
+class RuntimeCache {
+ public:
+  struct Stats {
+    qint64 hits = 0;
+    qint64 misses = 0;
+    qint64 evictions = 0;
+    qint64 expirations = 0;
+    qint64 entries = 0;
+    qint64 bytes = 0;
+  };
+
+  void Insert(const QString& key, QString value, qint64 expire_at) {
+    const auto ns = get_namespace(key);
+    const auto cost = get_cost(key, value);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) erase(it);
+
+    // doesn't fit at all, caching it would only flush everything else
+    if (cost > get_quota(ns) || cost > kMaxBytes) return;
+
+    make_room(ns, cost);
+
+    lru_.push_front(key);
+    auto& ns_lru = ns_lru_[ns];
+    ns_lru.push_front(key);
+
+    Entry entry;
+    entry.value = std::move(value);
+    entry.expire_at = expire_at;
+    entry.cost = cost;
+    entry.ns = ns;
+    entry.lru_it = lru_.begin();
+    entry.ns_lru_it = ns_lru.begin();
+    entries_.insert(key, std::move(entry));
+
+    bytes_ += cost;
+    ns_usage_[ns] += cost;
+  }
+
+  auto Get(const QString& key, qint64 now) -> std::optional<QString> {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+      stats_.misses++;
+      return {};
+    }
+
+    if (it->expire_at >= 0 && now > it->expire_at) {
+      LOG_D() << "hit cache but expired, key: " << key
+              << "expiration timestamp:" << it->expire_at;
+      erase(it);
+      stats_.expirations++;
+      stats_.misses++;
+      return {};
+    }
+
+    // move to the front of both lists
+    lru_.splice(lru_.begin(), lru_, it->lru_it);
+    auto& ns_lru = ns_lru_[it->ns];
+    ns_lru.splice(ns_lru.begin(), ns_lru, it->ns_lru_it);
+
+    stats_.hits++;
+    return it->value;
+  }
+
+  void Remove(const QString& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) erase(it);
+  }
+
+  auto Sweep(qint64 now) -> int {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    int swept = 0;
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (it->expire_at < 0 || now <= it->expire_at) {
+        ++it;
+        continue;
+      }
+      it = erase(it);
+      swept++;
+    }
+
+    stats_.expirations += swept;
+    return swept;
+  }
+
+  void SetQuota(const QString& ns, qint64 bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ns_quota_[ns] = bytes;
+
+    auto& ns_lru = ns_lru_[ns];
+    while (ns_usage_.value(ns) > bytes && !ns_lru.empty()) {
+      erase(entries_.find(ns_lru.back()));
+      stats_.evictions++;
+    }
+  }
+
+  auto GetStats() -> Stats {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto stats = stats_;
+    stats.entries = entries_.size();
+    stats.bytes = bytes_;
+    return stats;
+  }
+
+ private:
+  struct Entry {
+    QString value;
+    qint64 expire_at;  ///< seconds since epoch, -1 never expires
+    qint64 cost;
+    QString ns;
+    std::list<QString>::iterator lru_it;
+    std::list<QString>::iterator ns_lru_it;
+  };
+
+  static constexpr qint64 kMaxBytes = 16 * 1024 * 1024;
+  static constexpr qint64 kDefaultQuota = 4 * 1024 * 1024;
+  static constexpr qint64 kEntryOverhead = 96;
+
+  std::mutex mutex_;
+  QHash<QString, Entry> entries_;
+  std::list<QString> lru_;  ///< most recently used first
+  QHash<QString, std::list<QString>> ns_lru_;
+  QHash<QString, qint64> ns_usage_;
+  QHash<QString, qint64> ns_quota_;
+  qint64 bytes_ = 0;
+  Stats stats_;
+
+  static auto get_namespace(const QString& key) -> QString {
+    auto pos = key.indexOf(':');
+    return pos < 0 ? QString() : key.left(pos);
+  }
+
+  static auto get_cost(const QString& key, const QString& value) -> qint64 {
+    return static_cast<qint64>(key.size() + value.size()) * sizeof(QChar) +
+           kEntryOverhead;
+  }
+
+  auto get_quota(const QString& ns) const -> qint64 {
+    return ns_quota_.value(ns, kDefaultQuota);
+  }
+
+  void make_room(const QString& ns, qint64 cost) {
+    auto& ns_lru = ns_lru_[ns];
+    while (ns_usage_.value(ns) + cost > get_quota(ns) && !ns_lru.empty()) {
+      erase(entries_.find(ns_lru.back()));
+      stats_.evictions++;
+    }
+
+    while (bytes_ + cost > kMaxBytes && !lru_.empty()) {
+      erase(entries_.find(lru_.back()));
+      stats_.evictions++;
+    }
+  }
+
+  auto erase(QHash<QString, Entry>::iterator it)
+      -> QHash<QString, Entry>::iterator {
+    bytes_ -= it->cost;
+    ns_usage_[it->ns] -= it->cost;
+    lru_.erase(it->lru_it);
+    ns_lru_[it->ns].erase(it->ns_lru_it);
+    return entries_.erase(it);
+  }
+};
+
 class CacheManager::Impl : public QObject {
   Q_OBJECT
  public:
-  Impl() : flush_timer_(new QTimer(this)) {
-    connect(flush_timer_, &QTimer::timeout, this,
-            &Impl::slot_flush_cache_storage);
-    flush_timer_->start(15000);
-
+  Impl() {
     // load data from storage
     load_all_cache_storage();
+
+    // drop expired runtime values even if nobody asks for them again
+    auto& getter = Thread::TaskRunnerGetter::GetInstance();
+    sweep_task_id_ = getter.GetTaskScheduler()->PostPeriodicTask(
+        "cache_manager_sweep",
+        getter.GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_IO),
+        guarded(&Impl::slot_sweep_runtime_cache), kSweepIntervalMs);
+  }
+
+  ~Impl() override {
+    auto* scheduler =
+        Thread::TaskRunnerGetter::GetInstance().GetTaskScheduler();
+    scheduler->Cancel(sweep_task_id_);
+
+    {
+      std::lock_guard<std::mutex> lock(dirty_lock_);
+      if (flush_scheduled_) scheduler->Cancel(flush_task_id_);
+    }
+
+    // cancelling doesn't stop a firing which already started, wait for it
+    std::lock_guard<std::mutex> lock(task_guard_->mutex);
+    task_guard_->alive = false;
   }
 
   void SaveDurableCache(QString key, const QJsonDocument& value, bool flush) {
-    auto data_object_key = get_data_object_key(key);
     durable_cache_storage_.insert(key, value);
 
-    if (!key_storage_.contains(key)) {
-      key_storage_.push_back(key);
+    bool key_added = false;
+    {
+      std::lock_guard<std::mutex> lock(key_storage_lock_);
+      if (!key_storage_.contains(key)) {
+        key_storage_.push_back(key);
+        key_added = true;
+      }
     }
 
-    durable_cache_modified_ = true;
-    if (flush) slot_flush_cache_storage();
+    mark_dirty(key, key_added);
+    if (flush) {
+      slot_flush_cache_storage();
+    } else {
+      schedule_flush();
+    }
   }
 
   auto LoadDurableCache(const QString& key) -> QJsonDocument {
-    auto data_object_key = get_data_object_key(key);
-
     if (!durable_cache_storage_.exists(key)) {
       durable_cache_storage_.insert(key, load_cache_storage(key, {}));
-      durable_cache_modified_ = true;
     }
 
     auto cache = durable_cache_storage_.get(key);
@@ -128,82 +330,128 @@ class CacheManager::Impl : public QObject {
 
   auto LoadDurableCache(const QString& key,
                         QJsonDocument default_value) -> QJsonDocument {
-    auto data_object_key = get_data_object_key(key);
     if (!durable_cache_storage_.exists(key)) {
-      durable_cache_storage_.insert(
-          key, load_cache_storage(key, std::move(default_value)));
-      durable_cache_modified_ = true;
+      durable_cache_storage_.insert(key,
+                                    load_cache_storage(key, default_value));
     }
 
+    // a reset entry is kept as a null document until it's gone from disk
     auto cache = durable_cache_storage_.get(key);
-    if (cache.has_value()) return cache.value();
-    return {};
+    if (cache.has_value() && !cache->isNull()) return cache.value();
+    return default_value;
   }
 
   auto ResetDurableCache(const QString& key) -> bool {
-    auto data_object_key = get_data_object_key(key);
-    durable_cache_modified_ = true;
-    return durable_cache_storage_.remove(key);
+    auto cache = durable_cache_storage_.get(key);
+    const bool existed = cache.has_value() && !cache->isNull();
+
+    // keep a null document instead of removing the entry, so neither a load
+    // nor a restart brings the old value back from disk
+    durable_cache_storage_.insert(key, QJsonDocument());
+
+    bool key_removed = false;
+    {
+      std::lock_guard<std::mutex> lock(key_storage_lock_);
+      for (auto i = 0; i < key_storage_.size(); i++) {
+        if (key_storage_.at(i).toString() != key) continue;
+        key_storage_.removeAt(i);
+        key_removed = true;
+        break;
+      }
+    }
+
+    mark_dirty(key, key_removed);
+    schedule_flush();
+    return existed || key_removed;
   }
 
   void FlushCacheStorage() { this->slot_flush_cache_storage(); }
 
+  void SweepRuntimeCache() { this->slot_sweep_runtime_cache(); }
+
   void SaveCache(const QString& key, QString value, qint64 ttl) {
     LOG_D() << "save cache, key: " << key << "ttl: " << ttl;
-    runtime_cache_storage_.insert(
-        key, new CacheObject(
-                 std::move(value),
-                 ttl < 0 ? -1 : QDateTime::currentSecsSinceEpoch() + ttl));
+    runtime_cache_storage_.Insert(
+        key, std::move(value),
+        ttl < 0 ? -1 : QDateTime::currentSecsSinceEpoch() + ttl);
   }
 
   auto LoadCache(const QString& key) -> QString {
-    if (!runtime_cache_storage_.contains(key)) return {};
-    LOG_D() << "hit cache, key: " << key;
+    auto value =
+        runtime_cache_storage_.Get(key, QDateTime::currentSecsSinceEpoch());
+    if (!value.has_value()) return {};
 
-    auto* value = runtime_cache_storage_.object(key);
-    if (value == nullptr) {
-      LOG_E() << "hit cache but got nullptr by value, key" << key;
-      return {};
-    }
-
-    if (value->ttl < 0) {
-      return value->value;
-    }
+    LOG_D() << "hit cache, key: " << key;
+    return value.value();
+  }
 
-    // deal with expiration
-    auto current_timestamp = QDateTime::currentSecsSinceEpoch();
-    if (current_timestamp > value->ttl) {
-      LOG_D() << "hit cache but expired, key: " << key
-              << "expiration timestamp:" << value->ttl;
-      ResetCache(key);
-      return {};
-    }
+  void ResetCache(const QString& key) { runtime_cache_storage_.Remove(key); }
 
-    return value->value;
+  void SetCacheQuota(const QString& ns, qint64 bytes) {
+    runtime_cache_storage_.SetQuota(ns, bytes);
   }
 
-  void ResetCache(const QString& key) { runtime_cache_storage_.remove(key); }
-
  private slots:
 
+  /**
+   * @brief drop the expired runtime values and publish the counters of the
+   * runtime cache to the global register table.
+   *
+   */
+  void slot_sweep_runtime_cache() {
+    auto swept =
+        runtime_cache_storage_.Sweep(QDateTime::currentSecsSinceEpoch());
+    if (swept > 0) LOG_D() << "swept expired runtime cache entries:" << swept;
+
+    auto stats = runtime_cache_storage_.GetStats();
+    Module::UpsertRTValues(
+        "core", {{"cache.runtime.hits", stats.hits},
+                 {"cache.runtime.misses", stats.misses},
+                 {"cache.runtime.evictions", stats.evictions},
+                 {"cache.runtime.expirations", stats.expirations},
+                 {"cache.runtime.entries", stats.entries},
+                 {"cache.runtime.bytes", stats.bytes}});
+  }
+
   /**
    * @brief
    *
    */
   void slot_flush_cache_storage() {
-    if (!durable_cache_modified_) return;
+    // called from the io runner and from the caller of a forced flush
+    std::lock_guard<std::mutex> flush_lock(flush_lock_);
+
+    QSet<QString> dirty_keys;
+    bool key_list_dirty = false;
+    {
+      std::lock_guard<std::mutex> lock(dirty_lock_);
+      dirty_keys.swap(dirty_keys_);
+      key_list_dirty = std::exchange(key_list_dirty_, false);
+      flush_scheduled_ = false;
+    }
+    if (dirty_keys.isEmpty() && !key_list_dirty) return;
+
+    FLOG_D("update durable cache to disk, dirty entries: %d",
+           static_cast<int>(dirty_keys.size()));
 
-    FLOG_D("update durable cache to disk...");
+    // entries first, so the key list never names an entry not on disk yet
+    for (const auto& key : dirty_keys) {
+      auto cache = durable_cache_storage_.get(key);
+      if (!cache.has_value()) continue;
 
-    for (const auto& cache : durable_cache_storage_.mirror()) {
-      auto key = get_data_object_key(cache.first);
       GpgFrontend::DataObjectOperator::GetInstance().SaveDataObj(
-          key, QJsonDocument(cache.second));
+          get_data_object_key(key), cache.value());
     }
-    GpgFrontend::DataObjectOperator::GetInstance().SaveDataObj(
-        drk_key_, QJsonDocument(key_storage_));
 
-    durable_cache_modified_ = false;
+    if (!key_list_dirty) return;
+
+    QJsonArray key_storage;
+    {
+      std::lock_guard<std::mutex> lock(key_storage_lock_);
+      key_storage = key_storage_;
+    }
+    GpgFrontend::DataObjectOperator::GetInstance().SaveDataObj(
+        drk_key_, QJsonDocument(key_storage));
   }
 
  private:
@@ -231,7 +479,10 @@ class CacheManager::Impl : public QObject {
         GpgFrontend::DataObjectOperator::GetInstance().GetDataObject(
             data_object_key);
 
-    if (stored_data.has_value()) return stored_data.value();
+    // a reset entry is stored as a null document
+    if (stored_data.has_value() && !stored_data->isNull()) {
+      return stored_data.value();
+    }
     return default_value;
   }
 
@@ -257,6 +508,7 @@ class CacheManager::Impl : public QObject {
       load_cache_storage(key.toString(), {});
     }
 
+    std::lock_guard<std::mutex> lock(key_storage_lock_);
     key_storage_ = registered_key_list;
   }
 
@@ -264,23 +516,70 @@ class CacheManager::Impl : public QObject {
    * @brief
    *
    * @param key
+   * @param key_list
    */
-  void register_cache_key(const QString& key) {}
+  void mark_dirty(const QString& key, bool key_list) {
+    std::lock_guard<std::mutex> lock(dirty_lock_);
+    dirty_keys_.insert(key);
+    if (key_list) key_list_dirty_ = true;
+  }
 
-  struct CacheObject {
-    QString value;
-    qint64 ttl;
+  /**
+   * @brief wrap a slot for the task scheduler, the callback keeps the guard
+   * alive and does nothing once this object is being destroyed.
+   *
+   * @param slot
+   * @return Thread::TaskScheduler::Callback
+   */
+  auto guarded(void (Impl::*slot)()) -> Thread::TaskScheduler::Callback {
+    return [this, guard = task_guard_, slot]() {
+      std::lock_guard<std::mutex> lock(guard->mutex);
+      if (guard->alive) (this->*slot)();
+    };
+  }
+
+  /**
+   * @brief write the dirty entries behind on the io runner, saves in quick
+   * succession are coalesced into one flush.
+   *
+   */
+  void schedule_flush() {
+    std::lock_guard<std::mutex> lock(dirty_lock_);
+    if (flush_scheduled_) return;
+
+    auto& getter = Thread::TaskRunnerGetter::GetInstance();
+    flush_task_id_ = getter.GetTaskScheduler()->PostDelayedTask(
+        "cache_manager_flush",
+        getter.GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_IO),
+        guarded(&Impl::slot_flush_cache_storage), kFlushDelayMs);
+    flush_scheduled_ = true;
+  }
 
-    CacheObject(QString value, qint64 ttl)
-        : value(std::move(value)), ttl(ttl) {}
+  /**
+   * @brief held by the scheduled callbacks while they run
+   *
+   */
+  struct TaskGuard {
+    std::mutex mutex;
+    bool alive = true;
   };
 
-  QCache<QString, CacheObject> runtime_cache_storage_;
+  QSharedPointer<TaskGuard> task_guard_ = QSharedPointer<TaskGuard>::create();
+  RuntimeCache runtime_cache_storage_;
   ThreadSafeMap<QString, QJsonDocument> durable_cache_storage_;
   QJsonArray key_storage_;
-  QTimer* flush_timer_;
+  std::mutex key_storage_lock_;
+  std::mutex flush_lock_;
+  std::mutex dirty_lock_;
+  QSet<QString> dirty_keys_;
+  bool key_list_dirty_ = false;
+  bool flush_scheduled_ = false;
+  Thread::TaskScheduler::ScheduleID flush_task_id_;
+  Thread::TaskScheduler::ScheduleID sweep_task_id_;
   const QString drk_key_ = "__cache_manage_data_register_key_list";
-  std::atomic<bool> durable_cache_modified_{};
+
+  static constexpr qint64 kFlushDelayMs = 2000;
+  static constexpr qint64 kSweepIntervalMs = 30000;
 };
 
 CacheManager::CacheManager(int channel)
@@ -318,6 +617,12 @@ auto CacheManager::LoadCache(const QString& key) -> QString {
 void CacheManager::ResetCache(const QString& key) {
   return p_->ResetCache(key);
 }
+
+void CacheManager::SetCacheQuota(const QString& ns, qint64 bytes) {
+  p_->SetCacheQuota(ns, bytes);
+}
+
+void CacheManager::SweepCache() { p_->SweepRuntimeCache(); }
 }  // namespace GpgFrontend
 
 #include "CacheManager.moc"
\ No newline at end of file
@@ -110,6 +110,22 @@ class GF_CORE_EXPORT CacheManager
    */
   auto ResetDurableCache(const QString& key) -> bool;
 
+  /**
+   * @brief limit the memory the runtime values of a namespace may take,
+   * the namespace of a key is the part in front of its first ':'.
+   *
+   * @param ns
+   * @param bytes
+   */
+  void SetCacheQuota(const QString& ns, qint64 bytes);
+
+  /**
+   * @brief drop the expired runtime values now and publish the counters of
+   * the runtime cache (core, cache.runtime.*). also runs periodically.
+   *
+   */
+  void SweepCache();
+
  private:
   class Impl;
   SecureUniquePtr<Impl> p_;
@@ -73,6 +73,20 @@ class GF_CORE_EXPORT CoreSignalStation : public QObject {
    *
    */
   void SignalCoreFullyLoaded();
+
+  /**
+   * @brief a key database other than the default one finished loading in
+   * the background
+   *
+   */
+  void SignalKeyDatabaseReady(int channel);
+
+  /**
+   * @brief the keys with these fingerprints were re-listed, added or
+   * removed in the key database of the channel
+   *
+   */
+  void SignalKeysChanged(int channel, QStringList fprs);
 };
 
 }  // namespace GpgFrontend
@@ -28,13 +28,25 @@
 
 #include "DataObjectOperator.h"
 
+#include <openssl/rand.h>
 #include <qt-aes/qaesencryption.h>
 
 #include "core/function/PassphraseGenerator.h"
 #include "core/utils/IOUtils.h"
+#include "core/utils/aes/aes_ssl.h"
 
 namespace GpgFrontend {
 
+namespace {
+
+constexpr const char* kDataObjectMagic = "GFDO";
+constexpr char kDataObjectVersion = 0x02;
+constexpr int kDataObjectHeaderSize = 5;
+constexpr int kDataObjectNonceSize = 12;
+constexpr int kDataObjectTagSize = 16;
+
+}  // namespace
+
 void DataObjectOperator::init_app_secure_key() {
   WriteFile(app_secure_key_path_,
             PassphraseGenerator::GetInstance().Generate(256).toUtf8());
@@ -55,100 +67,239 @@ DataObjectOperator::DataObjectOperator(int channel)
   }
 
   hash_key_ = QCryptographicHash::hash(key, QCryptographicHash::Sha256);
+  gcm_key_ = QMessageAuthenticationCode::hash("GpgFrontend Data Object v2",
+                                              hash_key_,
+                                              QCryptographicHash::Sha256);
 
   if (!QDir(app_data_objs_path_).exists()) {
     QDir(app_data_objs_path_).mkpath(".");
   }
+
+  if (!QFileInfo(app_data_objs_migrated_path_).exists()) {
+    migrate_legacy_data_objects();
+  }
 }
 
 auto DataObjectOperator::SaveDataObj(const QString& key,
                                      const QJsonDocument& value) -> QString {
-  QByteArray hash_obj_key;
+  QString obj_name;
   if (key.isEmpty()) {
-    hash_obj_key =
-        QCryptographicHash::hash(
-            hash_key_ +
-                PassphraseGenerator::GetInstance().Generate(32).toUtf8() +
-                QDateTime::currentDateTime().toString().toUtf8(),
-            QCryptographicHash::Sha256)
-            .toHex();
+    auto salt = PassphraseGenerator::GetInstance().Generate(32).toUtf8() +
+                QDateTime::currentDateTime().toString().toUtf8();
+    obj_name = QCryptographicHash::hash(hash_key_ + salt,
+                                        QCryptographicHash::Sha256)
+                   .toHex();
   } else {
-    hash_obj_key = QCryptographicHash::hash(hash_key_ + key.toUtf8(),
-                                            QCryptographicHash::Sha256)
-                       .toHex();
+    obj_name = get_object_name(key);
   }
 
-  const auto target_obj_path = app_data_objs_path_ + "/" + hash_obj_key;
-  auto encoded_data =
-      QAESEncryption(QAESEncryption::AES_256, QAESEncryption::ECB,
-                     QAESEncryption::Padding::ISO)
-          .encode(value.toJson(), hash_key_);
-
   // recreate if not exists
   if (!QDir(app_data_objs_path_).exists()) {
     QDir(app_data_objs_path_).mkpath(".");
   }
 
-  if (!WriteFile(target_obj_path, encoded_data)) {
+  if (!write_data_object(obj_name, value.toJson(QJsonDocument::Compact))) {
     LOG_W() << "failed to write data object to disk: " << key;
   }
-  return key.isEmpty() ? hash_obj_key : QString();
+  return key.isEmpty() ? obj_name : QString();
 }
 
 auto DataObjectOperator::GetDataObject(const QString& key)
     -> std::optional<QJsonDocument> {
-  try {
-    auto hash_obj_key = QCryptographicHash::hash(hash_key_ + key.toUtf8(),
-                                                 QCryptographicHash::Sha256)
-                            .toHex();
+  auto obj = read_data_object(get_object_name(key));
+  if (!obj.has_value()) {
+    LOG_W() << "data object not found from disk, key: " << key;
+  }
+  return obj;
+}
+
+auto DataObjectOperator::GetDataObjectByRef(const QString& _ref)
+    -> std::optional<QJsonDocument> {
+  if (_ref.size() != 64) return {};
+  return read_data_object(_ref);
+}
+
+auto DataObjectOperator::get_object_name(const QString& key) -> QString {
+  std::lock_guard<std::mutex> lock(objs_cache_mutex_);
+
+  auto it = obj_names_.constFind(key);
+  if (it != obj_names_.constEnd()) return it.value();
+
+  auto name = QString::fromLatin1(
+      QCryptographicHash::hash(hash_key_ + key.toUtf8(),
+                               QCryptographicHash::Sha256)
+          .toHex());
+  obj_names_.insert(key, name);
+  return name;
+}
 
-    const auto obj_path = app_data_objs_path_ + "/" + hash_obj_key;
-    if (!QFileInfo(obj_path).exists()) {
-      LOG_W() << "data object not found from disk, key: " << key;
+auto DataObjectOperator::read_data_object(const QString& name)
+    -> std::optional<QJsonDocument> {
+  const auto obj_path = app_data_objs_path_ + "/" + name;
+  if (!QFileInfo(obj_path).exists()) return {};
+
+  QByteArray encoded_data;
+  if (!ReadFile(obj_path, encoded_data)) {
+    LOG_W() << "failed to read data object from disk: " << name;
+    return {};
+  }
+
+  QByteArray data;
+  if (encoded_data.startsWith(kDataObjectMagic)) {
+    auto decoded = decode_data_object(name, encoded_data);
+    if (!decoded.has_value()) {
+      LOG_W() << "failed to authenticate data object: " << name;
       return {};
     }
+    data = *decoded;
+  } else {
+    // left behind by an interrupted migration, convert it now
+    data = decode_legacy_data_object(encoded_data);
+    auto doc = QJsonDocument::fromJson(data);
+    if (!doc.isNull()) {
+      write_data_object(name, doc.toJson(QJsonDocument::Compact));
+    }
+    return doc;
+  }
 
-    QByteArray encoded_data;
-    if (!ReadFile(obj_path, encoded_data)) {
-      LOG_W() << "failed to read data object from disk, key: " << key;
-      return {};
+  {
+    std::lock_guard<std::mutex> lock(objs_cache_mutex_);
+    obj_digests_.insert(
+        name, QCryptographicHash::hash(data, QCryptographicHash::Sha256));
+  }
+  return QJsonDocument::fromJson(data);
+}
+
+auto DataObjectOperator::write_data_object(const QString& name,
+                                           const QByteArray& data) -> bool {
+  const auto obj_path = app_data_objs_path_ + "/" + name;
+  auto digest = QCryptographicHash::hash(data, QCryptographicHash::Sha256);
+
+  {
+    std::lock_guard<std::mutex> lock(objs_cache_mutex_);
+    if (obj_digests_.value(name) == digest && QFileInfo(obj_path).exists()) {
+      return true;
     }
+  }
 
-    QAESEncryption encryption(QAESEncryption::AES_256, QAESEncryption::ECB,
-                              QAESEncryption::Padding::ISO);
+  auto encoded_data = encode_data_object(name, data);
+  if (encoded_data.isEmpty()) return false;
 
-    auto decoded_data =
-        encryption.removePadding(encryption.decode(encoded_data, hash_key_));
+  // written next to the target and renamed over it on commit, so a crash
+  // never leaves a truncated object behind
+  QSaveFile file(obj_path);
+  if (!file.open(QIODevice::WriteOnly) ||
+      file.write(encoded_data) != encoded_data.size() || !file.commit()) {
+    LOG_W() << "failed to commit data object: " << obj_path;
+    return false;
+  }
 
-    return QJsonDocument::fromJson(decoded_data);
-  } catch (...) {
-    LOG_W() << "failed to get data object:" << key << " caught exception.";
+  std::lock_guard<std::mutex> lock(objs_cache_mutex_);
+  obj_digests_.insert(name, digest);
+  return true;
+}
+
+auto DataObjectOperator::encode_data_object(const QString& name,
+                                            const QByteArray& data)
+    -> QByteArray {
+  QByteArray header(kDataObjectMagic);
+  header.append(kDataObjectVersion);
+
+  QByteArray nonce(kDataObjectNonceSize, Qt::Uninitialized);
+  if (RAND_bytes(reinterpret_cast<uint8_t*>(nonce.data()),
+                 kDataObjectNonceSize) != 1) {
+    LOG_W() << "failed to generate nonce of data object: " << name;
     return {};
   }
-}
 
-auto DataObjectOperator::GetDataObjectByRef(const QString& _ref)
-    -> std::optional<QJsonDocument> {
-  if (_ref.size() != 64) return {};
+  const auto aad = header + name.toUtf8();
+  QByteArray cipher(data.size(), Qt::Uninitialized);
+  QByteArray tag(kDataObjectTagSize, Qt::Uninitialized);
 
-  try {
-    const auto& hash_obj_key = _ref;
-    const auto obj_path = app_data_objs_path_ + "/" + hash_obj_key;
+  if (!RawAPI::aes_256_gcm_encrypt(
+          reinterpret_cast<const uint8_t*>(gcm_key_.constData()),
+          reinterpret_cast<const uint8_t*>(nonce.constData()),
+          kDataObjectNonceSize,
+          reinterpret_cast<const uint8_t*>(aad.constData()),
+          static_cast<int>(aad.size()),
+          reinterpret_cast<const uint8_t*>(data.constData()),
+          static_cast<int>(data.size()),
+          reinterpret_cast<uint8_t*>(cipher.data()),
+          reinterpret_cast<uint8_t*>(tag.data()))) {
+    LOG_W() << "failed to encrypt data object: " << name;
+    return {};
+  }
 
-    if (!QFileInfo(obj_path).exists()) return {};
+  return header + nonce + cipher + tag;
+}
 
-    QByteArray encoded_data;
-    if (!ReadFile(obj_path, encoded_data)) return {};
+auto DataObjectOperator::decode_data_object(const QString& name,
+                                            const QByteArray& encoded)
+    -> std::optional<QByteArray> {
+  constexpr auto kOverhead =
+      kDataObjectHeaderSize + kDataObjectNonceSize + kDataObjectTagSize;
+  if (encoded.size() < kOverhead ||
+      encoded.at(kDataObjectHeaderSize - 1) != kDataObjectVersion) {
+    return {};
+  }
 
-    QAESEncryption encryption(QAESEncryption::AES_256, QAESEncryption::ECB,
-                              QAESEncryption::Padding::ISO);
+  const auto aad = encoded.left(kDataObjectHeaderSize) + name.toUtf8();
+  const auto* nonce = encoded.constData() + kDataObjectHeaderSize;
+  const auto* cipher = nonce + kDataObjectNonceSize;
+  const auto cipher_size = encoded.size() - kOverhead;
+  const auto* tag = cipher + cipher_size;
 
-    auto decoded_data =
-        encryption.removePadding(encryption.decode(encoded_data, hash_key_));
+  QByteArray data(cipher_size, Qt::Uninitialized);
+  if (!RawAPI::aes_256_gcm_decrypt(
+          reinterpret_cast<const uint8_t*>(gcm_key_.constData()),
+          reinterpret_cast<const uint8_t*>(nonce), kDataObjectNonceSize,
+          reinterpret_cast<const uint8_t*>(aad.constData()),
+          static_cast<int>(aad.size()),
+          reinterpret_cast<const uint8_t*>(cipher),
+          static_cast<int>(cipher_size),
+          reinterpret_cast<const uint8_t*>(tag),
+          reinterpret_cast<uint8_t*>(data.data()))) {
+    return {};
+  }
+  return data;
+}
 
-    return QJsonDocument::fromJson(decoded_data);
+auto DataObjectOperator::decode_legacy_data_object(const QByteArray& encoded)
+    -> QByteArray {
+  try {
+    QAESEncryption encryption(QAESEncryption::AES_256, QAESEncryption::ECB,
+                              QAESEncryption::Padding::ISO);
+    return encryption.removePadding(encryption.decode(encoded, hash_key_));
   } catch (...) {
+    LOG_W() << "failed to decode legacy data object, caught exception.";
     return {};
   }
 }
-}  // namespace GpgFrontend
\ No newline at end of file
+
+void DataObjectOperator::migrate_legacy_data_objects() {
+  int converted = 0;
+  for (const auto& info :
+       QDir(app_data_objs_path_).entryInfoList(QDir::Files)) {
+    QByteArray encoded_data;
+    if (!ReadFile(info.absoluteFilePath(), encoded_data) ||
+        encoded_data.startsWith(kDataObjectMagic)) {
+      continue;
+    }
+
+    auto doc =
+        QJsonDocument::fromJson(decode_legacy_data_object(encoded_data));
+    if (doc.isNull()) {
+      LOG_W() << "skip undecodable legacy data object: " << info.fileName();
+      continue;
+    }
+
+    if (write_data_object(info.fileName(),
+                          doc.toJson(QJsonDocument::Compact))) {
+      converted++;
+    }
+  }
+
+  LOG_D() << "converted legacy data objects:" << converted;
+  WriteFile(app_data_objs_migrated_path_, QByteArray::number(converted));
+}
+}  // namespace GpgFrontend
@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <mutex>
 #include <optional>
 
 #include "core/function/GlobalSettingStation.h"
@@ -59,6 +60,69 @@ class GF_CORE_EXPORT DataObjectOperator
    */
   void init_app_secure_key();
 
+  /**
+   * @brief file name of the data object, hashing the key is memoized
+   *
+   * @param key
+   * @return QString
+   */
+  auto get_object_name(const QString &key) -> QString;
+
+  /**
+   * @brief read and decrypt a data object, objects of the legacy format are
+   * converted on the way.
+   *
+   * @param name
+   * @return std::optional<QJsonDocument>
+   */
+  auto read_data_object(const QString &name) -> std::optional<QJsonDocument>;
+
+  /**
+   * @brief encrypt and write a data object, unless it has the content it
+   * was last read or written with.
+   *
+   * @param name
+   * @param data
+   * @return true
+   * @return false
+   */
+  auto write_data_object(const QString &name, const QByteArray &data) -> bool;
+
+  /**
+   * @brief AES-256-GCM container: magic, version, nonce, ciphertext, tag.
+   * the object name is authenticated too, so objects can't be swapped.
+   *
+   * @param name
+   * @param data
+   * @return QByteArray
+   */
+  auto encode_data_object(const QString &name, const QByteArray &data)
+      -> QByteArray;
+
+  /**
+   * @brief
+   *
+   * @param name
+   * @param encoded
+   * @return std::optional<QByteArray>
+   */
+  auto decode_data_object(const QString &name, const QByteArray &encoded)
+      -> std::optional<QByteArray>;
+
+  /**
+   * @brief decode an object written with AES-256-ECB by older versions
+   *
+   * @param encoded
+   * @return QByteArray
+   */
+  auto decode_legacy_data_object(const QByteArray &encoded) -> QByteArray;
+
+  /**
+   * @brief convert all objects of the legacy format once
+   *
+   */
+  void migrate_legacy_data_objects();
+
   GlobalSettingStation &global_setting_station_ =
       GlobalSettingStation::GetInstance();  ///< GlobalSettingStation
   QString app_secure_path_ =
@@ -69,8 +133,16 @@ class GF_CORE_EXPORT DataObjectOperator
       "/app.key";  ///< Where the key of data object is stored
   QString app_data_objs_path_ =
       global_setting_station_.GetAppDataPath() + "/data_objs";
+  QString app_data_objs_migrated_path_ =
+      app_secure_path_ +
+      "/data_objs.v2";  ///< Exists once legacy objects were converted
 
   QByteArray hash_key_;  ///< Hash key
+  QByteArray gcm_key_;   ///< Key of the data object container
+
+  std::mutex objs_cache_mutex_;
+  QHash<QString, QString> obj_names_;       ///< key -> object name
+  QHash<QString, QByteArray> obj_digests_;  ///< name -> digest of content
 };
 
 }  // namespace GpgFrontend
@@ -29,11 +29,14 @@
 #include "KeyPackageOperator.h"
 
 #include <qglobal.h>
-#include <qt-aes/qaesencryption.h>
+
+#include <cerrno>
 
 #include "core/function/KeyPackageOperator.h"
+#include "core/function/KeyPackageStream.h"
 #include "core/function/PassphraseGenerator.h"
 #include "core/function/gpg/GpgKeyImportExporter.h"
+#include "core/model/GpgData.h"
 #include "core/model/GpgImportInformation.h"
 #include "core/typedef/CoreTypedef.h"
 #include "core/utils/AsyncUtils.h"
@@ -55,34 +58,46 @@ void KeyPackageOperator::GenerateKeyPackage(const QString& key_package_path,
                                             const GpgAbstractKeyPtrList& keys,
                                             QString& phrase, bool secret,
                                             const OperationCallback& cb) {
-  GpgKeyImportExporter::GetInstance(channel).ExportAllKeys(
-      keys, secret, true, [=](GpgError err, const DataObjectPtr& data_obj) {
-        if (CheckGpgError(err) != GPG_ERR_NO_ERROR) {
-          LOG_W() << "export keys error, reason: "
-                  << DescribeGpgErrCode(err).second;
-          cb(-1, data_obj);
-          return;
+  auto hash_key =
+      QCryptographicHash::hash(phrase.toUtf8(), QCryptographicHash::Sha256);
+
+  RunGpgOperaAsync(
+      channel,
+      [=](const DataObjectPtr&) -> GpgError {
+        KeyPackageWriter writer(key_package_path, hash_key);
+        if (!writer.Open()) {
+          LOG_W() << "failed to open key package: " << key_package_path;
+          return GPG_ERR_EIO;
         }
 
-        if (CheckGpgError(err) == GPG_ERR_USER_1 || data_obj == nullptr ||
-            !data_obj->Check<GFBuffer>()) {
-          cb(-1, data_obj);
-          return;
+        // the package is encoded while gpgme exports the keys into it
+        GpgData data_out(GpgData::StreamCallbacks{
+            nullptr, [&](const void* buffer, size_t size) -> ssize_t {
+              if (!writer.Write(static_cast<const char*>(buffer),
+                                static_cast<qsizetype>(size))) {
+                errno = EIO;
+                return -1;
+              }
+              return static_cast<ssize_t>(size);
+            }});
+
+        auto err = GpgKeyImportExporter::GetInstance(channel).ExportAllKeys(
+            keys, secret, true, data_out);
+        if (CheckGpgError(err) == GPG_ERR_NO_ERROR && !writer.Finish()) {
+          err = GPG_ERR_EIO;
         }
 
-        auto gf_buffer = ExtractParams<GFBuffer>(data_obj, 0);
-
-        auto data = gf_buffer.ConvertToQByteArray().toBase64();
-        auto hash_key = QCryptographicHash::hash(phrase.toUtf8(),
-                                                 QCryptographicHash::Sha256);
-        QAESEncryption encryption(QAESEncryption::AES_256, QAESEncryption::ECB,
-                                  QAESEncryption::Padding::ISO);
-        auto encoded_data = encryption.encode(data, hash_key);
-
-        cb(WriteFile(key_package_path, encoded_data) ? 0 : -1,
-           TransferParams());
-        return;
-      });
+        if (CheckGpgError(err) != GPG_ERR_NO_ERROR) {
+          LOG_W() << "export keys error, reason: "
+                  << DescribeGpgErrCode(err).second;
+          writer.Discard();
+        }
+        return err;
+      },
+      [=](GpgError err, const DataObjectPtr& data_obj) {
+        cb(CheckGpgError(err) == GPG_ERR_NO_ERROR ? 0 : -1, data_obj);
+      },
+      "gpgme_op_export_keys", "2.1.0");
 }
 
 void KeyPackageOperator::ImportKeyPackage(const QString& key_package_path,
@@ -91,14 +106,6 @@ void KeyPackageOperator::ImportKeyPackage(const QString& key_package_path,
                                           const OperationCallback& cb) {
   RunOperaAsync(
       [=](const DataObjectPtr& data_object) -> GFError {
-        QByteArray encrypted_data;
-        ReadFile(key_package_path, encrypted_data);
-
-        if (encrypted_data.isEmpty()) {
-          LOG_W() << "failed to read key package: " << key_package_path;
-          return -1;
-        };
-
         QByteArray passphrase;
         ReadFile(phrase_path, passphrase);
         if (passphrase.size() != 256) {
@@ -108,22 +115,31 @@ void KeyPackageOperator::ImportKeyPackage(const QString& key_package_path,
 
         auto hash_key =
             QCryptographicHash::hash(passphrase, QCryptographicHash::Sha256);
-        auto encoded = encrypted_data;
 
-        QAESEncryption encryption(QAESEncryption::AES_256, QAESEncryption::ECB,
-                                  QAESEncryption::Padding::ISO);
+        KeyPackageReader reader(key_package_path, hash_key);
+        if (!reader.Open()) {
+          LOG_W() << "failed to read key package: " << key_package_path;
+          return -1;
+        };
 
-        auto decoded =
-            encryption.removePadding(encryption.decode(encoded, hash_key));
-        auto key_data = QByteArray::fromBase64(decoded);
-        if (!key_data.startsWith(PGP_PUBLIC_KEY_BEGIN) &&
-            !key_data.startsWith(PGP_PRIVATE_KEY_BEGIN)) {
+        const auto public_begin = QByteArray(PGP_PUBLIC_KEY_BEGIN);
+        const auto private_begin = QByteArray(PGP_PRIVATE_KEY_BEGIN);
+        auto head =
+            reader.Peek(std::max(public_begin.size(), private_begin.size()));
+        if (!head.startsWith(public_begin) && !head.startsWith(private_begin)) {
           return -1;
         }
 
+        // gpgme pulls the decoded keys chunk by chunk
+        GpgData data_in(GpgData::StreamCallbacks{
+            [&](void* buffer, size_t size) -> ssize_t {
+              return reader.Read(static_cast<char*>(buffer),
+                                 static_cast<qsizetype>(size));
+            },
+            nullptr});
+
         auto import_info_ptr =
-            GpgKeyImportExporter::GetInstance(channel).ImportKey(
-                GFBuffer(key_data));
+            GpgKeyImportExporter::GetInstance(channel).ImportKey(data_in);
         if (import_info_ptr == nullptr) return GPG_ERR_NO_DATA;
 
         auto import_info = *import_info_ptr;
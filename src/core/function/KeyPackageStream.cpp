@@ -0,0 +1,133 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "KeyPackageStream.h"
+
+#include <qt-aes/qaesencryption.h>
+
+#include <cstring>
+
+namespace GpgFrontend {
+
+namespace {
+
+constexpr qsizetype kAESBlockSize = 16;
+
+// a multiple of 3 (base64 groups) which encodes to a multiple of the block
+constexpr qsizetype kRawChunkSize = 3 * kAESBlockSize * 16384;
+
+// a multiple of 4 (base64 groups) and of the block
+constexpr qsizetype kCipherChunkSize = 4 * kAESBlockSize * 16384;
+
+}  // namespace
+
+KeyPackageWriter::KeyPackageWriter(const QString& path, QByteArray key)
+    : file_(path), key_(std::move(key)) {}
+
+auto KeyPackageWriter::Open() -> bool {
+  return file_.open(QIODevice::WriteOnly | QIODevice::Truncate);
+}
+
+auto KeyPackageWriter::Write(const char* data, qsizetype size) -> bool {
+  raw_.append(data, size);
+  if (raw_.size() < kRawChunkSize) return true;
+  return flush(false);
+}
+
+auto KeyPackageWriter::Finish() -> bool { return flush(true) && file_.flush(); }
+
+void KeyPackageWriter::Discard() {
+  file_.close();
+  file_.remove();
+}
+
+auto KeyPackageWriter::flush(bool last) -> bool {
+  auto n = last ? raw_.size() : raw_.size() - raw_.size() % 3;
+  encoded_.append(raw_.left(n).toBase64());
+  raw_.remove(0, n);
+
+  // the package always ends with ISO/IEC 7816-4 padding, a whole block of
+  // it when the encoded payload is already aligned or empty
+  if (last) {
+    encoded_.append('\x80');
+    encoded_.append(QByteArray(
+        (kAESBlockSize - encoded_.size() % kAESBlockSize) % kAESBlockSize,
+        '\0'));
+  }
+
+  auto m = encoded_.size() - encoded_.size() % kAESBlockSize;
+  if (m == 0) return true;
+
+  QAESEncryption encryption(QAESEncryption::AES_256, QAESEncryption::ECB,
+                            QAESEncryption::Padding::ZERO);
+  auto cipher = encryption.encode(encoded_.left(m), key_);
+  encoded_.remove(0, m);
+
+  return file_.write(cipher) == cipher.size();
+}
+
+KeyPackageReader::KeyPackageReader(const QString& path, QByteArray key)
+    : file_(path), key_(std::move(key)) {}
+
+auto KeyPackageReader::Open() -> bool {
+  return file_.open(QIODevice::ReadOnly);
+}
+
+auto KeyPackageReader::Peek(qsizetype size) -> QByteArray {
+  while (decoded_.size() - pos_ < size && !eof_) fill();
+  return decoded_.mid(pos_, size);
+}
+
+auto KeyPackageReader::Read(char* buffer, qsizetype size) -> qsizetype {
+  while (pos_ >= decoded_.size() && !eof_) fill();
+  if (pos_ >= decoded_.size()) return 0;
+
+  auto len = std::min<qsizetype>(size, decoded_.size() - pos_);
+  std::memcpy(buffer, decoded_.constData() + pos_, len);
+  pos_ += len;
+  return len;
+}
+
+void KeyPackageReader::fill() {
+  auto cipher = file_.read(kCipherChunkSize);
+  eof_ = cipher.size() < kCipherChunkSize || file_.atEnd();
+
+  QAESEncryption encryption(QAESEncryption::AES_256, QAESEncryption::ECB,
+                            QAESEncryption::Padding::ISO);
+  auto text = encryption.decode(cipher, key_);
+
+  // the padding is in the last block of the package
+  if (eof_ && !text.isEmpty()) text = encryption.removePadding(text);
+  encoded_.append(text);
+
+  auto n = eof_ ? encoded_.size() : encoded_.size() - encoded_.size() % 4;
+  decoded_ = decoded_.mid(pos_) + QByteArray::fromBase64(encoded_.left(n));
+  encoded_.remove(0, n);
+  pos_ = 0;
+}
+
+}  // namespace GpgFrontend
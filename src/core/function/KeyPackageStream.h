@@ -0,0 +1,153 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#pragma once
+
+namespace GpgFrontend {
+
+/**
+ * @brief writes a key package while the keys are being exported. the
+ * package is the AES-256-ECB encrypted base64 of the exported keys, both
+ * stages only carry a few bytes between chunks, so the output is the same
+ * as encoding the whole export at once.
+ *
+ */
+class GF_CORE_EXPORT KeyPackageWriter {
+ public:
+  /**
+   * @brief Construct a new Key Package Writer object
+   *
+   * @param path
+   * @param key the AES-256 key
+   */
+  KeyPackageWriter(const QString& path, QByteArray key);
+
+  /**
+   * @brief create or truncate the package file
+   *
+   * @return true
+   * @return false
+   */
+  auto Open() -> bool;
+
+  /**
+   * @brief append the next part of the payload
+   *
+   * @param data
+   * @param size
+   * @return true
+   * @return false
+   */
+  auto Write(const char* data, qsizetype size) -> bool;
+
+  /**
+   * @brief write the rest of the payload and the padding block
+   *
+   * @return true
+   * @return false
+   */
+  auto Finish() -> bool;
+
+  /**
+   * @brief close and remove the incomplete package
+   *
+   */
+  void Discard();
+
+ private:
+  QFile file_;
+  QByteArray key_;
+  QByteArray raw_;
+  QByteArray encoded_;
+
+  /**
+   * @brief encode and encrypt everything that is aligned, or everything
+   * with padding for the last chunk
+   *
+   * @param last
+   * @return true
+   * @return false
+   */
+  auto flush(bool last) -> bool;
+};
+
+/**
+ * @brief reads a key package chunk by chunk, decrypting and decoding only
+ * as much as the consumer asks for.
+ *
+ */
+class GF_CORE_EXPORT KeyPackageReader {
+ public:
+  /**
+   * @brief Construct a new Key Package Reader object
+   *
+   * @param path
+   * @param key the AES-256 key
+   */
+  KeyPackageReader(const QString& path, QByteArray key);
+
+  /**
+   * @brief open the package file
+   *
+   * @return true
+   * @return false
+   */
+  auto Open() -> bool;
+
+  /**
+   * @brief get the next bytes of the payload without consuming them
+   *
+   * @param size
+   * @return QByteArray
+   */
+  auto Peek(qsizetype size) -> QByteArray;
+
+  /**
+   * @brief consume the next bytes of the payload
+   *
+   * @param buffer
+   * @param size
+   * @return qsizetype 0 at the end of the payload
+   */
+  auto Read(char* buffer, qsizetype size) -> qsizetype;
+
+ private:
+  QFile file_;
+  QByteArray key_;
+  QByteArray encoded_;
+  QByteArray decoded_;
+  qsizetype pos_ = 0;
+  bool eof_ = false;
+
+  /**
+   * @brief decrypt and decode the next chunk of the package
+   *
+   */
+  void fill();
+};
+
+}  // namespace GpgFrontend
@@ -62,6 +62,7 @@ class SingletonStorage::Impl {
   }
 
   auto GetAllChannelId() -> QContainer<int> {
+    std::shared_lock<std::shared_mutex> lock(instances_mutex_);
     QContainer<int> channels;
     channels.reserve(instances_map_.size());
     for (const auto& [key, value] : instances_map_) {
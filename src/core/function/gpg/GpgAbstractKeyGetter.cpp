@@ -28,6 +28,7 @@
 
 #include "GpgAbstractKeyGetter.h"
 
+#include "core/function/CoreSignalStation.h"
 #include "core/model/GpgKeyTableModel.h"
 #include "core/utils/GpgUtils.h"
 
@@ -62,6 +63,14 @@ auto GpgAbstractKeyGetter::FlushCache() -> bool {
   return key_.FlushKeyCache() && kg_.FlushCache();
 }
 
+auto GpgAbstractKeyGetter::RefreshKeys(const QStringList& fprs) -> bool {
+  if (!key_.RefreshKeys(fprs) || !kg_.FlushCache()) return false;
+
+  emit CoreSignalStation::GetInstance()->SignalKeysChanged(
+      SingletonFunctionObject::GetChannel(), fprs);
+  return true;
+}
+
 auto GpgAbstractKeyGetter::GetKey(const QString& key_id) -> GpgAbstractKeyPtr {
   if (IsKeyGroupID(key_id)) {
     return kg_.KeyGroup(key_id);
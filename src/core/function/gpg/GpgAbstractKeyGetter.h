@@ -86,6 +86,16 @@ class GF_CORE_EXPORT GpgAbstractKeyGetter
    */
   auto FlushCache() -> bool;
 
+  /**
+   * @brief refresh only the given keys and notify the key table models
+   * through CoreSignalStation::SignalKeysChanged
+   *
+   * @param fprs
+   * @return true
+   * @return false
+   */
+  auto RefreshKeys(const QStringList& fprs) -> bool;
+
   /**
    * @brief
    *
@@ -33,6 +33,22 @@
 
 namespace GpgFrontend {
 
+namespace {
+
+/**
+ * @brief idle connections older than this are health checked before reuse
+ *
+ */
+constexpr qint64 kIdleCheckIntervalMs = 15000;
+
+/**
+ * @brief idle connections kept per component
+ *
+ */
+constexpr int kMaxIdleConnections = 4;
+
+}  // namespace
+
 GpgAssuanHelper::GpgAssuanHelper(int channel)
     : GpgFrontend::SingletonFunctionObject<GpgAssuanHelper>(channel),
       gpgconf_path_(Module::RetrieveRTValueTypedOrDefault<>(
@@ -41,13 +57,31 @@ GpgAssuanHelper::GpgAssuanHelper(int channel)
 GpgAssuanHelper::~GpgAssuanHelper() = default;
 
 auto GpgAssuanHelper::ConnectToSocket(GpgComponentType type) -> GpgError {
-  if (ctx_map_.contains(type)) return GPG_ERR_NO_ERROR;
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    if (!idle_connections_.value(type).isEmpty()) return GPG_ERR_NO_ERROR;
+  }
+
+  auto [err, conn] = create_connection(type);
+  if (err != GPG_ERR_NO_ERROR) return err;
 
+  if (!is_connection_alive(conn)) {
+    LOG_W() << "failed to test assuan connection of component: "
+            << component_type_to_q_string(type);
+    return GPG_ERR_NO_AGENT;
+  }
+
+  release_connection(type, conn);
+  return GPG_ERR_NO_ERROR;
+}
+
+auto GpgAssuanHelper::create_connection(GpgComponentType type)
+    -> std::tuple<GpgError, AssuanConnection> {
   auto socket_path = ctx_.ComponentDirectory(type);
   if (socket_path.isEmpty()) {
     LOG_W() << "socket path of component: " << component_type_to_q_string(type)
             << " is empty";
-    return GPG_ERR_ENOPKG;
+    return {GPG_ERR_ENOPKG, {}};
   }
 
   QFileInfo info(socket_path);
@@ -58,10 +92,11 @@ auto GpgAssuanHelper::ConnectToSocket(GpgComponentType type) -> GpgError {
             << " by gpgconf, sockets: " << socket_path;
     launch_component(type);
 
+    info.refresh();
     if (!info.exists()) {
       LOG_W() << "socket path is still not exists: " << socket_path
               << "abort...";
-      return GPG_ERR_ENOTSOCK;
+      return {GPG_ERR_ENOTSOCK, {}};
     }
   }
 
@@ -69,7 +104,7 @@ auto GpgAssuanHelper::ConnectToSocket(GpgComponentType type) -> GpgError {
   auto err = gpgme_new(&ctx);
   if (err != GPG_ERR_NO_ERROR) {
     LOG_E() << "create assuan context failed, err:" << CheckGpgError(err);
-    return err;
+    return {err, {}};
   }
 
   auto p_ctx = QSharedPointer<struct gpgme_context>(
@@ -80,137 +115,232 @@ auto GpgAssuanHelper::ConnectToSocket(GpgComponentType type) -> GpgError {
   if (err != GPG_ERR_NO_ERROR) {
     LOG_W() << "failed to set gpgme assuan engine info:"
             << info.absoluteFilePath() << "err:" << CheckGpgError(err);
-    return err;
+    return {err, {}};
   }
 
   err = gpgme_set_protocol(p_ctx.get(), GPGME_PROTOCOL_ASSUAN);
   if (err != GPG_ERR_NO_ERROR) {
     LOG_E() << "set gpgme protocol failed, err:" << CheckGpgError(err);
-    return err;
+    return {err, {}};
   }
 
   LOG_D() << "connected to socket by assuan protocol: "
           << info.absoluteFilePath() << "channel:" << GetChannel();
 
-  gpgme_error_t op_err;
-  err = gpgme_op_assuan_transact_ext(p_ctx.get(), "GETINFO pid",
-                                     simple_data_callback, nullptr, nullptr,
-                                     nullptr, nullptr, nullptr, &op_err);
-  if (err != GPG_ERR_NO_ERROR) {
-    LOG_W() << "failed to test assuan connection, err:" << CheckGpgError(err)
-            << "op_err: " << CheckGpgError(op_err);
-    return err;
+  AssuanConnection conn;
+  conn.ctx = p_ctx;
+  conn.last_used = QDateTime::currentMSecsSinceEpoch();
+  {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    conn.generation = generation_;
   }
-
-  ctx_map_[type] = p_ctx;
-  return err;
+  return {GPG_ERR_NO_ERROR, conn};
 }
 
-auto GpgAssuanHelper::SendCommand(GpgComponentType type, const QString& command,
-                                  DataCallback data_cb,
-                                  InqueryCallback inquery_cb,
-                                  StatusCallback status_cb) -> GpgError {
-  if (!ctx_map_.contains(type)) {
-    LOG_W() << "haven't connect to: " << component_type_to_q_string(type)
-            << ", trying to make a connection";
+auto GpgAssuanHelper::acquire_connection(GpgComponentType type)
+    -> std::tuple<GpgError, AssuanConnection> {
+  while (true) {
+    AssuanConnection conn;
+    {
+      std::lock_guard<std::mutex> lock(pool_mutex_);
+      auto& idle = idle_connections_[type];
+      if (idle.isEmpty()) break;
+
+      // most recently used one first, it is the least likely to be stale
+      conn = idle.takeLast();
+    }
 
-    auto err = CheckGpgError(ConnectToSocket(type));
-    if (err != GPG_ERR_NO_ERROR) return err;
+    const auto idle_ms = QDateTime::currentMSecsSinceEpoch() - conn.last_used;
+    if (idle_ms < kIdleCheckIntervalMs || is_connection_alive(conn)) {
+      return {GPG_ERR_NO_ERROR, conn};
+    }
+
+    LOG_D() << "dropping stale assuan connection of component: "
+            << component_type_to_q_string(type) << "idle ms:" << idle_ms;
   }
 
+  return create_connection(type);
+}
+
+void GpgAssuanHelper::release_connection(GpgComponentType type,
+                                         AssuanConnection conn) {
+  conn.last_used = QDateTime::currentMSecsSinceEpoch();
+
+  std::lock_guard<std::mutex> lock(pool_mutex_);
+  if (conn.generation != generation_) return;
+
+  auto& idle = idle_connections_[type];
+  if (idle.size() >= kMaxIdleConnections) return;
+  idle.append(conn);
+}
+
+auto GpgAssuanHelper::transact(GpgComponentType type,
+                               const AssuanConnection& conn,
+                               const QString& command, DataCallback data_cb,
+                               InqueryCallback inquery_cb,
+                               StatusCallback status_cb)
+    -> std::tuple<GpgError, GpgError> {
   auto context = QSharedPointer<AssuanCallbackContext>::create();
   context->self = this;
+  context->component_type = type;
+  context->ctx = conn.ctx.get();
   context->data_cb = std::move(data_cb);
   context->status_cb = std::move(status_cb);
   context->inquery_cb = std::move(inquery_cb);
 
   LOG_D() << "sending assuan command: " << command;
 
-  GpgError op_err;
+  GpgError op_err = GPG_ERR_NO_ERROR;
   auto err = gpgme_op_assuan_transact_ext(
-      ctx_map_[type].get(), command.toUtf8(), default_data_callback, &context,
+      conn.ctx.get(), command.toUtf8(), default_data_callback, &context,
       default_inquery_callback, &context, default_status_callback, &context,
       &op_err);
 
   if (err != GPG_ERR_NO_ERROR || op_err != GPG_ERR_NO_ERROR) {
     LOG_W() << "failed to send assuan command, err:" << CheckGpgError(err)
             << "op err: " << CheckGpgError(op_err);
+  }
+  return {err, op_err};
+}
+
+auto GpgAssuanHelper::SendCommand(GpgComponentType type, const QString& command,
+                                  DataCallback data_cb,
+                                  InqueryCallback inquery_cb,
+                                  StatusCallback status_cb) -> GpgError {
+  auto [err, conn] = acquire_connection(type);
+  if (err != GPG_ERR_NO_ERROR) return err;
+
+  auto [t_err, op_err] =
+      transact(type, conn, command, data_cb, inquery_cb, status_cb);
+
+  // the peer went away while the connection was idle, reconnect once
+  if (is_broken_pipe(t_err, op_err)) {
+    LOG_W() << "assuan connection is broken, reconnecting to: "
+            << component_type_to_q_string(type);
+
+    std::tie(err, conn) = create_connection(type);
+    if (err != GPG_ERR_NO_ERROR) return err;
+
+    std::tie(t_err, op_err) =
+        transact(type, conn, command, data_cb, inquery_cb, status_cb);
+    if (is_broken_pipe(t_err, op_err)) return t_err;
+  }
 
-    // broken pipe error, try reconnect next time
-    if (CheckGpgError(op_err) == 32877) {
-      ctx_map_.remove(type);
-      return SendCommand(type, command, data_cb, inquery_cb, status_cb);
+  release_connection(type, conn);
+  return t_err;
+}
+
+auto GpgAssuanHelper::SendCommands(GpgComponentType type,
+                                   const QStringList& commands,
+                                   bool abort_on_error)
+    -> QContainer<AssuanCommandResult> {
+  QContainer<AssuanCommandResult> results;
+  if (commands.isEmpty()) return results;
+
+  auto [err, conn] = acquire_connection(type);
+  if (err != GPG_ERR_NO_ERROR) {
+    AssuanCommandResult result;
+    result.command = commands.front();
+    result.err = err;
+    results.append(result);
+    return results;
+  }
+
+  bool reconnected = false;
+  bool broken = false;
+  for (const auto& command : commands) {
+    AssuanCommandResult result;
+    result.command = command;
+
+    DataCallback d_cb = [&](const QSharedPointer<AssuanCallbackContext>& ctx)
+        -> gpg_error_t {
+      result.data.append(QString::fromUtf8(ctx->buffer));
+      return 0;
+    };
+
+    InqueryCallback i_cb =
+        [&](const QSharedPointer<AssuanCallbackContext>& ctx) -> gpg_error_t {
+      LOG_D() << "inquery callback of command: " << command << ": "
+              << ctx->inquery_name << "args: " << ctx->inquery_args;
+      return 0;
+    };
+
+    StatusCallback s_cb = [&](const QSharedPointer<AssuanCallbackContext>& ctx)
+        -> gpg_error_t {
+      result.status.append(
+          QStringList{ctx->status, ctx->status_args}.join(' '));
+      return 0;
+    };
+
+    std::tie(result.err, result.op_err) =
+        transact(type, conn, command, d_cb, i_cb, s_cb);
+
+    // later commands may depend on state set up by the earlier ones, such
+    // as a selected card, which a new connection wouldn't have
+    if (is_broken_pipe(result.err, result.op_err) && !reconnected &&
+        results.isEmpty()) {
+      LOG_W() << "assuan connection is broken, reconnecting to: "
+              << component_type_to_q_string(type);
+      reconnected = true;
+
+      std::tie(err, conn) = create_connection(type);
+      if (err != GPG_ERR_NO_ERROR) {
+        result.err = err;
+        results.append(result);
+        return results;
+      }
+
+      result.status.clear();
+      result.data.clear();
+      std::tie(result.err, result.op_err) =
+          transact(type, conn, command, d_cb, i_cb, s_cb);
     }
 
-    return err;
+    broken = is_broken_pipe(result.err, result.op_err);
+    const auto good = result.Good();
+    results.append(result);
+
+    if (broken || (abort_on_error && !good)) break;
   }
 
-  return err;
+  if (!broken) release_connection(type, conn);
+  return results;
 }
 
 auto GpgAssuanHelper::SendStatusCommand(GpgComponentType type,
                                         const QString& command)
     -> std::tuple<GpgError, QStringList> {
-  GpgAssuanHelper::DataCallback d_cb =
-      [&](const QSharedPointer<GpgAssuanHelper::AssuanCallbackContext>& ctx)
-      -> gpg_error_t {
-    LOG_D() << "data callback of command " << command << ": " << ctx->buffer;
-
-    return 0;
-  };
-
-  GpgAssuanHelper::InqueryCallback i_cb =
-      [=](const QSharedPointer<GpgAssuanHelper::AssuanCallbackContext>& ctx)
-      -> gpg_error_t {
-    LOG_D() << "inquery callback of command: " << command << ": "
-            << ctx->inquery_name << "args: " << ctx->inquery_args;
-    return 0;
-  };
-
-  QStringList lines;
-  GpgAssuanHelper::StatusCallback s_cb =
-      [&](const QSharedPointer<GpgAssuanHelper::AssuanCallbackContext>& ctx)
-      -> gpg_error_t {
-    LOG_D() << "status callback of command: " << command << ":  " << ctx->status
-            << "args: " << ctx->status_args;
-    lines.append(QStringList{ctx->status, ctx->status_args}.join(' '));
-    return 0;
-  };
-
-  auto ret = SendCommand(type, command, d_cb, i_cb, s_cb);
-  return {ret, lines};
+  auto results = SendCommands(type, {command});
+  const auto& result = results.front();
+
+  LOG_D() << "status lines of command: " << command << ":" << result.status;
+  return {result.err, result.status};
 }
 
 auto GpgAssuanHelper::SendDataCommand(GpgComponentType type,
                                       const QString& command)
     -> std::tuple<GpgError, QStringList> {
-  QStringList lines;
-  GpgAssuanHelper::DataCallback d_cb =
-      [&](const QSharedPointer<GpgAssuanHelper::AssuanCallbackContext>& ctx)
-      -> gpg_error_t {
-    LOG_D() << "data callback of command " << command << ": " << ctx->buffer;
-    lines.push_back(QString::fromUtf8(ctx->buffer));
-    return 0;
-  };
-
-  GpgAssuanHelper::InqueryCallback i_cb =
-      [=](const QSharedPointer<GpgAssuanHelper::AssuanCallbackContext>& ctx)
-      -> gpg_error_t {
-    LOG_D() << "inquery callback of command: " << command << ": "
-            << ctx->inquery_name << "args: " << ctx->inquery_args;
-    return 0;
-  };
-
-  GpgAssuanHelper::StatusCallback s_cb =
-      [&](const QSharedPointer<GpgAssuanHelper::AssuanCallbackContext>& ctx)
-      -> gpg_error_t {
-    LOG_D() << "status callback of command: " << command << ":  "
-            << ctx->status;
-    return 0;
-  };
-
-  auto ret = SendCommand(type, command, d_cb, i_cb, s_cb);
-  return {ret, lines};
+  auto results = SendCommands(type, {command});
+  const auto& result = results.front();
+
+  LOG_D() << "data lines of command: " << command << ":" << result.data;
+  return {result.err, result.data};
+}
+
+auto GpgAssuanHelper::is_connection_alive(const AssuanConnection& conn)
+    -> bool {
+  if (conn.ctx == nullptr) return false;
+
+  gpgme_error_t op_err = GPG_ERR_NO_ERROR;
+  auto err = gpgme_op_assuan_transact_ext(conn.ctx.get(), "NOP", nullptr,
+                                          nullptr, nullptr, nullptr, nullptr,
+                                          nullptr, &op_err);
+  return err == GPG_ERR_NO_ERROR && op_err == GPG_ERR_NO_ERROR;
+}
+
+auto GpgAssuanHelper::is_broken_pipe(GpgError err, GpgError op_err) -> bool {
+  return gpg_err_code(err) == GPG_ERR_EPIPE ||
+         gpg_err_code(op_err) == GPG_ERR_EPIPE;
 }
 
 auto GpgAssuanHelper::default_data_callback(void* opaque, const void* buffer,
@@ -241,7 +371,7 @@ auto GpgAssuanHelper::default_inquery_callback(void* opaque, const char* name,
   auto ctx = *static_cast<QSharedPointer<AssuanCallbackContext>*>(opaque);
   ctx->inquery_name = QString::fromUtf8(name);
   ctx->inquery_args = QString::fromUtf8(args);
-  if (ctx->status_cb) ctx->inquery_cb(ctx);
+  if (ctx->inquery_cb) ctx->inquery_cb(ctx);
   return GPG_ERR_NO_ERROR;
 }
 
@@ -280,12 +410,10 @@ auto GpgAssuanHelper::component_type_to_q_string(GpgComponentType type)
       return "all";
   }
 }
-auto GpgAssuanHelper::simple_data_callback(void* opaque, const void* buffer,
-                                           size_t length) -> gpgme_error_t {
-  LOG_D() << "assuan callback data: "
-          << QByteArray::fromRawData(static_cast<const char*>(buffer), length);
-  return 0;
-}
 
-void GpgAssuanHelper::ResetAllConnections() { ctx_map_.clear(); }
+void GpgAssuanHelper::ResetAllConnections() {
+  std::lock_guard<std::mutex> lock(pool_mutex_);
+  idle_connections_.clear();
+  generation_++;
+}
 }  // namespace GpgFrontend
\ No newline at end of file
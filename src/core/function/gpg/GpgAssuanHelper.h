@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "core/function/gpg/GpgContext.h"
 
 namespace GpgFrontend {
@@ -60,6 +62,27 @@ class GF_CORE_EXPORT GpgAssuanHelper
     StatusCallback status_cb;
   };
 
+  /**
+   * @brief result of a single command inside a batch, status lines are
+   * formatted as "<status> <args>" and data lines are the raw data chunks.
+   *
+   */
+  struct AssuanCommandResult {
+    QString command;
+    GpgError err = GPG_ERR_NO_ERROR;
+    GpgError op_err = GPG_ERR_NO_ERROR;
+    QStringList status;
+    QStringList data;
+
+    /**
+     * @brief both the transport and the assuan server accepted the command
+     *
+     */
+    [[nodiscard]] auto Good() const -> bool {
+      return err == GPG_ERR_NO_ERROR && op_err == GPG_ERR_NO_ERROR;
+    }
+  };
+
   /**
    * @brief Construct a new Gpg Assuan Helper object
    *
@@ -74,10 +97,10 @@ class GF_CORE_EXPORT GpgAssuanHelper
   ~GpgAssuanHelper();
 
   /**
-   * @brief
+   * @brief make sure there is a tested idle connection to the component
+   * in the pool.
    *
-   * @return true
-   * @return false
+   * @return GpgError
    */
   auto ConnectToSocket(GpgComponentType) -> GpgError;
 
@@ -117,7 +140,23 @@ class GF_CORE_EXPORT GpgAssuanHelper
       -> std::tuple<GpgError, QStringList>;
 
   /**
-   * @brief
+   * @brief send the commands one after another over a single pooled
+   * connection and collect all status and data lines of each of them. a
+   * broken connection is only re-established before the first command, so
+   * the later ones always see the session state of the earlier ones.
+   *
+   * @param type
+   * @param commands
+   * @param abort_on_error skip the remaining commands after a failed one
+   * @return QContainer<AssuanCommandResult> one result per executed command
+   */
+  auto SendCommands(GpgComponentType type, const QStringList& commands,
+                    bool abort_on_error = true)
+      -> QContainer<AssuanCommandResult>;
+
+  /**
+   * @brief drop all idle connections, connections in use are dropped when
+   * they are given back.
    *
    */
   void ResetAllConnections();
@@ -126,34 +165,87 @@ class GF_CORE_EXPORT GpgAssuanHelper
   GpgContext& ctx_ =
       GpgContext::GetInstance(SingletonFunctionObject::GetChannel());
 
-  QMap<GpgComponentType, QSharedPointer<struct gpgme_context>> ctx_map_;
+  struct AssuanConnection {
+    QSharedPointer<struct gpgme_context> ctx;
+    qint64 last_used = 0;
+    int generation = 0;
+  };
+
+  std::mutex pool_mutex_;
+  QMap<GpgComponentType, QContainer<AssuanConnection>> idle_connections_;
+  int generation_ = 0;
   QString gpgconf_path_;
 
   /**
-   * @brief
+   * @brief open a new assuan connection to the socket of the component
    *
    * @param type
+   * @return std::tuple<GpgError, AssuanConnection>
    */
-  void launch_component(GpgComponentType type);
+  auto create_connection(GpgComponentType type)
+      -> std::tuple<GpgError, AssuanConnection>;
+
+  /**
+   * @brief take an idle connection out of the pool or open a new one,
+   * connections idled for too long are health checked first.
+   *
+   * @param type
+   * @return std::tuple<GpgError, AssuanConnection>
+   */
+  auto acquire_connection(GpgComponentType type)
+      -> std::tuple<GpgError, AssuanConnection>;
+
+  /**
+   * @brief give a connection back to the pool
+   *
+   * @param type
+   * @param conn
+   */
+  void release_connection(GpgComponentType type, AssuanConnection conn);
+
+  /**
+   * @brief run one assuan transaction on the connection
+   *
+   * @return std::tuple<GpgError, GpgError> transport error and op error
+   */
+  auto transact(GpgComponentType type, const AssuanConnection& conn,
+                const QString& command, DataCallback data_cb,
+                InqueryCallback inquery_cb, StatusCallback status_cb)
+      -> std::tuple<GpgError, GpgError>;
+
+  /**
+   * @brief send a cheap command to check if the peer is still there
+   *
+   * @param conn
+   * @return true
+   * @return false
+   */
+  static auto is_connection_alive(const AssuanConnection& conn) -> bool;
+
+  /**
+   * @brief
+   *
+   * @param err
+   * @param op_err
+   * @return true
+   * @return false
+   */
+  static auto is_broken_pipe(GpgError err, GpgError op_err) -> bool;
 
   /**
    * @brief
    *
    * @param type
-   * @return QString
    */
-  static auto component_type_to_q_string(GpgComponentType type) -> QString;
+  void launch_component(GpgComponentType type);
 
   /**
    * @brief
    *
-   * @param opaque
-   * @param buffer
-   * @param length
-   * @return gpgme_error_t
+   * @param type
+   * @return QString
    */
-  static auto simple_data_callback(void* opaque, const void* buffer,
-                                   size_t length) -> gpgme_error_t;
+  static auto component_type_to_q_string(GpgComponentType type) -> QString;
 
   /**
    * @brief
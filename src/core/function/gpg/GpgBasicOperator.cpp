@@ -67,7 +67,9 @@ void SetSignersImpl(GpgContext& ctx_, const GpgAbstractKeyPtrList& signers,
 auto EncryptImpl(GpgContext& ctx_, const GpgAbstractKeyPtrList& keys,
                  const GFBuffer& in_buffer, bool ascii,
                  const DataObjectPtr& data_object) -> GpgError {
-  auto recipients = Convert2RawGpgMEKeyList(ctx_.GetChannel(), keys);
+  auto [key_err, recipients] =
+      Convert2RawGpgMEKeyList(ctx_.GetChannel(), keys);
+  if (gpgme_err_code(key_err) != GPG_ERR_NO_ERROR) return key_err;
 
   GpgData data_in(in_buffer);
   GpgData data_out;
@@ -87,7 +89,7 @@ auto EncryptImpl(GpgContext& ctx_, const GpgAbstractKeyPtrList& keys,
 void GpgBasicOperator::Encrypt(const GpgAbstractKeyPtrList& keys,
                                const GFBuffer& in_buffer, bool ascii,
                                const GpgOperationCallback& cb) {
-  RunGpgOperaAsync(
+  RunGpgOperaConcurrentAsync(
       GetChannel(),
       [=](const DataObjectPtr& data_object) {
         return EncryptImpl(ctx_, keys, in_buffer, ascii, data_object);
@@ -108,7 +110,7 @@ auto GpgBasicOperator::EncryptSync(const GpgAbstractKeyPtrList& keys,
 
 void GpgBasicOperator::EncryptSymmetric(const GFBuffer& in_buffer, bool ascii,
                                         const GpgOperationCallback& cb) {
-  RunGpgOperaAsync(
+  RunGpgOperaConcurrentAsync(
       GetChannel(),
       [=](const DataObjectPtr& data_object) {
         return EncryptImpl(ctx_, {}, in_buffer, ascii, data_object);
@@ -144,7 +146,7 @@ auto DecryptImpl(GpgContext& ctx_, const GFBuffer& in_buffer,
 
 void GpgBasicOperator::Decrypt(const GFBuffer& in_buffer,
                                const GpgOperationCallback& cb) {
-  RunGpgOperaAsync(
+  RunGpgOperaConcurrentAsync(
       GetChannel(),
       [=](const DataObjectPtr& data_object) {
         return DecryptImpl(ctx_, in_buffer, data_object);
@@ -190,7 +192,7 @@ auto VerifyImpl(GpgContext& ctx_, const GFBuffer& in_buffer,
 void GpgBasicOperator::Verify(const GFBuffer& in_buffer,
                               const GFBuffer& sig_buffer,
                               const GpgOperationCallback& cb) {
-  RunGpgOperaAsync(
+  RunGpgOperaConcurrentAsync(
       GetChannel(),
       [=](const DataObjectPtr& data_object) -> GpgError {
         return VerifyImpl(ctx_, in_buffer, sig_buffer, data_object);
@@ -235,7 +237,7 @@ auto SignImpl(GpgContext& ctx_, const GpgAbstractKeyPtrList& signers,
 void GpgBasicOperator::Sign(const GpgAbstractKeyPtrList& signers,
                             const GFBuffer& in_buffer, GpgSignMode mode,
                             bool ascii, const GpgOperationCallback& cb) {
-  RunGpgOperaAsync(
+  RunGpgOperaConcurrentAsync(
       GetChannel(),
       [=](const DataObjectPtr& data_object) {
         return SignImpl(ctx_, signers, in_buffer, mode, ascii, data_object);
@@ -275,7 +277,7 @@ auto DecryptVerifyImpl(GpgContext& ctx_, const GFBuffer& in_buffer,
 
 void GpgBasicOperator::DecryptVerify(const GFBuffer& in_buffer,
                                      const GpgOperationCallback& cb) {
-  RunGpgOperaAsync(
+  RunGpgOperaConcurrentAsync(
       GetChannel(),
       [=](const DataObjectPtr& data_object) {
         return DecryptVerifyImpl(ctx_, in_buffer, data_object);
@@ -299,11 +301,8 @@ auto EncryptSignImpl(GpgContext& ctx_, const GpgAbstractKeyPtrList& keys,
                      const DataObjectPtr& data_object) -> GpgError {
   if (keys.empty() || signers.empty()) return GPG_ERR_CANCELED;
 
-  GpgError err;
-  auto recipients = Convert2RawGpgMEKeyList(ctx_.GetChannel(), keys);
-
-  // Last entry data_in array has to be nullptr
-  recipients.push_back(nullptr);
+  auto [err, recipients] = Convert2RawGpgMEKeyList(ctx_.GetChannel(), keys);
+  if (gpgme_err_code(err) != GPG_ERR_NO_ERROR) return err;
 
   SetSignersImpl(ctx_, signers, ascii);
 
@@ -326,7 +325,7 @@ void GpgBasicOperator::EncryptSign(const GpgAbstractKeyPtrList& keys,
                                    const GpgAbstractKeyPtrList& signers,
                                    const GFBuffer& in_buffer, bool ascii,
                                    const GpgOperationCallback& cb) {
-  RunGpgOperaAsync(
+  RunGpgOperaConcurrentAsync(
       GetChannel(),
       [=](const DataObjectPtr& data_object) -> GpgError {
         return EncryptSignImpl(ctx_, keys, signers, in_buffer, ascii,
@@ -177,10 +177,11 @@ void GpgCommandExecutor::ExecuteConcurrentlyAsync(
     if (context.task_runner != nullptr) {
       context.task_runner->PostTask(task);
     } else {
+      // the processes don't wait for each other, run them side by side
       GpgFrontend::Thread::TaskRunnerGetter::GetInstance()
           .GetTaskRunner(
               Thread::TaskRunnerGetter::kTaskRunnerType_External_Process)
-          ->PostTask(task);
+          ->PostConcurrentTask(task);
     }
   }
 }
@@ -189,7 +190,6 @@ void GpgCommandExecutor::ExecuteConcurrentlySync(
     const ExecuteContexts &contexts) {
   QEventLoop looper;
   auto remaining_tasks = contexts.size();
-  Thread::TaskRunnerPtr target_task_runner = nullptr;
 
   for (const auto &context : contexts) {
     const auto &cmd = context.cmd;
@@ -207,14 +207,13 @@ void GpgCommandExecutor::ExecuteConcurrentlySync(
     });
 
     if (context.task_runner != nullptr) {
-      target_task_runner = context.task_runner;
+      context.task_runner->PostTask(task);
     } else {
-      target_task_runner =
-          GpgFrontend::Thread::TaskRunnerGetter::GetInstance().GetTaskRunner(
-              Thread::TaskRunnerGetter::kTaskRunnerType_External_Process);
+      GpgFrontend::Thread::TaskRunnerGetter::GetInstance()
+          .GetTaskRunner(
+              Thread::TaskRunnerGetter::kTaskRunnerType_External_Process)
+          ->PostConcurrentTask(task);
     }
-
-    target_task_runner->PostTask(task);
   }
 
   FLOG_D("blocking until concurrent gpg commands finish...");
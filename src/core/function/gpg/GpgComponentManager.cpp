@@ -50,14 +50,28 @@ auto GpgComponentManager::GetGpgAgentVersion() -> QString {
 auto GpgComponentManager::GetScdaemonVersion() -> QString {
   if (!scdaemon_version_.isEmpty()) return scdaemon_version_;
 
-  auto [r, s] = assuan_.SendDataCommand(GpgComponentType::kGPG_AGENT,
-                                        "SCD GETINFO version");
-  if (s.isEmpty()) {
-    LOG_D() << "invalid response of SCD GETINFO version: " << s;
-    return {};
+  // talking to scdaemon goes through the agent anyway, so pick up the agent
+  // version in the same batch
+  QStringList commands;
+  if (gpg_agent_version_.isEmpty()) commands.append("GETINFO version");
+  commands.append("SCD GETINFO version");
+
+  auto results = assuan_.SendCommands(GpgComponentType::kGPG_AGENT, commands,
+                                      false);
+  for (const auto& result : results) {
+    if (result.data.isEmpty()) {
+      LOG_D() << "invalid response of " << result.command << ": "
+              << result.data;
+      continue;
+    }
+
+    if (result.command.startsWith("SCD ")) {
+      scdaemon_version_ = result.data.front();
+    } else {
+      gpg_agent_version_ = result.data.front();
+    }
   }
 
-  scdaemon_version_ = s.front();
   return scdaemon_version_;
 }
 
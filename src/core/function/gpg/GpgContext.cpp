@@ -38,7 +38,6 @@
 #include "core/function/basic/GpgFunctionObject.h"
 #include "core/model/GpgPassphraseContext.h"
 #include "core/module/ModuleManager.h"
-#include "core/utils/CacheUtils.h"
 #include "core/utils/GpgUtils.h"
 #include "core/utils/MemoryUtils.h"
 
@@ -48,6 +47,27 @@
 
 namespace GpgFrontend {
 
+namespace {
+
+struct GpgContextPair {
+  gpgme_ctx_t ctx = nullptr;
+  gpgme_ctx_t binary_ctx = nullptr;
+
+  ~GpgContextPair() {
+    if (ctx != nullptr) gpgme_release(ctx);
+    if (binary_ctx != nullptr) gpgme_release(binary_ctx);
+  }
+};
+
+// contexts leased by the current thread, keyed by the owning GpgContext
+thread_local QHash<const void *, GpgContextPair *> tls_leased_contexts;
+
+// set by GpgNewPassphraseScope, gpgme calls the passphrase callback on the
+// thread running the operation
+thread_local bool tls_ask_for_new_passphrase = false;
+
+}  // namespace
+
 class GpgAgentProcess {
  public:
   explicit GpgAgentProcess(int channel, QString gpg_agent_path, QString db_path)
@@ -155,10 +175,44 @@ class GpgContext::Impl {
   }
 
   [[nodiscard]] auto BinaryContext() const -> gpgme_ctx_t {
-    return binary_ctx_ref_;
+    auto *leased = tls_leased_contexts.value(this, nullptr);
+    return leased != nullptr ? leased->binary_ctx : binary_ctx_ref_;
+  }
+
+  [[nodiscard]] auto DefaultContext() const -> gpgme_ctx_t {
+    auto *leased = tls_leased_contexts.value(this, nullptr);
+    return leased != nullptr ? leased->ctx : ctx_ref_;
   }
 
-  [[nodiscard]] auto DefaultContext() const -> gpgme_ctx_t { return ctx_ref_; }
+  auto LeaseContexts() -> GpgContextLease {
+    if (!good_) return GpgContextLease(GPG_ERR_NOT_INITIALIZED);
+
+    // the outer lease keeps owning the pair, this one releases nothing
+    if (tls_leased_contexts.contains(this)) return GpgContextLease([]() {});
+
+    QSharedPointer<GpgContextPair> pair;
+    {
+      std::lock_guard<std::mutex> lock(ctx_pool_lock_);
+      if (!ctx_pool_.isEmpty()) pair = ctx_pool_.takeLast();
+    }
+
+    if (pair == nullptr) {
+      pair = QSharedPointer<GpgContextPair>::create();
+      if (!new_ctx(pair->ctx, true) || !new_ctx(pair->binary_ctx, false)) {
+        LOG_W() << "cannot create pooled gpg context, channel:"
+                << parent_->GetChannel();
+        return GpgContextLease(GPG_ERR_GENERAL);
+      }
+    }
+
+    tls_leased_contexts.insert(this, pair.get());
+    return GpgContextLease([this, pair]() {
+      tls_leased_contexts.remove(this);
+
+      std::lock_guard<std::mutex> lock(ctx_pool_lock_);
+      ctx_pool_.append(pair);
+    });
+  }
 
   [[nodiscard]] auto Good() const -> bool { return good_; }
 
@@ -200,8 +254,7 @@ class GpgContext::Impl {
   static auto CustomPassphraseCb(void *hook, const char *uid_hint,
                                  const char *passphrase_info, int prev_was_bad,
                                  int fd) -> gpgme_error_t {
-    auto context_cache = GetCacheValue("PinentryContext");
-    bool ask_for_new = context_cache == "NEW_PASSPHRASE";
+    const bool ask_for_new = tls_ask_for_new_passphrase;
     auto context =
         QSharedPointer<GpgPassphraseContext>(new GpgPassphraseContext(
             uid_hint != nullptr ? uid_hint : "",
@@ -232,7 +285,6 @@ class GpgContext::Impl {
         });
 
     looper.exec();
-    ResetCacheValue("PinentryContext");
 
     LOG_D() << "passphrase size:" << passphrase.size();
 
@@ -295,6 +347,9 @@ class GpgContext::Impl {
   std::mutex ctx_ref_lock_;
   std::mutex binary_ctx_ref_lock_;
 
+  std::mutex ctx_pool_lock_;
+  QList<QSharedPointer<GpgContextPair>> ctx_pool_;
+
   QString db_name_;
   QString gpgconf_path_;
   QString database_path_;
@@ -341,12 +396,11 @@ class GpgContext::Impl {
       return false;
     }
 
-    // set keylist mode
+    // set keylist mode, signatures and tofu info are only listed on demand,
+    // see GpgKeyGetter::GetKeyWithDetails()
     return CheckGpgError(gpgme_set_keylist_mode(
-               ctx, GPGME_KEYLIST_MODE_LOCAL | GPGME_KEYLIST_MODE_WITH_SECRET |
-                        GPGME_KEYLIST_MODE_SIGS |
-                        GPGME_KEYLIST_MODE_SIG_NOTATIONS |
-                        GPGME_KEYLIST_MODE_WITH_TOFU)) == GPG_ERR_NO_ERROR;
+               ctx, GPGME_KEYLIST_MODE_LOCAL |
+                        GPGME_KEYLIST_MODE_WITH_SECRET)) == GPG_ERR_NO_ERROR;
   }
 
   auto set_ctx_openpgp_engine_info(gpgme_ctx_t ctx) -> bool {
@@ -443,7 +497,7 @@ class GpgContext::Impl {
     return true;
   }
 
-  auto binary_ctx_initialize(const GpgContextInitArgs &args) -> bool {
+  auto new_ctx(gpgme_ctx_t &ctx, bool armor) -> bool {
     gpgme_ctx_t p_ctx;
     if (auto err = CheckGpgError(gpgme_new(&p_ctx)); err != GPG_ERR_NO_ERROR) {
       LOG_W() << "get new gpg context error: "
@@ -451,32 +505,23 @@ class GpgContext::Impl {
       return false;
     }
     assert(p_ctx != nullptr);
-    binary_ctx_ref_ = p_ctx;
+    ctx = p_ctx;
 
-    if (!common_ctx_initialize(binary_ctx_ref_, args)) {
-      FLOG_W("get new ctx failed, binary");
+    if (!common_ctx_initialize(ctx, args_)) {
+      FLOG_W("get new ctx failed, armor: %d", armor);
       return false;
     }
 
-    gpgme_set_armor(binary_ctx_ref_, 0);
+    gpgme_set_armor(ctx, armor ? 1 : 0);
     return true;
   }
 
-  auto default_ctx_initialize(const GpgContextInitArgs &args) -> bool {
-    gpgme_ctx_t p_ctx;
-    if (CheckGpgError(gpgme_new(&p_ctx)) != GPG_ERR_NO_ERROR) {
-      FLOG_W("get new ctx failed, default");
-      return false;
-    }
-    assert(p_ctx != nullptr);
-    ctx_ref_ = p_ctx;
-
-    if (!common_ctx_initialize(ctx_ref_, args)) {
-      return false;
-    }
+  auto binary_ctx_initialize(const GpgContextInitArgs &args) -> bool {
+    return new_ctx(binary_ctx_ref_, false);
+  }
 
-    gpgme_set_armor(ctx_ref_, 1);
-    return true;
+  auto default_ctx_initialize(const GpgContextInitArgs &args) -> bool {
+    return new_ctx(ctx_ref_, true);
   }
 
   void get_gpg_conf_dirs() {
@@ -587,6 +632,48 @@ auto GpgContext::DefaultContext() -> gpgme_ctx_t {
 
 GpgContext::~GpgContext() = default;
 
+auto GpgContext::LeaseContexts() -> GpgContextLease {
+  return p_->LeaseContexts();
+}
+
+GpgContextLease::GpgContextLease(std::function<void()> release)
+    : release_(std::move(release)) {}
+
+GpgContextLease::GpgContextLease(GpgError err) : err_(err) {}
+
+GpgContextLease::GpgContextLease(GpgContextLease &&o) noexcept
+    : release_(std::move(o.release_)), err_(o.err_) {
+  o.release_ = nullptr;
+}
+
+auto GpgContextLease::operator=(GpgContextLease &&o) noexcept
+    -> GpgContextLease & {
+  if (this != &o) {
+    if (release_) release_();
+    release_ = std::move(o.release_);
+    err_ = o.err_;
+    o.release_ = nullptr;
+  }
+  return *this;
+}
+
+GpgContextLease::~GpgContextLease() {
+  if (release_) release_();
+}
+
+auto GpgContextLease::Good() const -> bool { return release_ != nullptr; }
+
+auto GpgContextLease::Error() const -> GpgError { return err_; }
+
+GpgNewPassphraseScope::GpgNewPassphraseScope()
+    : outer_(tls_ask_for_new_passphrase) {
+  tls_ask_for_new_passphrase = true;
+}
+
+GpgNewPassphraseScope::~GpgNewPassphraseScope() {
+  tls_ask_for_new_passphrase = outer_;
+}
+
 auto GpgContext::HomeDirectory() const -> QString {
   return p_->HomeDirectory();
 }
@@ -32,6 +32,7 @@
 
 #include "core/function/SecureMemoryAllocator.h"
 #include "core/function/basic/GpgFunctionObject.h"
+#include "core/typedef/GpgErrorTypedef.h"
 
 namespace GpgFrontend {
 
@@ -52,6 +53,70 @@ struct GpgContextInitArgs {
 
 enum class GpgComponentType { kGPG_AGENT, kDIRMNGR, kKEYBOXD, kGPG_AGENT_SSH };
 
+/**
+ * @brief a pair of gpgme contexts borrowed from the pool of a GpgContext.
+ * While it is alive, DefaultContext() and BinaryContext() called on the
+ * leasing thread return the borrowed pair instead of the shared one.
+ *
+ */
+class GF_CORE_EXPORT GpgContextLease {
+ public:
+  GpgContextLease() = default;
+
+  explicit GpgContextLease(std::function<void()> release);
+
+  explicit GpgContextLease(GpgError err);
+
+  GpgContextLease(GpgContextLease&&) noexcept;
+
+  auto operator=(GpgContextLease&&) noexcept -> GpgContextLease&;
+
+  GpgContextLease(const GpgContextLease&) = delete;
+
+  auto operator=(const GpgContextLease&) -> GpgContextLease& = delete;
+
+  ~GpgContextLease();
+
+  /**
+   * @brief
+   *
+   * @return true if a dedicated pair of contexts is held
+   */
+  [[nodiscard]] auto Good() const -> bool;
+
+  /**
+   * @brief
+   *
+   * @return GpgError why no contexts could be leased
+   */
+  [[nodiscard]] auto Error() const -> GpgError;
+
+ private:
+  std::function<void()> release_;
+  GpgError err_ = GPG_ERR_NO_ERROR;
+};
+
+/**
+ * @brief while alive, passphrases asked for by gpgme calls on the creating
+ * thread are new ones, e.g. the one protecting a key being generated.
+ * Concurrent operations on other threads are not affected.
+ *
+ */
+class GF_CORE_EXPORT GpgNewPassphraseScope {
+ public:
+  GpgNewPassphraseScope();
+
+  ~GpgNewPassphraseScope();
+
+  GpgNewPassphraseScope(const GpgNewPassphraseScope&) = delete;
+
+  auto operator=(const GpgNewPassphraseScope&)
+      -> GpgNewPassphraseScope& = delete;
+
+ private:
+  bool outer_;
+};
+
 /**
  * @brief
  *
@@ -86,6 +151,16 @@ class GF_CORE_EXPORT GpgContext : public SingletonFunctionObject<GpgContext> {
    */
   auto DefaultContext() -> gpgme_ctx_t;
 
+  /**
+   * @brief bind a pooled pair of contexts to the calling thread, so that
+   * operations on different threads don't share a gpgme_ctx_t. Leasing
+   * again on a thread which already holds a lease reuses the held pair,
+   * if no pair can be created the lease is not Good() and tells why.
+   *
+   * @return GpgContextLease
+   */
+  auto LeaseContexts() -> GpgContextLease;
+
   /**
    * @brief
    *
@@ -62,20 +62,28 @@ void CreateArchiveHelper(const QString& in_path,
       });
 }
 
+auto FinishOutput(GpgError err, GpgData& data_out) -> GpgError {
+  // a failed final write must not be reported as a successful operation
+  if (gpgme_err_code(err) != GPG_ERR_NO_ERROR) return err;
+  return CheckGpgError(data_out.FlushOutput());
+}
+
 GpgFileOpera::GpgFileOpera(int channel)
     : SingletonFunctionObject<GpgFileOpera>(channel) {}
 
 auto EncryptFileGpgDataImpl(GpgContext& ctx_, const GpgAbstractKeyPtrList& keys,
                             GpgData& data_in, bool ascii, GpgData& data_out,
                             const DataObjectPtr& data_object) -> GpgError {
-  auto recipients = Convert2RawGpgMEKeyList(ctx_.GetChannel(), keys);
-  auto* ctx = ascii ? ctx_.DefaultContext() : ctx_.BinaryContext();
+  auto [key_err, recipients] =
+      Convert2RawGpgMEKeyList(ctx_.GetChannel(), keys);
+  if (gpgme_err_code(key_err) != GPG_ERR_NO_ERROR) return key_err;
 
+  auto* ctx = ascii ? ctx_.DefaultContext() : ctx_.BinaryContext();
   auto err = CheckGpgError(
       gpgme_op_encrypt(ctx, keys.isEmpty() ? nullptr : recipients.data(),
                        GPGME_ENCRYPT_ALWAYS_TRUST, data_in, data_out));
   data_object->Swap({GpgEncryptResult(gpgme_op_encrypt_result(ctx))});
-  return err;
+  return FinishOutput(err, data_out);
 }
 
 auto EncryptFileImpl(GpgContext& ctx_, const GpgAbstractKeyPtrList& keys,
@@ -93,7 +101,7 @@ void GpgFileOpera::EncryptFile(const GpgAbstractKeyPtrList& keys,
                                const QString& in_path, bool ascii,
                                const QString& out_path,
                                const GpgOperationCallback& cb) {
-  RunGpgOperaAsync(
+  RunGpgOperaConcurrentAsync(
       GetChannel(),
       [=](const DataObjectPtr& data_object) {
         return EncryptFileImpl(ctx_, keys, in_path, ascii, out_path,
@@ -120,7 +128,7 @@ void GpgFileOpera::EncryptDirectory(const GpgAbstractKeyPtrList& keys,
                                     const GpgOperationCallback& cb) {
   auto ex = CreateStandardGFDataExchanger();
 
-  RunGpgOperaAsync(
+  RunGpgOperaConcurrentAsync(
       GetChannel(),
       [=](const DataObjectPtr& data_object) -> GpgError {
         GpgData data_in(ex);
@@ -142,7 +150,7 @@ auto DecryptFileGpgDataImpl(GpgContext& ctx_, GpgData& data_in,
   data_object->Swap(
       {GpgDecryptResult(gpgme_op_decrypt_result(ctx_.DefaultContext()))});
 
-  return err;
+  return FinishOutput(err, data_out);
 }
 
 auto DecryptFileImpl(GpgContext& ctx_, const QString& in_path,
@@ -156,7 +164,7 @@ auto DecryptFileImpl(GpgContext& ctx_, const QString& in_path,
 
 void GpgFileOpera::DecryptFile(const QString& in_path, const QString& out_path,
                                const GpgOperationCallback& cb) {
-  RunGpgOperaAsync(
+  RunGpgOperaConcurrentAsync(
       GetChannel(),
       [=](const DataObjectPtr& data_object) {
         return DecryptFileImpl(ctx_, in_path, out_path, data_object);
@@ -180,7 +188,7 @@ void GpgFileOpera::DecryptArchive(const QString& in_path,
                                   const GpgOperationCallback& cb) {
   auto ex = ExtractArchiveHelper(out_path);
 
-  RunGpgOperaAsync(
+  RunGpgOperaConcurrentAsync(
       GetChannel(),
       [=](const DataObjectPtr& data_object) -> GpgError {
         GpgData data_in(in_path, true);
@@ -207,7 +215,7 @@ auto SignFileGpgDataImpl(GpgContext& ctx_, GpgBasicOperator& basic_opera_,
   data_object->Swap({
       GpgSignResult(gpgme_op_sign_result(ctx)),
   });
-  return err;
+  return FinishOutput(err, data_out);
 }
 
 auto SignFileImpl(GpgContext& ctx_, GpgBasicOperator& basic_opera_,
@@ -225,7 +233,7 @@ void GpgFileOpera::SignFile(const GpgAbstractKeyPtrList& keys,
                             const QString& in_path, bool ascii,
                             const QString& out_path,
                             const GpgOperationCallback& cb) {
-  RunGpgOperaAsync(
+  RunGpgOperaConcurrentAsync(
       GetChannel(),
       [=](const DataObjectPtr& data_object) {
         return SignFileImpl(ctx_, basic_opera_, keys, in_path, ascii, out_path,
@@ -272,7 +280,7 @@ auto VerifyFileImpl(GpgContext& ctx_, const QString& data_path,
 void GpgFileOpera::VerifyFile(const QString& data_path,
                               const QString& sign_path,
                               const GpgOperationCallback& cb) {
-  RunGpgOperaAsync(
+  RunGpgOperaConcurrentAsync(
       GetChannel(),
       [=](const DataObjectPtr& data_object) -> GpgError {
         return VerifyFileImpl(ctx_, data_path, sign_path, data_object);
@@ -297,8 +305,8 @@ auto EncryptSignFileGpgDataImpl(GpgContext& ctx_,
                                 const GpgAbstractKeyPtrList& signer_keys,
                                 GpgData& data_in, bool ascii, GpgData& data_out,
                                 const DataObjectPtr& data_object) -> GpgError {
-  GpgError err;
-  auto recipients = Convert2RawGpgMEKeyList(ctx_.GetChannel(), keys);
+  auto [err, recipients] = Convert2RawGpgMEKeyList(ctx_.GetChannel(), keys);
+  if (gpgme_err_code(err) != GPG_ERR_NO_ERROR) return err;
 
   basic_opera_.SetSigners(signer_keys, ascii);
 
@@ -311,7 +319,7 @@ auto EncryptSignFileGpgDataImpl(GpgContext& ctx_,
       GpgSignResult(gpgme_op_sign_result(ctx)),
   });
 
-  return err;
+  return FinishOutput(err, data_out);
 }
 
 auto EncryptSignFileImpl(GpgContext& ctx_, GpgBasicOperator& basic_opera_,
@@ -332,7 +340,7 @@ void GpgFileOpera::EncryptSignFile(const GpgAbstractKeyPtrList& keys,
                                    const QString& in_path, bool ascii,
                                    const QString& out_path,
                                    const GpgOperationCallback& cb) {
-  RunGpgOperaAsync(
+  RunGpgOperaConcurrentAsync(
       GetChannel(),
       [=](const DataObjectPtr& data_object) {
         return EncryptSignFileImpl(ctx_, basic_opera_, keys, signer_keys,
@@ -360,7 +368,7 @@ void GpgFileOpera::EncryptSignDirectory(
     const GpgOperationCallback& cb) {
   auto ex = CreateStandardGFDataExchanger();
 
-  RunGpgOperaAsync(
+  RunGpgOperaConcurrentAsync(
       GetChannel(),
       [=](const DataObjectPtr& data_object) -> GpgError {
         GpgData data_in(ex);
@@ -385,7 +393,7 @@ auto DecryptVerifyFileGpgDataImpl(
       GpgDecryptResult(gpgme_op_decrypt_result(ctx_.DefaultContext())),
       GpgVerifyResult(gpgme_op_verify_result(ctx_.DefaultContext())),
   });
-  return err;
+  return FinishOutput(err, data_out);
 }
 
 auto DecryptVerifyFileImpl(GpgContext& ctx_, const QString& in_path,
@@ -400,7 +408,7 @@ auto DecryptVerifyFileImpl(GpgContext& ctx_, const QString& in_path,
 void GpgFileOpera::DecryptVerifyFile(const QString& in_path,
                                      const QString& out_path,
                                      const GpgOperationCallback& cb) {
-  RunGpgOperaAsync(
+  RunGpgOperaConcurrentAsync(
       GetChannel(),
       [=](const DataObjectPtr& data_object) -> GpgError {
         return DecryptVerifyFileImpl(ctx_, in_path, out_path, data_object);
@@ -424,7 +432,7 @@ void GpgFileOpera::DecryptVerifyArchive(const QString& in_path,
                                         const GpgOperationCallback& cb) {
   auto ex = ExtractArchiveHelper(out_path);
 
-  RunGpgOperaAsync(
+  RunGpgOperaConcurrentAsync(
       GetChannel(),
       [=](const DataObjectPtr& data_object) -> GpgError {
         GpgData data_in(in_path, true);
@@ -438,7 +446,7 @@ void GpgFileOpera::DecryptVerifyArchive(const QString& in_path,
 void GpgFileOpera::EncryptFileSymmetric(const QString& in_path, bool ascii,
                                         const QString& out_path,
                                         const GpgOperationCallback& cb) {
-  RunGpgOperaAsync(
+  RunGpgOperaConcurrentAsync(
       GetChannel(),
       [=](const DataObjectPtr& data_object) -> GpgError {
         return EncryptFileImpl(ctx_, {}, in_path, ascii, out_path, data_object);
@@ -462,7 +470,7 @@ void GpgFileOpera::EncryptDirectorySymmetric(const QString& in_path, bool ascii,
                                              const GpgOperationCallback& cb) {
   auto ex = CreateStandardGFDataExchanger();
 
-  RunGpgOperaAsync(
+  RunGpgOperaConcurrentAsync(
       GetChannel(),
       [=](const DataObjectPtr& data_object) {
         GpgData data_in(ex);
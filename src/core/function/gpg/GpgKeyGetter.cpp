@@ -33,10 +33,27 @@
 #include <mutex>
 
 #include "core/function/gpg/GpgContext.h"
+#include "core/function/gpg/GpgKeySnapshot.h"
+#include "core/thread/TaskRunnerGetter.h"
 #include "core/utils/GpgUtils.h"
 
 namespace GpgFrontend {
 
+namespace {
+
+constexpr gpgme_keylist_mode_t kDetailsKeyListMode =
+    GPGME_KEYLIST_MODE_SIGS | GPGME_KEYLIST_MODE_SIG_NOTATIONS |
+    GPGME_KEYLIST_MODE_WITH_TOFU;
+
+/**
+ * @brief how often a full listing is repeated when the cache keeps
+ * changing underneath it
+ *
+ */
+constexpr int kMaxFullListingAttempts = 3;
+
+}  // namespace
+
 class GpgKeyGetter::Impl : public SingletonFunctionObject<GpgKeyGetter::Impl> {
  public:
   explicit Impl(int channel)
@@ -129,60 +146,102 @@ class GpgKeyGetter::Impl : public SingletonFunctionObject<GpgKeyGetter::Impl> {
   }
 
   auto FlushKeyCache() -> bool {
-    // clear the keys cache
-    keys_cache_.clear();
-    keys_search_cache_.clear();
+    GpgKeyPtrList keys;
+    GpgKeyPtrList cached_keys;
+    return relist_all_keys(keys, cached_keys);
+  }
 
-    // init
-    GpgError err = gpgme_op_keylist_start(ctx_.DefaultContext(), nullptr, 0);
+  auto LoadKeyCacheSnapshot() -> bool {
+    const auto generation = cache_generation();
 
-    // for debug
-    assert(CheckGpgError(err) == GPG_ERR_NO_ERROR);
+    auto keys = GpgKeySnapshot(ctx_.HomeDirectory()).Load(real_key_fetcher());
+    if (!keys.has_value()) return false;
 
-    // return when error
-    if (CheckGpgError(err) != GPG_ERR_NO_ERROR) return false;
+    // a listing finished first, its keys are newer than the snapshot
+    GpgKeyPtrList cached_keys;
+    if (!reset_cache(*keys, generation, cached_keys)) return false;
+
+    LOG_D() << "loaded" << keys->size()
+            << "key(s) from snapshot, channel: " << GetChannel();
+    return true;
+  }
+
+  auto ReconcileKeyCache() -> QStringList {
+    // the cache stays readable while listing, so keep off the shared context
+    auto lease = ctx_.LeaseContexts();
+
+    GpgKeyPtrList keys;
+    GpgKeyPtrList cached_keys;
+    if (!relist_all_keys(keys, cached_keys)) {
+      LOG_W() << "cannot reconcile key cache, channel: " << GetChannel();
+      return {};
+    }
 
+    QMap<QString, QJsonObject> rows;
+    for (const auto& key : cached_keys) {
+      rows.insert(key->Fingerprint(), GpgKeySnapshot::EncodeKey(*key));
+    }
+
+    QStringList changed_fprs;
+    for (const auto& key : keys) {
+      const auto row = rows.take(key->Fingerprint());
+      if (row != GpgKeySnapshot::EncodeKey(*key)) {
+        changed_fprs.append(key->Fingerprint());
+      }
+    }
+    changed_fprs.append(rows.keys());
+    return changed_fprs;
+  }
+
+  auto RefreshKeys(const QStringList& fprs) -> bool {
+    bool cache_empty = false;
     {
-      // get the lock
       std::lock_guard<std::mutex> lock(keys_cache_mutex_);
-      gpgme_key_t key;
-      while ((err = gpgme_op_keylist_next(ctx_.DefaultContext(), &key)) ==
-             GPG_ERR_NO_ERROR) {
-        auto g_key = QSharedPointer<GpgKey>::create(key);
-
-        // detect if the key is in a smartcard
-        // if so, try to get full information using gpgme_get_key()
-        // this maybe a bug in gpgme
-        if (g_key->IsHasCardKey()) {
-          g_key = GetKeyPtr(g_key->ID(), false);
-        }
-
-        keys_cache_.push_back(g_key);
-        keys_search_cache_.insert(g_key->ID(), g_key);
-        keys_search_cache_.insert(g_key->Fingerprint(), g_key);
-
-        for (const auto& s_key : g_key->SubKeys()) {
-          if (s_key.ID() == g_key->ID()) continue;
-
-          // don't add adsk key or it will cause bugs
-          if (s_key.IsADSK()) continue;
-
-          // subkeys should be weaker than primary key
-          if (keys_search_cache_.contains(s_key.ID())) continue;
-
-          auto p_s_key = QSharedPointer<GpgSubKey>::create(s_key);
-          keys_search_cache_.insert(s_key.ID(), p_s_key);
-          keys_search_cache_.insert(s_key.Fingerprint(), p_s_key);
-        }
+      cache_empty = keys_cache_.empty();
+    }
+    if (cache_empty) return FlushKeyCache();
+
+    // list only the changed keys, a null pointer means the key is gone
+    QMap<QString, GpgKeyPtr> fresh_keys;
+    for (const auto& fpr : fprs) {
+      if (fpr.isEmpty()) continue;
+
+      auto [err, key] = list_key(fpr);
+      if (key == nullptr && !is_key_not_found(err)) {
+        // a failed listing says nothing about the key, keep its row
+        LOG_W() << "cannot re-list key" << fpr
+                << "keeping the cached one, channel:" << GetChannel()
+                << "err:" << CheckGpgError(err);
+        continue;
       }
+      fresh_keys.insert(fpr, key);
     }
 
-    // for debug
-    assert(CheckGpgError2ErrCode(err, GPG_ERR_EOF) == GPG_ERR_EOF);
+    std::lock_guard<std::mutex> lock(keys_cache_mutex_);
+    for (auto it = fresh_keys.cbegin(); it != fresh_keys.cend(); ++it) {
+      auto old_key =
+          qSharedPointerDynamicCast<GpgKey>(keys_search_cache_.value(it.key()));
+      const auto& new_key = it.value();
 
-    err = gpgme_op_keylist_end(ctx_.DefaultContext());
-    assert(CheckGpgError2ErrCode(err, GPG_ERR_EOF) == GPG_ERR_NO_ERROR);
+      auto pos = old_key != nullptr ? keys_cache_.indexOf(old_key) : -1;
+      if (old_key != nullptr) remove_from_search_cache(old_key);
+
+      if (new_key == nullptr) {
+        if (pos >= 0) keys_cache_.removeAt(pos);
+        continue;
+      }
+
+      if (pos >= 0) {
+        keys_cache_[pos] = new_key;
+      } else {
+        keys_cache_.push_back(new_key);
+      }
+      insert_into_search_cache(new_key);
+    }
+    cache_generation_++;
 
+    // the snapshot is only saved after full listings, the next one picks
+    // these keys up
     return true;
   }
 
@@ -213,6 +272,29 @@ class GpgKeyGetter::Impl : public SingletonFunctionObject<GpgKeyGetter::Impl> {
     return nullptr;
   }
 
+  auto GetKeyWithDetails(const QString& key_id) -> GpgKeyPtr {
+    // the wider keylist mode is only set on a context pair of our own, so
+    // it never leaks into a listing running on another thread
+    auto lease = ctx_.LeaseContexts();
+    if (!lease.Good()) {
+      LOG_W() << "cannot lease a context for a detailed listing, channel:"
+              << GetChannel() << "err:" << CheckGpgError(lease.Error());
+      return nullptr;
+    }
+
+    auto* ctx = ctx_.DefaultContext();
+    const auto mode = gpgme_get_keylist_mode(ctx);
+    if (CheckGpgError(gpgme_set_keylist_mode(
+            ctx, mode | kDetailsKeyListMode)) != GPG_ERR_NO_ERROR) {
+      LOG_W() << "cannot set detailed keylist mode, channel: " << GetChannel();
+      return nullptr;
+    }
+
+    auto [err, key] = list_key(key_id);
+    gpgme_set_keylist_mode(ctx, mode);
+    return key;
+  }
+
  private:
   /**
    * @brief Get the gpgme context object
@@ -245,6 +327,251 @@ class GpgKeyGetter::Impl : public SingletonFunctionObject<GpgKeyGetter::Impl> {
    */
   mutable std::mutex keys_cache_mutex_;
 
+  /**
+   * @brief bumped on every change of the cache, guarded by
+   * keys_cache_mutex_
+   *
+   */
+  quint64 cache_generation_ = 0;
+
+  /**
+   * @brief list every key of the key database
+   *
+   * @param keys
+   * @return true
+   * @return false
+   */
+  auto list_all_keys(GpgKeyPtrList& keys) -> bool {
+    GpgError err = gpgme_op_keylist_start(ctx_.DefaultContext(), nullptr, 0);
+
+    // for debug
+    assert(CheckGpgError(err) == GPG_ERR_NO_ERROR);
+
+    // return when error
+    if (CheckGpgError(err) != GPG_ERR_NO_ERROR) return false;
+
+    gpgme_key_t key;
+    while ((err = gpgme_op_keylist_next(ctx_.DefaultContext(), &key)) ==
+           GPG_ERR_NO_ERROR) {
+      auto g_key = QSharedPointer<GpgKey>::create(key);
+
+      // detect if the key is in a smartcard
+      // if so, try to get full information using gpgme_get_key()
+      // this maybe a bug in gpgme
+      if (g_key->IsHasCardKey()) {
+        g_key = GetKeyPtr(g_key->ID(), false);
+      }
+
+      keys.push_back(g_key);
+    }
+
+    // for debug
+    assert(CheckGpgError2ErrCode(err, GPG_ERR_EOF) == GPG_ERR_EOF);
+
+    err = gpgme_op_keylist_end(ctx_.DefaultContext());
+    assert(CheckGpgError2ErrCode(err, GPG_ERR_EOF) == GPG_ERR_NO_ERROR);
+
+    return true;
+  }
+
+  /**
+   * @brief list all keys and replace the cache. The listing runs again if
+   * the cache changed meanwhile, so it never overwrites a newer result.
+   *
+   * @param keys the listed keys
+   * @param cached_keys the keys they replaced
+   * @return true
+   * @return false
+   */
+  auto relist_all_keys(GpgKeyPtrList& keys, GpgKeyPtrList& cached_keys)
+      -> bool {
+    for (int i = 0; i < kMaxFullListingAttempts; i++) {
+      // pin the keyring state before listing, see GpgKeySnapshot
+      auto snapshot = GpgKeySnapshot(ctx_.HomeDirectory());
+      const auto generation = cache_generation();
+
+      keys.clear();
+      if (!list_all_keys(keys)) return false;
+
+      if (reset_cache(keys, generation, cached_keys)) {
+        save_snapshot(snapshot, keys);
+        return true;
+      }
+
+      LOG_D() << "key cache changed while listing, listing again, channel: "
+              << GetChannel();
+    }
+
+    LOG_W() << "key cache kept changing while listing, channel: "
+            << GetChannel();
+    return false;
+  }
+
+  /**
+   * @brief
+   *
+   * @return quint64 the current cache generation
+   */
+  auto cache_generation() -> quint64 {
+    std::lock_guard<std::mutex> lock(keys_cache_mutex_);
+    return cache_generation_;
+  }
+
+  /**
+   * @brief replace the whole cache with the given keys, unless it changed
+   * since the given generation
+   *
+   * @param keys
+   * @param generation read before the keys were listed
+   * @param cached_keys the replaced keys
+   * @return true if the cache was replaced
+   */
+  auto reset_cache(const GpgKeyPtrList& keys, quint64 generation,
+                   GpgKeyPtrList& cached_keys) -> bool {
+    std::lock_guard<std::mutex> lock(keys_cache_mutex_);
+    if (generation != cache_generation_) return false;
+
+    cached_keys = keys_cache_;
+    keys_cache_ = keys;
+    keys_search_cache_.clear();
+    for (const auto& key : keys) insert_into_search_cache(key);
+    cache_generation_++;
+    return true;
+  }
+
+  /**
+   * @brief encode and write the snapshot on the io runner, the caller
+   * doesn't wait for the whole keyring to be written
+   *
+   * @param snapshot
+   * @param keys
+   */
+  static void save_snapshot(const GpgKeySnapshot& snapshot,
+                            const GpgKeyPtrList& keys) {
+    Thread::TaskRunnerGetter::GetInstance()
+        .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_IO)
+        ->PostTask(
+            "save_key_snapshot",
+            [snapshot, keys](const DataObjectPtr&) -> int {
+              snapshot.Save(keys);
+              return 0;
+            },
+            nullptr, nullptr);
+  }
+
+  /**
+   * @brief lists the real key behind a display-only key loaded from the
+   * snapshot, the same way GetKeyPtr() does without the cache
+   *
+   * @return GpgKeySnapshot::KeyFetcher
+   */
+  [[nodiscard]] auto real_key_fetcher() const -> GpgKeySnapshot::KeyFetcher {
+    const auto channel = GetChannel();
+    return [channel](const QString& fpr) -> gpgme_key_t {
+      // the key may be asked for on any thread, don't share the context
+      auto& context = GpgContext::GetInstance(channel);
+      auto lease = context.LeaseContexts();
+      if (!lease.Good()) {
+        LOG_W() << "cannot lease a context to fetch key" << fpr
+                << "channel:" << channel
+                << "err:" << CheckGpgError(lease.Error());
+        return nullptr;
+      }
+
+      auto* ctx = context.DefaultContext();
+
+      gpgme_key_t p_key = nullptr;
+      gpgme_get_key(ctx, fpr.toUtf8(), &p_key, 1);
+      if (p_key == nullptr) gpgme_get_key(ctx, fpr.toUtf8(), &p_key, 0);
+      return p_key;
+    };
+  }
+
+  /**
+   * @brief list a single key the same way FlushKeyCache() does
+   *
+   * @param fpr
+   * @return std::tuple<GpgError, GpgKeyPtr> the key is nullptr on error
+   */
+  auto list_key(const QString& fpr) -> std::tuple<GpgError, GpgKeyPtr> {
+    gpgme_key_t p_key = nullptr;
+    auto err = gpgme_get_key(ctx_.DefaultContext(), fpr.toUtf8(), &p_key, 0);
+    if (p_key == nullptr) {
+      return {err != GPG_ERR_NO_ERROR ? err : gpg_error(GPG_ERR_EOF),
+              nullptr};
+    }
+
+    auto g_key = QSharedPointer<GpgKey>::create(p_key);
+    if (!g_key->IsHasCardKey()) return {GPG_ERR_NO_ERROR, g_key};
+
+    p_key = nullptr;
+    gpgme_get_key(ctx_.DefaultContext(), fpr.toUtf8(), &p_key, 1);
+    return {GPG_ERR_NO_ERROR,
+            p_key != nullptr ? QSharedPointer<GpgKey>::create(p_key) : g_key};
+  }
+
+  /**
+   * @brief
+   *
+   * @param err returned by gpgme_get_key()
+   * @return true if the key no longer exists
+   */
+  static auto is_key_not_found(GpgError err) -> bool {
+    const auto code = gpg_err_code(err);
+    return code == GPG_ERR_EOF || code == GPG_ERR_NOT_FOUND ||
+           code == GPG_ERR_NO_PUBKEY;
+  }
+
+  /**
+   * @brief index the key and its subkeys, caller must hold keys_cache_mutex_
+   *
+   * @param g_key
+   */
+  void insert_into_search_cache(const GpgKeyPtr& g_key) {
+    keys_search_cache_.insert(g_key->ID(), g_key);
+    keys_search_cache_.insert(g_key->Fingerprint(), g_key);
+
+    for (const auto& s_key : g_key->SubKeys()) {
+      if (s_key.ID() == g_key->ID()) continue;
+
+      // don't add adsk key or it will cause bugs
+      if (s_key.IsADSK()) continue;
+
+      // subkeys should be weaker than primary key
+      if (keys_search_cache_.contains(s_key.ID())) continue;
+
+      auto p_s_key = QSharedPointer<GpgSubKey>::create(s_key);
+      keys_search_cache_.insert(s_key.ID(), p_s_key);
+      keys_search_cache_.insert(s_key.Fingerprint(), p_s_key);
+    }
+  }
+
+  /**
+   * @brief drop every index entry that points at the key or one of its
+   * subkeys, caller must hold keys_cache_mutex_
+   *
+   * @param g_key
+   */
+  void remove_from_search_cache(const GpgKeyPtr& g_key) {
+    auto drop = [=](const QString& id, const QString& fpr) {
+      auto entry = keys_search_cache_.value(id);
+      if (entry == nullptr) return;
+
+      const auto is_sub_key =
+          entry->KeyType() == GpgAbstractKeyType::kGPG_SUBKEY;
+      if (entry == g_key || (is_sub_key && entry->Fingerprint() == fpr)) {
+        keys_search_cache_.remove(id);
+      }
+    };
+
+    for (const auto& s_key : g_key->SubKeys()) {
+      drop(s_key.ID(), s_key.Fingerprint());
+      drop(s_key.Fingerprint(), s_key.Fingerprint());
+    }
+    drop(g_key->ID(), g_key->Fingerprint());
+    drop(g_key->Fingerprint(), g_key->Fingerprint());
+  }
+
   /**
    * @brief Get the Key object
    *
@@ -291,6 +618,18 @@ auto GpgKeyGetter::GetPubkeyPtr(const QString& key_id,
 
 auto GpgKeyGetter::FlushKeyCache() -> bool { return p_->FlushKeyCache(); }
 
+auto GpgKeyGetter::LoadKeyCacheSnapshot() -> bool {
+  return p_->LoadKeyCacheSnapshot();
+}
+
+auto GpgKeyGetter::ReconcileKeyCache() -> QStringList {
+  return p_->ReconcileKeyCache();
+}
+
+auto GpgKeyGetter::RefreshKeys(const QStringList& fprs) -> bool {
+  return p_->RefreshKeys(fprs);
+}
+
 auto GpgKeyGetter::GetKeys(const KeyIdArgsList& ids) -> GpgKeyList {
   return p_->GetKeys(ids);
 }
@@ -301,4 +640,8 @@ auto GpgKeyGetter::GetKeyORSubkeyPtr(const QString& key_id)
     -> GpgAbstractKeyPtr {
   return p_->GetKeyORSubkeyPtr(key_id);
 }
+
+auto GpgKeyGetter::GetKeyWithDetails(const QString& key_id) -> GpgKeyPtr {
+  return p_->GetKeyWithDetails(key_id);
+}
 }  // namespace GpgFrontend
@@ -98,6 +98,16 @@ class GF_CORE_EXPORT GpgKeyGetter
    */
   auto GetKeyORSubkeyPtr(const QString& key_id) -> GpgAbstractKeyPtr;
 
+  /**
+   * @brief list a single key together with its key signatures, signature
+   * notations and tofu info, which the cached keys don't carry.
+   *
+   * @param key_id
+   * @return GpgKeyPtr nullptr if the key doesn't exist or no context could
+   * be leased for the listing
+   */
+  auto GetKeyWithDetails(const QString& key_id) -> GpgKeyPtr;
+
   /**
    * @brief
    *
@@ -106,11 +116,42 @@ class GF_CORE_EXPORT GpgKeyGetter
   auto Fetch() -> QContainer<QSharedPointer<GpgKey>>;
 
   /**
-   * @brief flush the keys in the cache
+   * @brief flush the keys in the cache, the snapshot is saved in the
+   * background afterwards
    *
    */
   auto FlushKeyCache() -> bool;
 
+  /**
+   * @brief fill the cache from the key snapshot saved by an earlier
+   * listing, if the keyring hasn't changed since. The keys are
+   * display-only, gpg lists each one again before an operation uses it.
+   *
+   * @return true if the cache was filled
+   * @return false if there is no valid snapshot or a listing filled the
+   * cache first
+   */
+  auto LoadKeyCacheSnapshot() -> bool;
+
+  /**
+   * @brief list all keys again and replace the cache, meant to follow
+   * LoadKeyCacheSnapshot() in the background.
+   *
+   * @return QStringList fingerprints of the keys whose row differs from
+   * the cached one, including added and removed keys
+   */
+  auto ReconcileKeyCache() -> QStringList;
+
+  /**
+   * @brief re-list only the keys with the given fingerprints and patch
+   * the cache in place, keys which no longer exist are dropped.
+   *
+   * @param fprs primary key fingerprints changed by an operation
+   * @return true
+   * @return false
+   */
+  auto RefreshKeys(const QStringList& fprs) -> bool;
+
   /**
    * @brief Get the Keys object
    *
@@ -49,6 +49,20 @@ auto GpgKeyImportExporter::ImportKey(const GFBuffer& in_buffer)
   if (in_buffer.Empty()) return {};
 
   GpgData data_in(in_buffer);
+  return ImportKey(data_in);
+}
+
+auto GpgKeyImportExporter::ImportKey(const QString& path)
+    -> QSharedPointer<GpgImportInformation> {
+  QFileInfo info(path);
+  if (!info.isFile() || !info.isReadable() || info.size() == 0) return {};
+
+  GpgData data_in(path, true);
+  return ImportKey(data_in);
+}
+
+auto GpgKeyImportExporter::ImportKey(GpgData& data_in)
+    -> QSharedPointer<GpgImportInformation> {
   auto err = CheckGpgError(gpgme_op_import(ctx_.BinaryContext(), data_in));
   if (gpgme_err_code(err) != GPG_ERR_NO_ERROR) return {};
 
@@ -83,8 +97,8 @@ auto GpgKeyImportExporter::ExportKey(
   if (shortest) mode |= GPGME_EXPORT_MODE_MINIMAL;
   if (ssh_mode) mode |= GPGME_EXPORT_MODE_SSH;
 
-  QContainer<gpgme_key_t> keys_array =
-      Convert2RawGpgMEKeyList(GetChannel(), {key});
+  auto [key_err, keys_array] = Convert2RawGpgMEKeyList(GetChannel(), {key});
+  if (gpgme_err_code(key_err) != GPG_ERR_NO_ERROR) return {key_err, {}};
 
   GpgData data_out;
   auto* ctx = ascii ? ctx_.DefaultContext() : ctx_.BinaryContext();
@@ -114,10 +128,9 @@ void GpgKeyImportExporter::ExportKeys(const GpgAbstractKeyPtrList& keys,
         if (shortest) mode |= GPGME_EXPORT_MODE_MINIMAL;
         if (ssh_mode) mode |= GPGME_EXPORT_MODE_SSH;
 
-        auto keys_array = Convert2RawGpgMEKeyList(GetChannel(), keys);
-
-        // Last entry data_in array has to be nullptr
-        keys_array.push_back(nullptr);
+        auto [key_err, keys_array] =
+            Convert2RawGpgMEKeyList(GetChannel(), keys);
+        if (gpgme_err_code(key_err) != GPG_ERR_NO_ERROR) return key_err;
 
         GpgData data_out;
         auto* ctx = ascii ? ctx_.DefaultContext() : ctx_.BinaryContext();
@@ -144,35 +157,32 @@ void GpgKeyImportExporter::ExportAllKeys(const GpgAbstractKeyPtrList& keys,
       [=](const DataObjectPtr& data_object) -> GpgError {
         if (keys.empty()) return GPG_ERR_CANCELED;
 
-        int mode = 0;
-        auto keys_array = Convert2RawGpgMEKeyList(GetChannel(), keys);
-
-        // Last entry data_in array has to be nullptr
-        keys_array.push_back(nullptr);
-
+        // both exports go into the same data object, so there is no need to
+        // materialize and concatenate two buffers
         GpgData data_out;
-        auto* ctx = ascii ? ctx_.DefaultContext() : ctx_.BinaryContext();
-        auto err = gpgme_op_export_keys(ctx, keys_array.data(), mode, data_out);
+        auto err = ExportAllKeys(keys, secret, ascii, data_out);
         if (gpgme_err_code(err) != GPG_ERR_NO_ERROR) return err;
 
-        auto buffer = data_out.Read2GFBuffer();
+        data_object->Swap({data_out.Read2GFBuffer()});
+        return err;
+      },
+      cb, "gpgme_op_export_keys", "2.1.0");
+}
 
-        if (secret) {
-          int mode = 0;
-          mode |= GPGME_EXPORT_MODE_SECRET;
+auto GpgKeyImportExporter::ExportAllKeys(const GpgAbstractKeyPtrList& keys,
+                                         bool secret, bool ascii,
+                                         GpgData& data_out) const -> GpgError {
+  if (keys.empty()) return GPG_ERR_CANCELED;
 
-          GpgData data_out_secret;
-          auto err = gpgme_op_export_keys(ctx, keys_array.data(), mode,
-                                          data_out_secret);
-          if (gpgme_err_code(err) != GPG_ERR_NO_ERROR) return err;
+  auto [key_err, keys_array] = Convert2RawGpgMEKeyList(GetChannel(), keys);
+  if (gpgme_err_code(key_err) != GPG_ERR_NO_ERROR) return key_err;
 
-          buffer.Append(data_out_secret.Read2GFBuffer());
-        }
+  auto* ctx = ascii ? ctx_.DefaultContext() : ctx_.BinaryContext();
+  auto err = gpgme_op_export_keys(ctx, keys_array.data(), 0, data_out);
+  if (gpgme_err_code(err) != GPG_ERR_NO_ERROR || !secret) return err;
 
-        data_object->Swap({buffer});
-        return err;
-      },
-      cb, "gpgme_op_export_keys", "2.1.0");
+  return gpgme_op_export_keys(ctx, keys_array.data(),
+                              GPGME_EXPORT_MODE_SECRET, data_out);
 }
 
 auto GpgKeyImportExporter::ExportSubkey(const QString& fpr, bool ascii) const
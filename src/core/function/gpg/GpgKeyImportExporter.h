@@ -35,6 +35,7 @@
 
 namespace GpgFrontend {
 
+class GpgData;
 class GpgImportInformation;
 
 /**
@@ -60,6 +61,23 @@ class GF_CORE_EXPORT GpgKeyImportExporter
    */
   auto ImportKey(const GFBuffer&) -> QSharedPointer<GpgImportInformation>;
 
+  /**
+   * @brief import the keys of a keyring file without loading it into memory
+   *
+   * @param path
+   * @return QSharedPointer<GpgImportInformation>
+   */
+  auto ImportKey(const QString& path) -> QSharedPointer<GpgImportInformation>;
+
+  /**
+   * @brief import the keys gpgme reads from the data object, which may be
+   * backed by a stream.
+   *
+   * @param data_in
+   * @return QSharedPointer<GpgImportInformation>
+   */
+  auto ImportKey(GpgData& data_in) -> QSharedPointer<GpgImportInformation>;
+
   /**
    * @brief
    *
@@ -107,6 +125,21 @@ class GF_CORE_EXPORT GpgKeyImportExporter
   void ExportAllKeys(const GpgAbstractKeyPtrList& keys, bool secret, bool ascii,
                      const GpgOperationCallback& cb) const;
 
+  /**
+   * @brief export the public keys and, if wanted, the secret keys one after
+   * another into the same data object. gpgme writes into it while
+   * exporting, so a stream or file backed data object keeps memory usage
+   * bounded.
+   *
+   * @param keys
+   * @param secret
+   * @param ascii
+   * @param data_out
+   * @return GpgError
+   */
+  auto ExportAllKeys(const GpgAbstractKeyPtrList& keys, bool secret, bool ascii,
+                     GpgData& data_out) const -> GpgError;
+
  private:
   GpgContext& ctx_;
 };
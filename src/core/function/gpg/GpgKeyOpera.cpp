@@ -194,6 +194,8 @@ auto GenerateKeyImpl(GpgContext& ctx,
           << params->IsAllowSign() << params->IsAllowAuth()
           << !params->IsSubKey();
 
+  // the passphrase asked for protects the new key
+  const GpgNewPassphraseScope new_passphrase_scope;
   err = gpgme_op_createkey(ctx.DefaultContext(), userid.toUtf8(), algo.toUtf8(),
                            0, expires, nullptr, flags);
 
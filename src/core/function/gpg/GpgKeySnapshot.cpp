@@ -0,0 +1,358 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "GpgKeySnapshot.h"
+
+#include <deque>
+
+#include "core/function/DataObjectOperator.h"
+#include "core/model/GpgKey.h"
+
+namespace GpgFrontend {
+
+namespace {
+
+constexpr int kSnapshotVersion = 1;
+
+/**
+ * @brief any of these files changing means the key table may have changed
+ *
+ */
+const QStringList kKeyringFiles = {"pubring.kbx", "pubring.gpg",
+                                   "public-keys.d/pubring.db", "trustdb.gpg"};
+
+enum KeyFlag : unsigned int {
+  kKEY_REVOKED,
+  kKEY_EXPIRED,
+  kKEY_DISABLED,
+  kKEY_INVALID,
+  kKEY_CAN_ENCRYPT,
+  kKEY_CAN_SIGN,
+  kKEY_CAN_CERTIFY,
+  kKEY_CAN_AUTH,
+  kKEY_SECRET,
+  kKEY_QUALIFIED,
+};
+
+enum SubkeyFlag : unsigned int {
+  kSUBKEY_REVOKED,
+  kSUBKEY_EXPIRED,
+  kSUBKEY_DISABLED,
+  kSUBKEY_INVALID,
+  kSUBKEY_CAN_ENCRYPT,
+  kSUBKEY_CAN_SIGN,
+  kSUBKEY_CAN_CERTIFY,
+  kSUBKEY_CAN_AUTH,
+  kSUBKEY_SECRET,
+  kSUBKEY_QUALIFIED,
+  kSUBKEY_CARD_KEY,
+  kSUBKEY_DE_VS,
+  kSUBKEY_CAN_RENC,
+};
+
+enum UIDFlag : unsigned int {
+  kUID_REVOKED,
+  kUID_INVALID,
+};
+
+auto PackFlags(std::initializer_list<QPair<unsigned int, unsigned int>> flags)
+    -> int {
+  int packed = 0;
+  for (const auto& flag : flags) {
+    if (flag.second != 0) packed |= 1 << flag.first;
+  }
+  return packed;
+}
+
+auto TestFlag(int packed, unsigned int flag) -> unsigned int {
+  return (packed >> flag) & 1;
+}
+
+auto StringValue(const char* str) -> QJsonValue {
+  return str != nullptr ? QJsonValue(QString::fromUtf8(str)) : QJsonValue();
+}
+
+auto TimeValue(long int time) -> QJsonValue {
+  return static_cast<double>(time);
+}
+
+/**
+ * @brief owns every struct and string a display-only key points to, the
+ * deques keep the addresses of their elements stable while growing. Only
+ * the public fields are filled, gpgme never gets to see these structs.
+ *
+ */
+struct SnapshotKeyStorage {
+  _gpgme_key key{};
+  std::deque<_gpgme_subkey> subkeys;
+  std::deque<_gpgme_user_id> uids;
+  std::deque<QByteArray> strings;
+
+  auto Keep(const QJsonValue& value) -> char* {
+    if (!value.isString()) return nullptr;
+    strings.push_back(value.toString().toUtf8());
+    return strings.back().data();
+  }
+};
+
+auto EncodeSubkey(gpgme_subkey_t s_key) -> QJsonObject {
+  QJsonObject obj;
+  obj["fpr"] = StringValue(s_key->fpr);
+  obj["keyid"] = StringValue(s_key->keyid);
+  obj["algo"] = static_cast<int>(s_key->pubkey_algo);
+  obj["length"] = static_cast<int>(s_key->length);
+  obj["timestamp"] = TimeValue(s_key->timestamp);
+  obj["expires"] = TimeValue(s_key->expires);
+  obj["card_number"] = StringValue(s_key->card_number);
+  obj["curve"] = StringValue(s_key->curve);
+  obj["keygrip"] = StringValue(s_key->keygrip);
+  obj["flags"] = PackFlags({
+      {kSUBKEY_REVOKED, s_key->revoked},
+      {kSUBKEY_EXPIRED, s_key->expired},
+      {kSUBKEY_DISABLED, s_key->disabled},
+      {kSUBKEY_INVALID, s_key->invalid},
+      {kSUBKEY_CAN_ENCRYPT, s_key->can_encrypt},
+      {kSUBKEY_CAN_SIGN, s_key->can_sign},
+      {kSUBKEY_CAN_CERTIFY, s_key->can_certify},
+      {kSUBKEY_CAN_AUTH, s_key->can_authenticate},
+      {kSUBKEY_SECRET, s_key->secret},
+      {kSUBKEY_QUALIFIED, s_key->is_qualified},
+      {kSUBKEY_CARD_KEY, s_key->is_cardkey},
+      {kSUBKEY_DE_VS, s_key->is_de_vs},
+      {kSUBKEY_CAN_RENC, s_key->can_renc},
+  });
+  return obj;
+}
+
+auto EncodeUID(gpgme_user_id_t uid) -> QJsonObject {
+  QJsonObject obj;
+  obj["uid"] = StringValue(uid->uid);
+  obj["name"] = StringValue(uid->name);
+  obj["email"] = StringValue(uid->email);
+  obj["comment"] = StringValue(uid->comment);
+  obj["address"] = StringValue(uid->address);
+  obj["validity"] = static_cast<int>(uid->validity);
+  obj["flags"] = PackFlags({
+      {kUID_REVOKED, uid->revoked},
+      {kUID_INVALID, uid->invalid},
+  });
+  return obj;
+}
+
+void DecodeSubkey(const QJsonObject& obj, SnapshotKeyStorage& storage,
+                  struct _gpgme_subkey& s_key) {
+  const auto flags = obj["flags"].toInt();
+  s_key.fpr = storage.Keep(obj["fpr"]);
+  s_key.keyid = storage.Keep(obj["keyid"]);
+  s_key.pubkey_algo = static_cast<gpgme_pubkey_algo_t>(obj["algo"].toInt());
+  s_key.length = static_cast<unsigned int>(obj["length"].toInt());
+  s_key.timestamp = static_cast<long int>(obj["timestamp"].toDouble());
+  s_key.expires = static_cast<long int>(obj["expires"].toDouble());
+  s_key.card_number = storage.Keep(obj["card_number"]);
+  s_key.curve = storage.Keep(obj["curve"]);
+  s_key.keygrip = storage.Keep(obj["keygrip"]);
+  s_key.revoked = TestFlag(flags, kSUBKEY_REVOKED);
+  s_key.expired = TestFlag(flags, kSUBKEY_EXPIRED);
+  s_key.disabled = TestFlag(flags, kSUBKEY_DISABLED);
+  s_key.invalid = TestFlag(flags, kSUBKEY_INVALID);
+  s_key.can_encrypt = TestFlag(flags, kSUBKEY_CAN_ENCRYPT);
+  s_key.can_sign = TestFlag(flags, kSUBKEY_CAN_SIGN);
+  s_key.can_certify = TestFlag(flags, kSUBKEY_CAN_CERTIFY);
+  s_key.can_authenticate = TestFlag(flags, kSUBKEY_CAN_AUTH);
+  s_key.secret = TestFlag(flags, kSUBKEY_SECRET);
+  s_key.is_qualified = TestFlag(flags, kSUBKEY_QUALIFIED);
+  s_key.is_cardkey = TestFlag(flags, kSUBKEY_CARD_KEY);
+  s_key.is_de_vs = TestFlag(flags, kSUBKEY_DE_VS);
+  s_key.can_renc = TestFlag(flags, kSUBKEY_CAN_RENC);
+}
+
+void DecodeUID(const QJsonObject& obj, SnapshotKeyStorage& storage,
+               struct _gpgme_user_id& uid) {
+  const auto flags = obj["flags"].toInt();
+  uid.uid = storage.Keep(obj["uid"]);
+  uid.name = storage.Keep(obj["name"]);
+  uid.email = storage.Keep(obj["email"]);
+  uid.comment = storage.Keep(obj["comment"]);
+  uid.address = storage.Keep(obj["address"]);
+  uid.validity = static_cast<gpgme_validity_t>(obj["validity"].toInt());
+  uid.revoked = TestFlag(flags, kUID_REVOKED);
+  uid.invalid = TestFlag(flags, kUID_INVALID);
+}
+
+}  // namespace
+
+GpgKeySnapshot::GpgKeySnapshot(QString db_path) : db_path_(std::move(db_path)) {
+  const auto dir = QDir(db_path_);
+  for (const auto& file : kKeyringFiles) {
+    const auto info = QFileInfo(dir.filePath(file));
+    if (!info.exists()) {
+      keyring_state_[file] = QJsonValue();
+      continue;
+    }
+
+    const auto mtime = info.lastModified().toMSecsSinceEpoch();
+    keyring_state_[file] = QJsonArray{static_cast<double>(info.size()),
+                                      static_cast<double>(mtime)};
+  }
+}
+
+auto GpgKeySnapshot::Load(const KeyFetcher& fetch_key) const
+    -> std::optional<GpgKeyPtrList> {
+  auto doc = DataObjectOperator::GetInstance().GetDataObject(object_name());
+  if (!doc.has_value() || !doc->isObject()) return {};
+
+  const auto root = doc->object();
+  if (root["version"].toInt() != kSnapshotVersion ||
+      root["keyring"].toObject() != keyring_state_) {
+    LOG_D() << "key snapshot is outdated, key db path:" << db_path_;
+    return {};
+  }
+
+  GpgKeyPtrList keys;
+  for (const auto& value : root["keys"].toArray()) {
+    auto key = DecodeKey(value.toObject(), fetch_key);
+    if (key == nullptr) return {};
+    keys.push_back(key);
+  }
+  return keys;
+}
+
+void GpgKeySnapshot::Save(const GpgKeyPtrList& keys) const {
+  QJsonArray array;
+  for (const auto& key : keys) array.append(EncodeKey(*key));
+
+  QJsonObject root;
+  root["version"] = kSnapshotVersion;
+  root["keyring"] = keyring_state_;
+  root["keys"] = array;
+  DataObjectOperator::GetInstance().SaveDataObj(object_name(),
+                                                QJsonDocument(root));
+}
+
+auto GpgKeySnapshot::EncodeKey(const GpgKey& key) -> QJsonObject {
+  const auto* k = key.DisplayData();
+
+  QJsonArray subkeys;
+  for (auto* next = k->subkeys; next != nullptr; next = next->next) {
+    subkeys.append(EncodeSubkey(next));
+  }
+
+  QJsonArray uids;
+  for (auto* next = k->uids; next != nullptr; next = next->next) {
+    uids.append(EncodeUID(next));
+  }
+
+  QJsonObject obj;
+  obj["fpr"] = StringValue(k->fpr);
+  obj["protocol"] = static_cast<int>(k->protocol);
+  obj["owner_trust"] = static_cast<int>(k->owner_trust);
+  obj["last_update"] = static_cast<double>(k->last_update);
+  obj["flags"] = PackFlags({
+      {kKEY_REVOKED, k->revoked},
+      {kKEY_EXPIRED, k->expired},
+      {kKEY_DISABLED, k->disabled},
+      {kKEY_INVALID, k->invalid},
+      {kKEY_CAN_ENCRYPT, k->can_encrypt},
+      {kKEY_CAN_SIGN, k->can_sign},
+      {kKEY_CAN_CERTIFY, k->can_certify},
+      {kKEY_CAN_AUTH, k->can_authenticate},
+      {kKEY_SECRET, k->secret},
+      {kKEY_QUALIFIED, k->is_qualified},
+  });
+  obj["subkeys"] = subkeys;
+  obj["uids"] = uids;
+  return obj;
+}
+
+auto GpgKeySnapshot::DecodeKey(const QJsonObject& obj,
+                               const KeyFetcher& fetch_key) -> GpgKeyPtr {
+  const auto subkeys = obj["subkeys"].toArray();
+  const auto uids = obj["uids"].toArray();
+  if (subkeys.isEmpty() || uids.isEmpty()) return nullptr;
+
+  auto storage = std::make_unique<SnapshotKeyStorage>();
+  auto& k = storage->key;
+
+  const auto flags = obj["flags"].toInt();
+  k.fpr = storage->Keep(obj["fpr"]);
+  if (k.fpr == nullptr) return nullptr;
+
+  k.protocol = static_cast<gpgme_protocol_t>(obj["protocol"].toInt());
+  k.owner_trust = static_cast<gpgme_validity_t>(obj["owner_trust"].toInt());
+  k.last_update = static_cast<unsigned long>(obj["last_update"].toDouble());
+  k.revoked = TestFlag(flags, kKEY_REVOKED);
+  k.expired = TestFlag(flags, kKEY_EXPIRED);
+  k.disabled = TestFlag(flags, kKEY_DISABLED);
+  k.invalid = TestFlag(flags, kKEY_INVALID);
+  k.can_encrypt = TestFlag(flags, kKEY_CAN_ENCRYPT);
+  k.can_sign = TestFlag(flags, kKEY_CAN_SIGN);
+  k.can_certify = TestFlag(flags, kKEY_CAN_CERTIFY);
+  k.can_authenticate = TestFlag(flags, kKEY_CAN_AUTH);
+  k.secret = TestFlag(flags, kKEY_SECRET);
+  k.is_qualified = TestFlag(flags, kKEY_QUALIFIED);
+
+  gpgme_subkey_t last_subkey = nullptr;
+  for (const auto& value : subkeys) {
+    auto& s_key = storage->subkeys.emplace_back();
+    DecodeSubkey(value.toObject(), *storage, s_key);
+    if (s_key.fpr == nullptr || s_key.keyid == nullptr) return nullptr;
+
+    if (last_subkey == nullptr) {
+      k.subkeys = &s_key;
+    } else {
+      last_subkey->next = &s_key;
+    }
+    last_subkey = &s_key;
+  }
+
+  gpgme_user_id_t last_uid = nullptr;
+  for (const auto& value : uids) {
+    auto& uid = storage->uids.emplace_back();
+    DecodeUID(value.toObject(), *storage, uid);
+
+    if (last_uid == nullptr) {
+      k.uids = &uid;
+    } else {
+      last_uid->next = &uid;
+    }
+    last_uid = &uid;
+  }
+
+  const auto fpr = QString::fromUtf8(k.fpr);
+  auto* raw = storage.release();
+  return QSharedPointer<GpgKey>::create(
+      QSharedPointer<struct _gpgme_key>(
+          &raw->key, [raw](struct _gpgme_key*) { delete raw; }),
+      [fetch_key, fpr]() { return fetch_key(fpr); });
+}
+
+auto GpgKeySnapshot::object_name() const -> QString {
+  return "key_snapshot_" + db_path_;
+}
+
+}  // namespace GpgFrontend
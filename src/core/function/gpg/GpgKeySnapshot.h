@@ -0,0 +1,115 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include <functional>
+#include <optional>
+
+#include "core/typedef/GpgTypedef.h"
+
+namespace GpgFrontend {
+
+/**
+ * @brief the decoded key table of a key database, kept between launches
+ * so that the key list can be shown before gpg has listed any key.
+ *
+ * a snapshot pins the state of the keyring files (size and mtime) at the
+ * time it is constructed. Load() only accepts a saved table carrying the
+ * same state, Save() stores the table with it. Construct the snapshot
+ * before listing the keys to save, so that a change made while listing
+ * invalidates it.
+ */
+class GF_CORE_EXPORT GpgKeySnapshot {
+ public:
+  /**
+   * @brief lists the real key with the given fingerprint, see
+   * GpgKey::GpgKey(display_ref, fetch_key)
+   *
+   */
+  using KeyFetcher = std::function<gpgme_key_t(const QString& fpr)>;
+
+  /**
+   * @brief Construct a new Gpg Key Snapshot object
+   *
+   * @param db_path home directory of the key database
+   */
+  explicit GpgKeySnapshot(QString db_path);
+
+  /**
+   * @brief read the saved key table
+   *
+   * @param fetch_key lists a real key once an operation needs it
+   * @return std::optional<GpgKeyPtrList> display-only keys, nothing if no
+   * table was saved, it has another format version or the keyring has
+   * changed since.
+   */
+  [[nodiscard]] auto Load(const KeyFetcher& fetch_key) const
+      -> std::optional<GpgKeyPtrList>;
+
+  /**
+   * @brief save the key table together with the pinned keyring state
+   *
+   * @param keys
+   */
+  void Save(const GpgKeyPtrList& keys) const;
+
+  /**
+   * @brief the fields of a key shown in the key list, two keys encoding
+   * to the same object render the same row.
+   *
+   * @param key
+   * @return QJsonObject
+   */
+  static auto EncodeKey(const GpgKey& key) -> QJsonObject;
+
+  /**
+   * @brief rebuild a display-only key from EncodeKey(). It carries no
+   * signatures or tofu info and is only a stand-in until gpg lists the
+   * real one, operations on it run on the key fetch_key returns.
+   *
+   * @param obj
+   * @param fetch_key
+   * @return GpgKeyPtr nullptr if obj is malformed
+   */
+  static auto DecodeKey(const QJsonObject& obj, const KeyFetcher& fetch_key)
+      -> GpgKeyPtr;
+
+ private:
+  QString db_path_;
+  QJsonObject keyring_state_;
+
+  /**
+   * @brief
+   *
+   * @return QString name of the data object
+   */
+  [[nodiscard]] auto object_name() const -> QString;
+};
+
+}  // namespace GpgFrontend
@@ -90,14 +90,18 @@ auto GpgSmartCardManager::IsSCDVersionSupported() -> bool {
 }
 
 auto GpgSmartCardManager::GetSerialNumbers() -> QStringList {
-  auto [r, s] = assuan_.SendStatusCommand(GpgComponentType::kGPG_AGENT,
-                                          "SCD SERIALNO --all");
-  if (r != GPG_ERR_NO_ERROR) {
+  // the active apps are cheap to query, fetch them in the same batch so that
+  // a changed card set costs a single round trip
+  auto results = assuan_.SendCommands(
+      GpgComponentType::kGPG_AGENT,
+      {"SCD SERIALNO --all", "SCD GETINFO all_active_apps"});
+  if (results.isEmpty() || results.front().err != GPG_ERR_NO_ERROR) {
     cached_scd_serialno_status_hash_.clear();
     cache_scd_card_serial_numbers_.clear();
     return {};
   }
 
+  const auto& s = results.front().status;
   auto hash =
       QCryptographicHash::hash(s.join(' ').toUtf8(), QCryptographicHash::Sha1)
           .toHex();
@@ -108,14 +112,13 @@ auto GpgSmartCardManager::GetSerialNumbers() -> QStringList {
 
   cached_scd_serialno_status_hash_.clear();
   cache_scd_card_serial_numbers_.clear();
-  auto [err, status] = assuan_.SendStatusCommand(GpgComponentType::kGPG_AGENT,
-                                                 "SCD GETINFO all_active_apps");
-  if (err != GPG_ERR_NO_ERROR || status.empty()) {
+  if (results.size() < 2 || results.back().err != GPG_ERR_NO_ERROR ||
+      results.back().status.empty()) {
     LOG_D() << "command SCD GETINFO all_active_apps failed, resetting...";
     return {};
   }
 
-  for (const auto& line : status) {
+  for (const auto& line : results.back().status) {
     auto tokens = line.split(' ');
 
     if (tokens.size() < 2 || tokens[0] != "SERIALNO") {
@@ -179,6 +182,46 @@ auto GpgSmartCardManager::FetchCardInfoBySerialNumber(
   return QSharedPointer<GpgOpenPGPCard>::create(card_info);
 }
 
+auto GpgSmartCardManager::SelectAndFetchCardInfo(const QString& serial_number)
+    -> std::tuple<GpgError, QString, QSharedPointer<GpgOpenPGPCard>> {
+  if (serial_number.trimmed().isEmpty()) {
+    return {GPG_ERR_INV_ARG, "Serial Number is empty.", nullptr};
+  }
+
+  auto results = assuan_.SendCommands(
+      GpgComponentType::kGPG_AGENT,
+      {QString("SCD SERIALNO --demand=%1 openpgp").arg(serial_number),
+       "SCD LEARN --force " + serial_number});
+
+  const auto& select = results.front();
+  if (select.err != GPG_ERR_NO_ERROR || select.status.isEmpty()) {
+    return {select.err, select.status.join(' '), nullptr};
+  }
+
+  const auto& line = select.status.front();
+  if (line.split(' ').size() != 2) {
+    LOG_E() << "invalid response of command SERIALNO: " << line;
+    return {GPG_ERR_USER_1, line, nullptr};
+  }
+
+  LOG_D() << "selected smart card by serial number: " << serial_number;
+
+  if (results.size() < 2) return {GPG_ERR_NO_ERROR, {}, nullptr};
+
+  const auto& learn = results.back();
+  if (learn.err != GPG_ERR_NO_ERROR || learn.status.isEmpty()) {
+    LOG_E() << "scd learn failed, err: " << CheckGpgError(learn.err) << ""
+            << learn.status;
+    return {GPG_ERR_NO_ERROR, {}, nullptr};
+  }
+
+  auto card_info = GpgOpenPGPCard(learn.status);
+  if (!card_info.good) return {GPG_ERR_NO_ERROR, {}, nullptr};
+
+  return {GPG_ERR_NO_ERROR, {},
+          QSharedPointer<GpgOpenPGPCard>::create(card_info)};
+}
+
 auto PercentDataEscape(const QByteArray& data, bool plus_escape = false,
                        const QString& prefix = QString()) -> QString {
   QString result;
@@ -215,7 +258,34 @@ auto PercentDataEscape(const QByteArray& data, bool plus_escape = false,
   return result;
 }
 
-auto GpgSmartCardManager::ModifyAttr(const QString& attr, const QString& value)
+auto GpgSmartCardManager::send_to_selected_card(const QString& serial_number,
+                                                const QString& command)
+    -> std::tuple<GpgError, QString> {
+  if (serial_number.trimmed().isEmpty()) {
+    return {GPG_ERR_INV_ARG, "Serial Number is empty."};
+  }
+
+  // select and modify over the same connection, otherwise the command may
+  // reach a pooled session which has another card selected
+  auto results = assuan_.SendCommands(
+      GpgComponentType::kGPG_AGENT,
+      {QString("SCD SERIALNO --demand=%1 openpgp").arg(serial_number),
+       command});
+
+  const auto& select = results.front();
+  if (select.err != GPG_ERR_NO_ERROR || select.status.isEmpty()) {
+    return {select.err != GPG_ERR_NO_ERROR ? select.err : GPG_ERR_USER_1,
+            select.status.join(' ')};
+  }
+
+  if (results.size() < 2) return {GPG_ERR_USER_1, select.status.join(' ')};
+
+  const auto& result = results.back();
+  return {result.err, result.status.join(' ')};
+}
+
+auto GpgSmartCardManager::ModifyAttr(const QString& serial_number,
+                                     const QString& attr, const QString& value)
     -> std::tuple<GpgError, QString> {
   if (attr.trimmed().isEmpty() || value.trimmed().isEmpty()) {
     return {GPG_ERR_INV_ARG, "ATTR or Value is empty"};
@@ -225,12 +295,11 @@ auto GpgSmartCardManager::ModifyAttr(const QString& attr, const QString& value)
   const auto escaped_command =
       PercentDataEscape(value.trimmed().toUtf8(), true, command);
 
-  auto [err, status] =
-      assuan_.SendStatusCommand(GpgComponentType::kGPG_AGENT, escaped_command);
-  return {err, status.join(' ')};
+  return send_to_selected_card(serial_number, escaped_command);
 }
 
-auto GpgSmartCardManager::ModifyPin(const QString& pin_ref)
+auto GpgSmartCardManager::ModifyPin(const QString& serial_number,
+                                    const QString& pin_ref)
     -> std::tuple<GpgError, QString> {
   if (pin_ref.trimmed().isEmpty()) {
     return {GPG_ERR_INV_ARG, "PIN Reference is empty"};
@@ -247,9 +316,7 @@ auto GpgSmartCardManager::ModifyPin(const QString& pin_ref)
     command = QString("SCD PASSWD %1").arg(pin_ref);
   }
 
-  auto [err, status] =
-      assuan_.SendStatusCommand(GpgComponentType::kGPG_AGENT, command);
-  return {err, status.join(' ')};
+  return send_to_selected_card(serial_number, command);
 }
 
 auto GpgSmartCardManager::GenerateKey(const QString& serial_number,
@@ -74,6 +74,15 @@ class GF_CORE_EXPORT GpgSmartCardManager
   auto FetchCardInfoBySerialNumber(const QString&)
       -> QSharedPointer<GpgOpenPGPCard>;
 
+  /**
+   * @brief select the card and learn its info in a single batch, the card
+   * info is nullptr when selecting succeeded but learning failed.
+   *
+   * @return std::tuple<GpgError, QString, QSharedPointer<GpgOpenPGPCard>>
+   */
+  auto SelectAndFetchCardInfo(const QString& serial_number)
+      -> std::tuple<GpgError, QString, QSharedPointer<GpgOpenPGPCard>>;
+
   /**
    * @brief
    *
@@ -85,20 +94,21 @@ class GF_CORE_EXPORT GpgSmartCardManager
   auto Fetch(const QString& serial_number) -> GpgError;
 
   /**
-   * @brief
+   * @brief select the card and set the attribute on it over one connection
    *
    * @return std::tuple<bool, QString>
    */
-  auto ModifyAttr(const QString& attr, const QString& value)
-      -> std::tuple<GpgError, QString>;
+  auto ModifyAttr(const QString& serial_number, const QString& attr,
+                  const QString& value) -> std::tuple<GpgError, QString>;
 
   /**
-   * @brief
+   * @brief select the card and change the pin on it over one connection
    *
    * @param pin_ref
    * @return std::tuple<bool, QString>
    */
-  auto ModifyPin(const QString& pin_ref) -> std::tuple<GpgError, QString>;
+  auto ModifyPin(const QString& serial_number, const QString& pin_ref)
+      -> std::tuple<GpgError, QString>;
 
   /**
    * @brief
@@ -128,6 +138,16 @@ class GF_CORE_EXPORT GpgSmartCardManager
 
   QString cached_scd_serialno_status_hash_;
   QContainer<QString> cache_scd_card_serial_numbers_;
+  /**
+   * @brief select the card and send the command in the same session
+   *
+   * @param serial_number
+   * @param command
+   * @return std::tuple<GpgError, QString>
+   */
+  auto send_to_selected_card(const QString& serial_number,
+                             const QString& command)
+      -> std::tuple<GpgError, QString>;
 };
 
 }  // namespace GpgFrontend
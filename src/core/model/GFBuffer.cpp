@@ -28,32 +28,68 @@
 
 #include "GFBuffer.h"
 
+#include <cstring>
+
 namespace GpgFrontend {
 
 GFBuffer::GFBuffer() = default;
 
-GFBuffer::GFBuffer(QByteArray buffer) : buffer_(std::move(buffer)) {}
+GFBuffer::GFBuffer(QByteArray buffer)
+    : buffer_(std::move(buffer)), size_(buffer_.size()) {}
 
-GFBuffer::GFBuffer(const QString& str) : buffer_(str.toUtf8()) {}
+GFBuffer::GFBuffer(const QString& str)
+    : buffer_(str.toUtf8()), size_(buffer_.size()) {}
 
 auto GFBuffer::operator==(const GFBuffer& o) const -> bool {
-  return buffer_ == o.buffer_;
+  if (size_ != o.size_) return false;
+  return size_ == 0 || std::memcmp(Data(), o.Data(), size_) == 0;
 }
 
-auto GFBuffer::Data() const -> const char* { return buffer_.constData(); }
+auto GFBuffer::Data() const -> const char* {
+  return buffer_.constData() + offset_;
+}
 
-void GFBuffer::Resize(ssize_t size) { buffer_.resize(size); }
+void GFBuffer::Resize(ssize_t size) {
+  detach_slice();
+  buffer_.resize(size);
+  size_ = buffer_.size();
+}
 
-auto GFBuffer::Size() const -> size_t { return buffer_.size(); }
+auto GFBuffer::Size() const -> size_t { return size_; }
 
-auto GFBuffer::ConvertToQByteArray() const -> QByteArray { return buffer_; }
+auto GFBuffer::ConvertToQByteArray() const -> QByteArray {
+  if (!is_partial()) return buffer_;
+  return QByteArray(Data(), static_cast<qsizetype>(size_));
+}
 
 auto GFBuffer::Empty() const -> bool { return this->Size() == 0; }
 
-void GFBuffer::Append(const GFBuffer& o) { buffer_.append(o.buffer_); }
+void GFBuffer::Append(const GFBuffer& o) { Append(o.Data(), o.Size()); }
 
 void GFBuffer::Append(const char* buffer, ssize_t size) {
+  detach_slice();
   buffer_.append(buffer, size);
+  size_ = buffer_.size();
+}
+
+auto GFBuffer::Slice(size_t offset, ssize_t size) const -> GFBuffer {
+  GFBuffer slice;
+  slice.buffer_ = buffer_;
+  slice.offset_ = offset_ + std::min(offset, size_);
+
+  const auto remain = size_ - (slice.offset_ - offset_);
+  slice.size_ = size < 0 ? remain : std::min(static_cast<size_t>(size), remain);
+  return slice;
+}
+
+auto GFBuffer::is_partial() const -> bool {
+  return offset_ != 0 || size_ != static_cast<size_t>(buffer_.size());
+}
+
+void GFBuffer::detach_slice() {
+  if (!is_partial()) return;
+  buffer_ = ConvertToQByteArray();
+  offset_ = 0;
 }
 
-}  // namespace GpgFrontend
\ No newline at end of file
+}  // namespace GpgFrontend
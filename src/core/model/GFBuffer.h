@@ -54,10 +54,44 @@ class GF_CORE_EXPORT GFBuffer {
 
   void Append(const char*, ssize_t);
 
+  /**
+   * @brief a read only view of [offset, offset + size) sharing the storage
+   * of this buffer, no bytes are copied. a negative size means up to the
+   * end; the range is clamped to the buffer.
+   *
+   * @param offset
+   * @param size
+   * @return GFBuffer
+   */
+  [[nodiscard]] auto Slice(size_t offset, ssize_t size = -1) const
+      -> GFBuffer;
+
+  /**
+   * @brief shares the storage when the buffer is not a partial slice,
+   * otherwise copies the viewed bytes.
+   *
+   * @return QByteArray
+   */
   [[nodiscard]] auto ConvertToQByteArray() const -> QByteArray;
 
  private:
   QByteArray buffer_;
+  size_t offset_ = 0;  ///< start of the view inside buffer_
+  size_t size_ = 0;    ///< length of the view
+
+  /**
+   * @brief
+   *
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] auto is_partial() const -> bool;
+
+  /**
+   * @brief copy the viewed bytes into storage of its own before a write
+   *
+   */
+  void detach_slice();
 };
 
 }  // namespace GpgFrontend
\ No newline at end of file
@@ -28,57 +28,83 @@
 
 #include "GFDataExchanger.h"
 
+#include <cstring>
+
 namespace GpgFrontend {
 
+auto GFDataExchanger::push(const std::byte* buffer, size_t size) -> size_t {
+  const auto n = std::min(size, capacity_ - used_);
+  const auto tail = (head_ + used_) % capacity_;
+  const auto first = std::min(n, capacity_ - tail);
+
+  std::memcpy(ring_.data() + tail, buffer, first);
+  std::memcpy(ring_.data(), buffer + first, n - first);
+
+  used_ += n;
+  return n;
+}
+
+auto GFDataExchanger::pop(std::byte* buffer, size_t size) -> size_t {
+  const auto n = std::min(size, used_);
+  const auto first = std::min(n, capacity_ - head_);
+
+  std::memcpy(buffer, ring_.data() + head_, first);
+  std::memcpy(buffer + first, ring_.data(), n - first);
+
+  head_ = (head_ + n) % capacity_;
+  used_ -= n;
+  return n;
+}
+
 auto GFDataExchanger::Write(const std::byte* buffer, size_t size) -> ssize_t {
   if (close_) return -1;
   if (size == 0) return 0;
 
-  std::atomic<ssize_t> write_bytes = 0;
   std::unique_lock<std::mutex> lock(mutex_);
-  try {
-    for (size_t i = 0; i < size; i++) {
-      if (queue_.size() == static_cast<unsigned long>(queue_max_size_)) {
-        not_empty_.notify_all();
-      }
-
-      not_full_.wait(lock, [=] {
-        return queue_.size() < static_cast<unsigned long>(queue_max_size_) ||
-               close_;
-      });
-      if (close_) return -1;
-
-      queue_.push(buffer[i]);
-      write_bytes++;
+
+  size_t write_bytes = 0;
+  while (write_bytes < size) {
+    if (used_ == capacity_) {
+      // the ring is full, so the reader must be woken before we sleep
+      if (readers_waiting_ > 0) not_empty_.notify_all();
+
+      writers_waiting_++;
+      not_full_.wait(lock, [=] { return used_ < capacity_ || close_; });
+      writers_waiting_--;
+    }
+    if (close_) return -1;
+
+    write_bytes += push(buffer + write_bytes, size - write_bytes);
+
+    if (readers_waiting_ > 0 && used_ >= watermark_) {
+      not_empty_.notify_all();
     }
-  } catch (...) {
-    FLOG_W(
-        "gf data exchanger caught exception when it writes to queue, abort...");
   }
 
-  if (!queue_.empty()) not_empty_.notify_all();
-  return write_bytes;
+  // the producer may not come back for a while, hand over what we have
+  if (readers_waiting_ > 0) not_empty_.notify_all();
+  return static_cast<ssize_t>(write_bytes);
 }
 
 auto GFDataExchanger::Read(std::byte* buffer, size_t size) -> ssize_t {
   std::unique_lock<std::mutex> lock(mutex_);
-  if (size == 0 || (close_ && queue_.empty())) return 0;
+  if (size == 0 || (close_ && used_ == 0)) return 0;
 
-  std::atomic<ssize_t> read_bytes = 0;
-  for (size_t i = 0; i < size; ++i) {
-    if (queue_.empty()) not_full_.notify_all();
-    not_empty_.wait(lock, [=] { return !queue_.empty() || close_; });
-
-    if (close_ && queue_.empty()) return 0;
-    buffer[i] = queue_.front();
-    queue_.pop();
-    read_bytes++;
+  if (used_ == 0) {
+    readers_waiting_++;
+    not_empty_.wait(lock, [=] { return used_ > 0 || close_; });
+    readers_waiting_--;
   }
+  if (used_ == 0) return 0;
+
+  const auto read_bytes = pop(buffer, size);
 
-  if (queue_.size() < static_cast<unsigned long>(queue_max_size_)) {
+  // an empty ring is always above the watermark, so a blocked writer can
+  // never be left asleep once the reader catches up
+  if (writers_waiting_ > 0 && capacity_ - used_ >= watermark_) {
     not_full_.notify_all();
   }
-  return read_bytes;
+  return static_cast<ssize_t>(read_bytes);
 }
 
 void GFDataExchanger::CloseWrite() {
@@ -89,6 +115,9 @@ void GFDataExchanger::CloseWrite() {
   not_empty_.notify_all();
 }
 
-GFDataExchanger::GFDataExchanger(ssize_t size) : queue_max_size_(size) {}
+GFDataExchanger::GFDataExchanger(ssize_t size)
+    : ring_(static_cast<size_t>(std::max<ssize_t>(size, 1))),
+      capacity_(ring_.size()),
+      watermark_(std::max<size_t>(capacity_ / 4, 1)) {}
 
-}  // namespace GpgFrontend
\ No newline at end of file
+}  // namespace GpgFrontend
@@ -29,33 +29,69 @@
 #pragma once
 
 #include <cstddef>
-#include <queue>
+#include <vector>
 
 namespace GpgFrontend {
 
 constexpr ssize_t kDataExchangerSize =
     static_cast<const ssize_t>(1024 * 1024 * 8);  // 8 MB
 
-class GFDataExchanger {
+/**
+ * @brief a bounded single-producer/single-consumer byte pipe backed by a
+ * fixed-capacity ring buffer. Write() blocks while the ring is full and
+ * Read() blocks while it is empty; both move whole spans with memcpy and
+ * only wake the other side when a watermark is crossed.
+ *
+ */
+class GF_CORE_EXPORT GFDataExchanger {
  public:
   explicit GFDataExchanger(ssize_t size);
 
+  /**
+   * @brief write all bytes of the buffer, blocking while the ring is full
+   *
+   * @return written bytes, or -1 if the write side was closed
+   */
   auto Write(const std::byte* buffer, size_t size) -> ssize_t;
 
+  /**
+   * @brief read at most size bytes, blocking until some data is available
+   *
+   * @return read bytes, or 0 if the write side is closed and drained
+   */
   auto Read(std::byte* buffer, size_t size) -> ssize_t;
 
   void CloseWrite();
 
  private:
   std::condition_variable not_full_, not_empty_;
-  std::queue<std::byte> queue_;
   std::mutex mutex_;
-  const ssize_t queue_max_size_;
+  std::vector<std::byte> ring_;
+  const size_t capacity_;
+  const size_t watermark_;
+  size_t head_ = 0;  ///< read position
+  size_t used_ = 0;  ///< bytes currently stored
+  int readers_waiting_ = 0;
+  int writers_waiting_ = 0;
   std::atomic_bool close_ = false;
+
+  /**
+   * @brief copy into the ring, the caller must hold the lock
+   *
+   * @return copied bytes
+   */
+  auto push(const std::byte* buffer, size_t size) -> size_t;
+
+  /**
+   * @brief copy out of the ring, the caller must hold the lock
+   *
+   * @return copied bytes
+   */
+  auto pop(std::byte* buffer, size_t size) -> size_t;
 };
 
 inline auto CreateStandardGFDataExchanger() -> QSharedPointer<GFDataExchanger> {
   return QSharedPointer<GFDataExchanger>::create(kDataExchangerSize);
 }
 
-}  // namespace GpgFrontend
\ No newline at end of file
+}  // namespace GpgFrontend
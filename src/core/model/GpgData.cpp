@@ -30,12 +30,63 @@
 
 #include <unistd.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
+
+#include <cerrno>
+#include <cstring>
+
 #include "core/model/GFDataExchanger.h"
 #include "core/typedef/GpgTypedef.h"
 
 namespace GpgFrontend {
 
 constexpr size_t kBufferSize = 32 * 1024;
+constexpr qsizetype kOutputBufferSize = 4 * 1024 * 1024;
+
+struct GpgData::MappedInput {
+  QFile file;
+  const uchar* base = nullptr;
+  qint64 size = 0;
+  qint64 pos = 0;
+};
+
+struct GpgData::BufferedOutput {
+  int fd = -1;
+  QByteArray buffer;
+  qsizetype used = 0;
+  qint64 offset = 0;  ///< file offset of buffer[0]
+
+  [[nodiscard]] auto WriteAll(const char* data, qint64 len) const -> bool {
+#if defined(__unix__) || defined(__APPLE__)
+    qint64 done = 0;
+    while (done < len) {
+      auto ret = pwrite(fd, data + done, len - done,
+                        static_cast<off_t>(offset + done));
+      if (ret < 0 && errno == EINTR) continue;
+      if (ret <= 0) return false;
+      done += ret;
+    }
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  auto Flush() -> bool {
+    if (used == 0) return true;
+    if (!WriteAll(buffer.constData(), used)) return false;
+
+    offset += used;
+    used = 0;
+    return true;
+  }
+
+  ~BufferedOutput() {
+    if (fd >= 0) close(fd);
+  }
+};
 
 auto GFReadExCb(void* handle, void* buffer, size_t size) -> ssize_t {
   auto* ex = static_cast<GFDataExchanger*>(handle);
@@ -90,7 +141,12 @@ GpgData::GpgData(int fd) : fd_(fd), data_cbs_() {
   data_ref_ = std::unique_ptr<struct gpgme_data, DataRefDeleter>(data);
 }
 
-GpgData::GpgData(const QString& path, bool read) {
+GpgData::GpgData(const QString& path, bool read, bool use_stream)
+    : data_cbs_() {
+  if (!use_stream) {
+    if (read ? init_mapped_input(path) : init_buffered_output(path)) return;
+  }
+
   gpgme_data_t data;
 
   // support unicode path
@@ -104,6 +160,150 @@ GpgData::GpgData(const QString& path, bool read) {
   data_ref_ = std::unique_ptr<struct gpgme_data, DataRefDeleter>(data);
 }
 
+auto GpgData::init_mapped_input(const QString& path) -> bool {
+  auto in = std::make_unique<MappedInput>();
+  in->file.setFileName(path);
+  if (!in->file.open(QIODevice::ReadOnly) || in->file.size() <= 0) {
+    return false;
+  }
+
+  in->size = in->file.size();
+  in->base = in->file.map(0, in->size);
+  if (in->base == nullptr) return false;
+
+#if defined(__unix__) || defined(__APPLE__)
+  posix_madvise(const_cast<uchar*>(in->base), in->size,
+                POSIX_MADV_SEQUENTIAL);
+#endif
+
+  data_cbs_.read = [](void* handle, void* buffer, size_t size) -> ssize_t {
+    auto* in = static_cast<MappedInput*>(handle);
+    auto len = std::min(static_cast<qint64>(size), in->size - in->pos);
+    if (len <= 0) return 0;
+
+    std::memcpy(buffer, in->base + in->pos, len);
+    in->pos += len;
+    return static_cast<ssize_t>(len);
+  };
+  data_cbs_.write = nullptr;
+  data_cbs_.seek = [](void* handle, off_t offset, int whence) -> off_t {
+    auto* in = static_cast<MappedInput*>(handle);
+
+    qint64 pos = offset;
+    if (whence == SEEK_CUR) pos += in->pos;
+    if (whence == SEEK_END) pos += in->size;
+    if (pos < 0) {
+      errno = EINVAL;
+      return -1;
+    }
+
+    in->pos = pos;
+    return static_cast<off_t>(pos);
+  };
+  data_cbs_.release = nullptr;
+
+  gpgme_data_t data;
+  auto err = gpgme_data_new_from_cbs(&data, &data_cbs_, in.get());
+  if (gpgme_err_code(err) != GPG_ERR_NO_ERROR) return false;
+
+  mapped_in_ = std::move(in);
+  data_ref_ = std::unique_ptr<struct gpgme_data, DataRefDeleter>(data);
+  return true;
+}
+
+auto GpgData::init_buffered_output(const QString& path) -> bool {
+#if defined(__unix__) || defined(__APPLE__)
+  // support unicode path
+  QFile file(path);
+  if (!file.open(QIODevice::WriteOnly)) return false;
+
+  auto out = std::make_unique<BufferedOutput>();
+  out->fd = dup(file.handle());
+  if (out->fd < 0) return false;
+  out->buffer.resize(kOutputBufferSize);
+
+  data_cbs_.read = nullptr;
+  data_cbs_.write = [](void* handle, const void* buffer,
+                       size_t size) -> ssize_t {
+    auto* out = static_cast<BufferedOutput*>(handle);
+    const auto len = static_cast<qsizetype>(size);
+
+    if (out->used + len > out->buffer.size() && !out->Flush()) return -1;
+
+    // a block larger than the buffer goes straight to the file
+    if (len >= out->buffer.size()) {
+      if (!out->WriteAll(static_cast<const char*>(buffer), len)) return -1;
+      out->offset += len;
+      return static_cast<ssize_t>(size);
+    }
+
+    std::memcpy(out->buffer.data() + out->used, buffer, len);
+    out->used += len;
+    return static_cast<ssize_t>(size);
+  };
+  data_cbs_.seek = [](void* handle, off_t offset, int whence) -> off_t {
+    auto* out = static_cast<BufferedOutput*>(handle);
+    if (!out->Flush()) return -1;
+
+    qint64 pos = offset;
+    if (whence == SEEK_CUR) pos += out->offset;
+    if (whence == SEEK_END) {
+      auto end = lseek(out->fd, 0, SEEK_END);
+      if (end < 0) return -1;
+      pos += end;
+    }
+    if (pos < 0) {
+      errno = EINVAL;
+      return -1;
+    }
+
+    out->offset = pos;
+    return static_cast<off_t>(pos);
+  };
+  data_cbs_.release = nullptr;
+
+  gpgme_data_t data;
+  auto err = gpgme_data_new_from_cbs(&data, &data_cbs_, out.get());
+  if (gpgme_err_code(err) != GPG_ERR_NO_ERROR) return false;
+
+  buffered_out_ = std::move(out);
+  data_ref_ = std::unique_ptr<struct gpgme_data, DataRefDeleter>(data);
+  return true;
+#else
+  return false;
+#endif
+}
+
+GpgData::GpgData(StreamCallbacks callbacks)
+    : stream_cbs_(std::make_unique<StreamCallbacks>(std::move(callbacks))),
+      data_cbs_() {
+  data_cbs_.read = [](void* handle, void* buffer, size_t size) -> ssize_t {
+    auto* cbs = static_cast<StreamCallbacks*>(handle);
+    if (!cbs->read) {
+      errno = EBADF;
+      return -1;
+    }
+    return cbs->read(buffer, size);
+  };
+  data_cbs_.write = [](void* handle, const void* buffer,
+                       size_t size) -> ssize_t {
+    auto* cbs = static_cast<StreamCallbacks*>(handle);
+    if (!cbs->write) {
+      errno = EBADF;
+      return -1;
+    }
+    return cbs->write(buffer, size);
+  };
+  data_cbs_.seek = nullptr;
+  data_cbs_.release = nullptr;
+
+  gpgme_data_t data;
+  auto err = gpgme_data_new_from_cbs(&data, &data_cbs_, stream_cbs_.get());
+  assert(gpgme_err_code(err) == GPG_ERR_NO_ERROR);
+
+  data_ref_ = std::unique_ptr<struct gpgme_data, DataRefDeleter>(data);
+}
+
 GpgData::GpgData(QSharedPointer<GFDataExchanger> ex)
     : data_cbs_(), data_ex_(std::move(ex)) {
   gpgme_data_t data;
@@ -120,6 +320,15 @@ GpgData::GpgData(QSharedPointer<GFDataExchanger> ex)
 }
 
 GpgData::~GpgData() {
+  // release the gpgme data first, it may still call back into our state
+  data_ref_.reset();
+
+  if (buffered_out_ != nullptr && buffered_out_->used > 0 &&
+      !buffered_out_->Flush()) {
+    LOG_W() << "dropped" << buffered_out_->used
+            << "buffered bytes of a file output, errno:" << errno;
+  }
+
   if (fp_ != nullptr) {
     fclose(fp_);
   }
@@ -130,25 +339,51 @@ GpgData::~GpgData() {
 }
 
 auto GpgData::Read2GFBuffer() -> GFBuffer {
-  gpgme_off_t ret = gpgme_data_seek(*this, 0, SEEK_SET);
-  GFBuffer out_buffer;
+  // memory, fd and stream backed data report their length, which lets the
+  // buffer be allocated once instead of growing chunk by chunk
+  const gpgme_off_t size_hint = gpgme_data_seek(*this, 0, SEEK_END);
 
+  gpgme_off_t ret = gpgme_data_seek(*this, 0, SEEK_SET);
   if (ret != 0) {
     const GpgError err = gpgme_err_code_from_errno(errno);
     assert(gpgme_err_code(err) == GPG_ERR_NO_ERROR);
-  } else {
-    std::array<char, kBufferSize + 2> buf;
+    return {};
+  }
 
-    while ((ret = gpgme_data_read(*this, buf.data(), kBufferSize)) > 0) {
-      out_buffer.Append(buf.data(), ret);
-    }
+  // one spare byte so that the read hitting eof doesn't trigger a regrowth
+  QByteArray buffer(
+      size_hint > 0 ? static_cast<qsizetype>(size_hint) + 1 : kBufferSize,
+      Qt::Uninitialized);
+  qsizetype used = 0;
 
-    if (ret < 0) {
-      const GpgError err = gpgme_err_code_from_errno(errno);
-      assert(gpgme_err_code(err) == GPG_ERR_NO_ERROR);
-    }
+  while (true) {
+    if (used == buffer.size()) buffer.resize(buffer.size() * 2);
+
+    ret = gpgme_data_read(*this, buffer.data() + used, buffer.size() - used);
+    if (ret <= 0) break;
+    used += static_cast<qsizetype>(ret);
+  }
+
+  if (ret < 0) {
+    const GpgError err = gpgme_err_code_from_errno(errno);
+    assert(gpgme_err_code(err) == GPG_ERR_NO_ERROR);
+  }
+
+  buffer.resize(used);
+  return GFBuffer(std::move(buffer));
+}
+
+auto GpgData::FlushOutput() -> GpgError {
+  errno = 0;
+  if (buffered_out_ != nullptr && !buffered_out_->Flush()) {
+    return gpgme_error_from_errno(errno != 0 ? errno : EIO);
+  }
+
+  if (fp_ != nullptr && (fflush(fp_) != 0 || ferror(fp_) != 0)) {
+    return gpgme_error_from_errno(errno != 0 ? errno : EIO);
   }
-  return out_buffer;
+
+  return GPG_ERR_NO_ERROR;
 }
 
 GpgData::operator gpgme_data_t() { return data_ref_.get(); }
@@ -43,6 +43,17 @@ class GFDataExchanger;
  */
 class GF_CORE_EXPORT GpgData {
  public:
+  /**
+   * @brief callbacks of a data object that streams from or to the caller,
+   * only one of them is usually set. both follow read(2) and write(2)
+   * semantics and return -1 on error.
+   *
+   */
+  struct StreamCallbacks {
+    std::function<ssize_t(void*, size_t)> read;
+    std::function<ssize_t(const void*, size_t)> write;
+  };
+
   /**
    * @brief Construct a new Gpg Data object
    *
@@ -73,11 +84,15 @@ class GF_CORE_EXPORT GpgData {
   explicit GpgData(QSharedPointer<GFDataExchanger>);
 
   /**
-   * @brief Construct a new Gpg Data object
+   * @brief Construct a new Gpg Data object on a file. input files are
+   * mapped into memory and output is written through a large buffer with
+   * pwrite(); both fall back to a stdio stream when not possible.
    *
    * @param path
+   * @param read
+   * @param use_stream always use the stdio stream
    */
-  explicit GpgData(const QString& path, bool read);
+  explicit GpgData(const QString& path, bool read, bool use_stream = false);
 
   /**
    * @brief Construct a new Gpg Data object
@@ -85,6 +100,13 @@ class GF_CORE_EXPORT GpgData {
    */
   explicit GpgData(GFBuffer);
 
+  /**
+   * @brief Construct a new Gpg Data object which passes everything through
+   * the callbacks without buffering it.
+   *
+   */
+  explicit GpgData(StreamCallbacks);
+
   /**
    * @brief Destroy the Gpg Data object
    *
@@ -105,11 +127,40 @@ class GF_CORE_EXPORT GpgData {
    */
   auto Read2GFBuffer() -> GFBuffer;
 
+  /**
+   * @brief write out everything still buffered for a file output. call it
+   * after the operation succeeded, the destructor can only log a failure.
+   *
+   * @return GpgError the error of the final write, if any
+   */
+  auto FlushOutput() -> GpgError;
+
  private:
   /**
    * @brief
    *
    */
+  struct MappedInput;
+  struct BufferedOutput;
+
+  /**
+   * @brief
+   *
+   * @param path
+   * @return true
+   * @return false
+   */
+  auto init_mapped_input(const QString& path) -> bool;
+
+  /**
+   * @brief
+   *
+   * @param path
+   * @return true
+   * @return false
+   */
+  auto init_buffered_output(const QString& path) -> bool;
+
   struct DataRefDeleter {
     void operator()(gpgme_data_t _data) {
       if (_data != nullptr) gpgme_data_release(_data);
@@ -118,6 +169,11 @@ class GF_CORE_EXPORT GpgData {
 
   GFBuffer cached_buffer_;
 
+  // must outlive data_ref_, gpgme calls back into them until released
+  std::unique_ptr<MappedInput> mapped_in_;
+  std::unique_ptr<BufferedOutput> buffered_out_;
+  std::unique_ptr<StreamCallbacks> stream_cbs_;
+
   std::unique_ptr<struct gpgme_data, DataRefDeleter> data_ref_ = nullptr;  ///<
   FILE* fp_ = nullptr;
   int fd_ = -1;
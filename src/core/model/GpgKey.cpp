@@ -28,19 +28,106 @@
 
 #include "core/model/GpgKey.h"
 
+#include <mutex>
+
 namespace GpgFrontend {
 
-GpgKey::GpgKey() = default;
+struct GpgKey::DecodedKey {
+  enum Flag : unsigned int {
+    kACTUAL_SIGN = 1 << 0,
+    kACTUAL_ENCR = 1 << 1,
+    kACTUAL_AUTH = 1 << 2,
+    kCARD_KEY = 1 << 3,
+  };
+
+  QContainer<GpgSubKey> sub_keys;
+  QContainer<GpgUID> uids;
+  unsigned int flags = 0;
+
+  [[nodiscard]] auto Has(Flag flag) const -> bool {
+    return (flags & flag) != 0;
+  }
+};
+
+struct GpgKey::RealKey {
+  std::mutex mutex;
+  std::function<gpgme_key_t()> fetch_key;
+  QSharedPointer<struct _gpgme_key> key_ref;
+  bool fetched = false;
+};
+
+GpgKey::GpgKey() : decoded_(decode()) {}
 
 GpgKey::GpgKey(gpgme_key_t key)
-    : key_ref_(key, [](struct _gpgme_key *ptr) {
-        if (ptr != nullptr) gpgme_key_unref(ptr);
-      }) {}
+    : key_ref_(key,
+               [](struct _gpgme_key *ptr) {
+                 if (ptr != nullptr) gpgme_key_unref(ptr);
+               }),
+      decoded_(decode()) {}
 
 GpgKey::GpgKey(QSharedPointer<struct _gpgme_key> key_ref)
-    : key_ref_(std::move(key_ref)) {}
+    : key_ref_(std::move(key_ref)), decoded_(decode()) {}
+
+GpgKey::GpgKey(QSharedPointer<struct _gpgme_key> display_ref,
+               std::function<gpgme_key_t()> fetch_key)
+    : key_ref_(std::move(display_ref)),
+      real_key_(QSharedPointer<RealKey>::create()),
+      decoded_(decode()) {
+  real_key_->fetch_key = std::move(fetch_key);
+}
+
+auto GpgKey::decode() const -> QSharedPointer<const DecodedKey> {
+  auto decoded = QSharedPointer<DecodedKey>::create();
+  if (key_ref_ == nullptr) return decoded;
+
+  for (auto *next = key_ref_->subkeys; next != nullptr; next = next->next) {
+    const auto s_key = GpgSubKey(key_ref_, next);
+    decoded->sub_keys.push_back(s_key);
+
+    if (s_key.IsCardKey()) decoded->flags |= DecodedKey::kCARD_KEY;
+
+    if (s_key.IsDisabled() || s_key.IsRevoked() || s_key.IsExpired()) {
+      continue;
+    }
+
+    if (s_key.IsHasEncrCap()) decoded->flags |= DecodedKey::kACTUAL_ENCR;
+    if (!s_key.IsSecretKey()) continue;
+    if (s_key.IsHasSignCap()) decoded->flags |= DecodedKey::kACTUAL_SIGN;
+    if (s_key.IsHasAuthCap()) decoded->flags |= DecodedKey::kACTUAL_AUTH;
+  }
+
+  for (auto *next = key_ref_->uids; next != nullptr; next = next->next) {
+    decoded->uids.push_back(GpgUID(key_ref_, next));
+  }
+
+  return decoded;
+}
+
+GpgKey::operator gpgme_key_t() const {
+  if (real_key_ == nullptr) return key_ref_.get();
+
+  std::lock_guard<std::mutex> lock(real_key_->mutex);
+  if (!real_key_->fetched) {
+    auto* key = real_key_->fetch_key();
+    if (key == nullptr) {
+      // tried again on the next use
+      LOG_W() << "cannot fetch the real key of a display-only key:"
+              << key_ref_->fpr;
+      return nullptr;
+    }
+
+    real_key_->key_ref = QSharedPointer<struct _gpgme_key>(
+        key, [](struct _gpgme_key *ptr) { gpgme_key_unref(ptr); });
+    real_key_->fetched = true;
+  }
+  return real_key_->key_ref.get();
+}
 
-GpgKey::operator gpgme_key_t() const { return key_ref_.get(); }
+auto GpgKey::IsDisplayOnly() const -> bool { return real_key_ != nullptr; }
+
+auto GpgKey::DisplayData() const -> const struct _gpgme_key * {
+  return key_ref_.get();
+}
 
 GpgKey::GpgKey(const GpgKey &) = default;
 
@@ -104,12 +191,7 @@ auto GpgKey::PublicKeyAlgo() const -> QString {
   return gpgme_pubkey_algo_name(key_ref_->subkeys->pubkey_algo);
 }
 
-auto GpgKey::Algo() const -> QString {
-  auto *buffer = gpgme_pubkey_algo_string(key_ref_->subkeys);
-  auto algo = QString(buffer);
-  gpgme_free(buffer);
-  return algo.toUpper();
-}
+auto GpgKey::Algo() const -> QString { return PrimaryKey().Algo(); }
 
 auto GpgKey::LastUpdateTime() const -> QDateTime {
   return QDateTime::fromSecsSinceEpoch(
@@ -137,10 +219,7 @@ auto GpgKey::IsHasCertCap() const -> bool { return IsHasActualCertCap(); }
 auto GpgKey::IsHasAuthCap() const -> bool { return IsHasActualAuthCap(); }
 
 auto GpgKey::IsHasCardKey() const -> bool {
-  auto sub_keys = SubKeys();
-  return std::any_of(
-      sub_keys.begin(), sub_keys.end(),
-      [](const GpgSubKey &subkey) -> bool { return subkey.IsCardKey(); });
+  return decoded_->Has(DecodedKey::kCARD_KEY);
 }
 
 auto GpgKey::IsPrivateKey() const -> bool { return key_ref_->secret; }
@@ -156,41 +235,17 @@ auto GpgKey::IsHasMasterKey() const -> bool {
 }
 
 auto GpgKey::SubKeys() const -> QContainer<GpgSubKey> {
-  QContainer<GpgSubKey> ret;
-  auto *next = key_ref_->subkeys;
-  while (next != nullptr) {
-    ret.push_back(GpgSubKey(key_ref_, next));
-    next = next->next;
-  }
-  return ret;
+  return decoded_->sub_keys;
 }
 
-auto GpgKey::UIDs() const -> QContainer<GpgUID> {
-  QContainer<GpgUID> uids;
-  auto *next = key_ref_->uids;
-  while (next != nullptr) {
-    uids.push_back(GpgUID(key_ref_, next));
-    next = next->next;
-  }
-  return uids;
-}
+auto GpgKey::UIDs() const -> QContainer<GpgUID> { return decoded_->uids; }
 
 auto GpgKey::IsHasActualSignCap() const -> bool {
-  auto s_keys = SubKeys();
-  return std::any_of(
-      s_keys.begin(), s_keys.end(), [](const GpgSubKey &s_key) -> bool {
-        return s_key.IsSecretKey() && s_key.IsHasSignCap() &&
-               !s_key.IsDisabled() && !s_key.IsRevoked() && !s_key.IsExpired();
-      });
+  return decoded_->Has(DecodedKey::kACTUAL_SIGN);
 }
 
 auto GpgKey::IsHasActualAuthCap() const -> bool {
-  auto s_keys = SubKeys();
-  return std::any_of(
-      s_keys.begin(), s_keys.end(), [](const GpgSubKey &s_key) -> bool {
-        return s_key.IsSecretKey() && s_key.IsHasAuthCap() &&
-               !s_key.IsDisabled() && !s_key.IsRevoked() && !s_key.IsExpired();
-      });
+  return decoded_->Has(DecodedKey::kACTUAL_AUTH);
 }
 
 /**
@@ -208,16 +263,12 @@ auto GpgKey::IsHasActualCertCap() const -> bool {
  * @return if key encrypt
  */
 auto GpgKey::IsHasActualEncrCap() const -> bool {
-  auto s_keys = SubKeys();
-  return std::any_of(s_keys.begin(), s_keys.end(),
-                     [](const GpgSubKey &s_key) -> bool {
-                       return s_key.IsHasEncrCap() && !s_key.IsDisabled() &&
-                              !s_key.IsRevoked() && !s_key.IsExpired();
-                     });
+  return decoded_->Has(DecodedKey::kACTUAL_ENCR);
 }
 
 auto GpgKey::PrimaryKey() const -> GpgSubKey {
-  return GpgSubKey(key_ref_, key_ref_->subkeys);
+  if (decoded_->sub_keys.isEmpty()) return {};
+  return decoded_->sub_keys.front();
 }
 
 auto GpgKey::KeyType() const -> GpgAbstractKeyType {
@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "core/model/GpgAbstractKey.h"
 #include "core/model/GpgSubKey.h"
 #include "core/model/GpgUID.h"
@@ -60,6 +62,17 @@ class GF_CORE_EXPORT GpgKey : public GpgAbstractKey {
    */
   explicit GpgKey(QSharedPointer<struct _gpgme_key> key_ref);
 
+  /**
+   * @brief Construct a display-only Gpg Key object, the fields are read
+   * from display_ref but gpgme never sees it. The real key is fetched
+   * once, the first time the key is handed to an operation.
+   *
+   * @param display_ref fields to show, not a key listed by gpgme
+   * @param fetch_key returns a referenced key or nullptr if it is gone
+   */
+  GpgKey(QSharedPointer<struct _gpgme_key> display_ref,
+         std::function<gpgme_key_t()> fetch_key);
+
   /**
    * @brief Construct a new Gpg Key object
    *
@@ -82,13 +95,28 @@ class GF_CORE_EXPORT GpgKey : public GpgAbstractKey {
   auto operator=(const GpgKey&) -> GpgKey&;
 
   /**
-   * @brief
+   * @brief the key to hand to gpgme, a display-only key fetches the
+   * real one here
    *
-   * @return gpgme_key_t
+   * @return gpgme_key_t nullptr if a display-only key no longer exists
    */
   // NOLINTNEXTLINE(google-explicit-constructor)
   operator gpgme_key_t() const;
 
+  /**
+   * @brief
+   *
+   * @return true if the key was built from display data only
+   */
+  [[nodiscard]] auto IsDisplayOnly() const -> bool;
+
+  /**
+   * @brief the fields this key shows, never pass them to gpgme
+   *
+   * @return const struct _gpgme_key*
+   */
+  [[nodiscard]] auto DisplayData() const -> const struct _gpgme_key*;
+
   /**
    * @brief
    *
@@ -338,7 +366,30 @@ class GF_CORE_EXPORT GpgKey : public GpgAbstractKey {
   [[nodiscard]] auto PrimaryKey() const -> GpgSubKey;
 
  private:
+  struct DecodedKey;
+  struct RealKey;
+
   QSharedPointer<struct _gpgme_key> key_ref_ = nullptr;  ///<
+
+  /**
+   * @brief the real key behind a display-only key, shared by all copies
+   *
+   */
+  QSharedPointer<RealKey> real_key_;
+
+  /**
+   * @brief the subkeys, uids and capabilities decoded from the gpgme
+   * linked lists, built once per key and shared by all copies.
+   *
+   */
+  QSharedPointer<const DecodedKey> decoded_;
+
+  /**
+   * @brief
+   *
+   * @return QSharedPointer<const DecodedKey>
+   */
+  [[nodiscard]] auto decode() const -> QSharedPointer<const DecodedKey>;
 };
 
 }  // namespace GpgFrontend
@@ -29,7 +29,10 @@
 #include "GpgKeyTableModel.h"
 
 #include <QColor>
+#include <algorithm>
 
+#include "core/function/CoreSignalStation.h"
+#include "core/function/gpg/GpgKeyGetter.h"
 #include "core/model/GpgKey.h"
 #include "core/model/GpgKeyGroup.h"
 #include "core/utils/GpgUtils.h"
@@ -48,6 +51,12 @@ GpgKeyTableModel::GpgKeyTableModel(int channel,
   for (const auto &key : keys) {
     cached_items_.push_back(GpgKeyTableItem(key));
   }
+  RebuildSearchIndex();
+  rebuild_row_index();
+
+  connect(CoreSignalStation::GetInstance(),
+          &CoreSignalStation::SignalKeysChanged, this,
+          &GpgKeyTableModel::slot_update_keys);
 }
 
 auto GpgKeyTableModel::index(int row, int column,
@@ -306,6 +315,98 @@ auto GpgKeyTableModel::GetGpgContextChannel() const -> int {
   return gpg_context_channel_;
 }
 
+auto GpgKeyTableModel::IsRowMatchKeywords(int row,
+                                          const QString &folded_keywords) const
+    -> bool {
+  if (row < 0 || row >= search_index_.size()) return false;
+  return search_index_[row].contains(folded_keywords);
+}
+
+void GpgKeyTableModel::RebuildSearchIndex() {
+  search_index_.clear();
+  search_index_.reserve(cached_items_.size());
+  for (int row = 0; row < static_cast<int>(cached_items_.size()); ++row) {
+    search_index_.push_back(search_text_by_row(row));
+  }
+}
+
+void GpgKeyTableModel::rebuild_row_index() {
+  row_by_fpr_.clear();
+  row_by_fpr_.reserve(cached_items_.size());
+  for (int row = 0; row < static_cast<int>(cached_items_.size()); ++row) {
+    const auto *key = cached_items_[row].Key();
+    if (key->KeyType() != GpgAbstractKeyType::kGPG_KEY) continue;
+    row_by_fpr_.insert(key->Fingerprint(), row);
+  }
+}
+
+auto GpgKeyTableModel::search_text_by_row(int row) const -> QString {
+  QStringList infos;
+  for (int column = 0; column < columnCount({}); ++column) {
+    infos << data(index(row, column, {}), Qt::DisplayRole).toString();
+  }
+
+  auto *key = cached_items_[row].Key();
+  if (key->KeyType() == GpgAbstractKeyType::kGPG_KEY) {
+    for (const auto &uid : dynamic_cast<GpgKey *>(key)->UIDs()) {
+      infos << uid.GetUID();
+    }
+  }
+
+  // fields are separated so that a keyword never matches across two of them
+  return infos.join('\n').toCaseFolded();
+}
+
+void GpgKeyTableModel::slot_update_keys(int channel, const QStringList &fprs) {
+  if (channel != gpg_context_channel_) return;
+
+  auto &getter = GpgKeyGetter::GetInstance(channel);
+  QContainer<int> removed_rows;
+  for (const auto &fpr : fprs) {
+    auto key = getter.GetKeyORSubkeyPtr(fpr);
+    if (key != nullptr && key->KeyType() != GpgAbstractKeyType::kGPG_KEY) {
+      key = nullptr;
+    }
+
+    const int row = row_by_fpr_.value(fpr, -1);
+    if (row < 0 && key == nullptr) continue;
+
+    if (row < 0) {
+      const auto new_row = static_cast<int>(cached_items_.size());
+      beginInsertRows({}, new_row, new_row);
+      cached_items_.push_back(GpgKeyTableItem(key));
+      search_index_.push_back(search_text_by_row(new_row));
+      row_by_fpr_.insert(fpr, new_row);
+      endInsertRows();
+      continue;
+    }
+
+    if (key == nullptr) {
+      // removed at the end, so the rows of the other keys stay valid
+      row_by_fpr_.remove(fpr);
+      removed_rows.push_back(row);
+      continue;
+    }
+
+    auto item = GpgKeyTableItem(key);
+    item.SetChecked(cached_items_[row].Checked());
+    cached_items_[row] = item;
+    search_index_[row] = search_text_by_row(row);
+    emit dataChanged(index(row, 0, {}), index(row, columnCount({}) - 1, {}));
+  }
+
+  if (removed_rows.isEmpty()) return;
+
+  std::sort(removed_rows.begin(), removed_rows.end(), std::greater<>());
+  for (const auto row : removed_rows) {
+    beginRemoveRows({}, row, row);
+    cached_items_.removeAt(row);
+    search_index_.removeAt(row);
+    endRemoveRows();
+  }
+  rebuild_row_index();
+}
+
 GpgKeyTableItem::GpgKeyTableItem(GpgAbstractKeyPtr key)
     : key_(std::move(key)) {}
 
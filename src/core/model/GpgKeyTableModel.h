@@ -250,6 +250,35 @@ class GF_CORE_EXPORT GpgKeyTableModel : public QAbstractTableModel {
    */
   [[nodiscard]] auto GetGpgContextChannel() const -> int;
 
+  /**
+   * @brief check whether the row contains the keywords in any of its
+   * columns or uids. the keywords must already be case folded.
+   *
+   * @param row
+   * @param folded_keywords
+   * @return bool
+   */
+  [[nodiscard]] auto IsRowMatchKeywords(int row,
+                                        const QString &folded_keywords) const
+      -> bool;
+
+  /**
+   * @brief rebuild the per row search index, needed only when the keys
+   * held by this model are changed in place.
+   *
+   */
+  void RebuildSearchIndex();
+
+ private slots:
+
+  /**
+   * @brief patch the rows of the changed keys in place
+   *
+   * @param channel
+   * @param fprs
+   */
+  void slot_update_keys(int channel, const QStringList &fprs);
+
  private:
   QStringList column_headers_;
   int gpg_context_channel_;
@@ -263,7 +292,17 @@ class GF_CORE_EXPORT GpgKeyTableModel : public QAbstractTableModel {
   static auto table_data_by_gpg_key_group(const QModelIndex &index,
                                           const GpgKeyGroup *kg) -> QVariant;
 
+  auto search_text_by_row(int row) const -> QString;
+
+  /**
+   * @brief map the fingerprint of every key row to its row
+   *
+   */
+  void rebuild_row_index();
+
   QContainer<GpgKeyTableItem> cached_items_;
+  QContainer<QString> search_index_;  ///< case folded text of each row
+  QHash<QString, int> row_by_fpr_;    ///< key rows only, no groups
 };
 
 }  // namespace GpgFrontend
\ No newline at end of file
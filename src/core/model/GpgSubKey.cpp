@@ -27,14 +27,48 @@
  */
 #include "GpgSubKey.h"
 
+#include <mutex>
+
 #include "core/model/GpgKey.h"
 namespace GpgFrontend {
 
+namespace {
+
+/**
+ * @brief gpgme_pubkey_algo_string() allocates on every call although a
+ * keyring only contains a handful of distinct algorithms, so the upper
+ * cased result is interned by (algo, length, curve).
+ *
+ * @param s_key
+ * @return QString
+ */
+auto InternAlgoString(gpgme_subkey_t s_key) -> QString {
+  static std::mutex lock;
+  static QHash<QByteArray, QString> table;
+
+  auto id = QByteArray::number(static_cast<int>(s_key->pubkey_algo)) + ':' +
+            QByteArray::number(s_key->length) + ':' +
+            QByteArray(s_key->curve != nullptr ? s_key->curve : "");
+
+  std::lock_guard<std::mutex> guard(lock);
+  auto it = table.constFind(id);
+  if (it != table.constEnd()) return it.value();
+
+  auto* buffer = gpgme_pubkey_algo_string(s_key);
+  auto algo = QString(buffer).toUpper();
+  gpgme_free(buffer);
+  return table.insert(id, algo).value();
+}
+
+}  // namespace
+
 GpgSubKey::GpgSubKey() = default;
 
 GpgSubKey::GpgSubKey(QSharedPointer<struct _gpgme_key> key_ref,
                      gpgme_subkey_t s_key)
-    : key_ref_(std::move(key_ref)), s_key_ref_(s_key) {}
+    : key_ref_(std::move(key_ref)),
+      s_key_ref_(s_key),
+      algo_(s_key != nullptr ? InternAlgoString(s_key) : QString{}) {}
 
 GpgSubKey::GpgSubKey(const GpgSubKey&) = default;
 
@@ -50,12 +84,7 @@ auto GpgSubKey::PublicKeyAlgo() const -> QString {
   return gpgme_pubkey_algo_name(s_key_ref_->pubkey_algo);
 }
 
-auto GpgSubKey::Algo() const -> QString {
-  auto* buffer = gpgme_pubkey_algo_string(s_key_ref_);
-  auto algo = QString(buffer);
-  gpgme_free(buffer);
-  return algo.toUpper();
-}
+auto GpgSubKey::Algo() const -> QString { return algo_; }
 
 auto GpgSubKey::KeyLength() const -> unsigned int { return s_key_ref_->length; }
 
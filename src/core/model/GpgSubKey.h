@@ -266,6 +266,7 @@ class GF_CORE_EXPORT GpgSubKey : public GpgAbstractKey {
  private:
   QSharedPointer<struct _gpgme_key> key_ref_;
   gpgme_subkey_t s_key_ref_ = nullptr;  ///<
+  QString algo_;  ///< interned, shared by all subkeys with the same algo
 };
 
 }  // namespace GpgFrontend
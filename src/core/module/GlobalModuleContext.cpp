@@ -28,6 +28,7 @@
 
 #include "GlobalModuleContext.h"
 
+#include <mutex>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
@@ -49,6 +50,11 @@ class GlobalModuleContext::Impl {
     acquired_channel_.insert(kGpgFrontendNonAsciiChannel);
   }
 
+  ~Impl() {
+    // pending drain tasks hold the runners, stop them before they go away
+    for (const auto& runner : module_runners_) runner->Stop();
+  }
+
   auto SearchModule(ModuleIdentifier module_id) -> ModulePtr {
     // Search for the module in the register table.
     auto module_info_opt = search_module_register_table(module_id);
@@ -80,15 +86,29 @@ class GlobalModuleContext::Impl {
     return kGpgFrontendDefaultChannel;
   }
 
-  auto GetTaskRunner(ModuleRawPtr /*module*/) -> std::optional<TaskRunnerPtr> {
-    return Thread::TaskRunnerGetter::GetInstance().GetTaskRunner(
-        Thread::TaskRunnerGetter::kTaskRunnerType_Module);
+  auto GetTaskRunner(ModuleRawPtr module) -> std::optional<TaskRunnerPtr> {
+    if (module == nullptr) return std::nullopt;
+    return GetTaskRunner(module->GetModuleIdentifier());
   }
 
-  auto GetTaskRunner(ModuleIdentifier /*module_id*/)
+  auto GetTaskRunner(const ModuleIdentifier& module_id)
       -> std::optional<TaskRunnerPtr> {
-    return Thread::TaskRunnerGetter::GetInstance().GetTaskRunner(
-        Thread::TaskRunnerGetter::kTaskRunnerType_Module);
+    // a module may ask for its runner before it is registered
+    auto queue = search_module_queue(module_id);
+    if (queue == nullptr) {
+      return Thread::TaskRunnerGetter::GetInstance().GetTaskRunner(
+          Thread::TaskRunnerGetter::kTaskRunnerType_Module);
+    }
+    return queue->runner;
+  }
+
+  auto GetModuleExecStatistics(const ModuleIdentifier& module_id)
+      -> ModuleExecStatistics {
+    auto queue = search_module_queue(module_id);
+    if (queue == nullptr) return {};
+
+    std::lock_guard<std::mutex> lock(queue->lock);
+    return queue->stats;
   }
 
   auto GetGlobalTaskRunner() -> std::optional<TaskRunnerPtr> {
@@ -117,9 +137,8 @@ class GlobalModuleContext::Impl {
     // move module to its task runner' thread
     register_info->module->setParent(nullptr);
     register_info->module->moveToThread(
-        Thread::TaskRunnerGetter::GetInstance()
-            .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_Module)
-            ->GetThread());
+        acquire_module_queue(module->GetModuleIdentifier())
+            ->runner->GetThread());
 
     // register the module with its identifier.
     module_register_table_[module->GetModuleIdentifier()] = register_info;
@@ -272,26 +291,41 @@ class GlobalModuleContext::Impl {
       // Check if the module is activated
       if (!module_info->activate) continue;
 
-      Thread::Task::TaskRunnable const exec_runnerable =
-          [module, event](DataObjectPtr) -> int { return module->Exec(event); };
-
-      Thread::Task::TaskCallback const exec_callback =
-          [listener_module_id, event_id](int code, DataObjectPtr) {
-            if (code < 0) {
-              // Log an error if the module execution fails
-              LOG_W() << "module " << listener_module_id
-                      << "execution failed of event " << event_id
-                      << ": exec return code: " << code;
-            }
-          };
-
-      Thread::TaskRunnerGetter::GetInstance()
-          .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_Module)
-          ->PostTask(new Thread::Task(exec_runnerable,
-                                      QString("event/%1/module/exec/%2")
-                                          .arg(event_id)
-                                          .arg(listener_module_id),
-                                      nullptr, exec_callback));
+      // every module has its own queue, a slow module only delays itself
+      auto queue = search_module_queue(listener_module_id);
+      if (queue == nullptr) continue;
+
+      QElapsedTimer posted;
+      posted.start();
+
+      ModuleJob job = [module, event, queue, posted, listener_module_id,
+                       event_id]() {
+        const auto wait_us = posted.nsecsElapsed() / 1000;
+
+        QElapsedTimer timer;
+        timer.start();
+        const auto ret = module->Exec(event);
+        const auto latency_us = timer.nsecsElapsed() / 1000;
+
+        if (ret < 0) {
+          // Log an error if the module execution fails
+          LOG_W() << "module " << listener_module_id
+                  << "execution failed of event " << event_id
+                  << ": exec return code: " << ret;
+        }
+
+        std::lock_guard<std::mutex> lock(queue->lock);
+        auto& stats = queue->stats;
+        stats.queue_depth--;
+        stats.executed++;
+        if (ret < 0) stats.failed++;
+        stats.last_latency_us = latency_us;
+        stats.max_latency_us = std::max(stats.max_latency_us, latency_us);
+        stats.total_latency_us += latency_us;
+        stats.max_wait_us = std::max(stats.max_wait_us, wait_us);
+      };
+
+      enqueue_module_job(queue, std::move(job));
     }
 
     // Return true to indicate successful execution of all modules
@@ -355,6 +389,18 @@ class GlobalModuleContext::Impl {
 
   using ModuleRegisterInfoPtr = QSharedPointer<ModuleRegisterInfo>;
 
+  using ModuleJob = std::function<void()>;
+
+  struct ModuleQueue {
+    TaskRunnerPtr runner;  ///< the thread the module object lives on
+    std::mutex lock;
+    QQueue<ModuleJob> jobs;
+    bool draining = false;  ///< a runner of the pool owns the queue
+    ModuleExecStatistics stats;
+  };
+
+  using ModuleQueuePtr = QSharedPointer<ModuleQueue>;
+
   std::unordered_map<ModuleIdentifier, ModuleRegisterInfoPtr>
       module_register_table_;
   std::map<EventIdentifier, std::unordered_set<ModuleIdentifier>>
@@ -366,6 +412,126 @@ class GlobalModuleContext::Impl {
   TaskRunnerPtr default_task_runner_;
   int registered_modules_ = 0;
 
+  std::mutex module_queues_lock_;
+  std::unordered_map<ModuleIdentifier, ModuleQueuePtr> module_queues_;
+  QContainer<TaskRunnerPtr> module_runners_;
+  int next_module_runner_ = 0;
+
+  static constexpr int kMaxModuleRunners = 4;
+
+  /**
+   * @brief the execution queue of the module, created when the module is
+   * registered. the module object lives on one runner of a bounded pool,
+   * its events are run by whichever runner of the pool is free.
+   *
+   * @param module_id
+   * @return ModuleQueuePtr
+   */
+  auto acquire_module_queue(const ModuleIdentifier& module_id)
+      -> ModuleQueuePtr {
+    std::lock_guard<std::mutex> lock(module_queues_lock_);
+
+    auto it = module_queues_.find(module_id);
+    if (it != module_queues_.end()) return it->second;
+
+    // the whole pool is needed once the first module can receive events
+    while (module_runners_.size() < kMaxModuleRunners) {
+      auto runner = SecureCreateSharedObject<Thread::TaskRunner>();
+      runner->GetThread()->setObjectName(
+          QString("module/%1").arg(module_runners_.size()));
+      runner->Start();
+      module_runners_.push_back(runner);
+    }
+
+    auto queue = SecureCreateSharedObject<ModuleQueue>();
+    queue->runner = module_runners_[next_module_runner_];
+    next_module_runner_ = (next_module_runner_ + 1) % kMaxModuleRunners;
+
+    module_queues_.emplace(module_id, queue);
+    return queue;
+  }
+
+  /**
+   * @brief append the job to the queue of the module, and hand the queue
+   * to the pool unless a runner is draining it already.
+   *
+   * @param queue
+   * @param job
+   */
+  void enqueue_module_job(const ModuleQueuePtr& queue, ModuleJob job) {
+    {
+      std::lock_guard<std::mutex> lock(queue->lock);
+      queue->stats.queue_depth++;
+      queue->jobs.enqueue(std::move(job));
+      if (queue->draining) return;
+      queue->draining = true;
+    }
+
+    QContainer<TaskRunnerPtr> runners;
+    {
+      std::lock_guard<std::mutex> lock(module_queues_lock_);
+      runners = module_runners_;
+    }
+    drain_module_queue(queue, runners);
+  }
+
+  /**
+   * @brief run the next job of the queue on the least busy runner. only
+   * one job is run per task, so the following one goes to whichever runner
+   * is free by then, and the jobs of a module never run at the same time.
+   *
+   * @param queue
+   * @param runners
+   */
+  static void drain_module_queue(const ModuleQueuePtr& queue,
+                                 const QContainer<TaskRunnerPtr>& runners) {
+    auto target = runners.front();
+    for (const auto& runner : runners) {
+      if (runner->GetPendingTaskCount() < target->GetPendingTaskCount()) {
+        target = runner;
+      }
+    }
+
+    Thread::Task::TaskRunnable const drain_runnable =
+        [queue, runners](DataObjectPtr) -> int {
+      ModuleJob job;
+      {
+        std::lock_guard<std::mutex> lock(queue->lock);
+        job = queue->jobs.dequeue();
+      }
+
+      job();
+
+      {
+        std::lock_guard<std::mutex> lock(queue->lock);
+        if (queue->jobs.isEmpty()) {
+          queue->draining = false;
+          return 0;
+        }
+      }
+      drain_module_queue(queue, runners);
+      return 0;
+    };
+
+    target->PostTask(new Thread::Task(drain_runnable, "module/queue/drain"));
+  }
+
+  /**
+   * @brief the execution queue of a registered module, safe to call from
+   * any thread.
+   *
+   * @param module_id
+   * @return ModuleQueuePtr nullptr if the module is unknown
+   */
+  auto search_module_queue(const ModuleIdentifier& module_id)
+      -> ModuleQueuePtr {
+    std::lock_guard<std::mutex> lock(module_queues_lock_);
+
+    auto it = module_queues_.find(module_id);
+    if (it == module_queues_.end()) return nullptr;
+    return it->second;
+  }
+
   auto acquire_new_unique_channel() -> int {
     int random_channel = QRandomGenerator::global()->bounded(65535);
     // Ensure the acquired channel is unique.
@@ -475,4 +641,9 @@ auto GlobalModuleContext::GetRegisteredModuleNum() const -> int {
   return p_->GetRegisteredModuleNum();
 }
 
+auto GlobalModuleContext::GetModuleExecStatistics(ModuleIdentifier module_id)
+    -> ModuleExecStatistics {
+  return p_->GetModuleExecStatistics(module_id);
+}
+
 }  // namespace GpgFrontend::Module
@@ -51,6 +51,21 @@ using GRTPtr = QSharedPointer<GlobalRegisterTable>;
 
 using TaskRunnerPtr = QSharedPointer<Thread::TaskRunner>;
 
+/**
+ * @brief execution statistics of the event queue of a module, latencies in
+ * microseconds
+ *
+ */
+struct ModuleExecStatistics {
+  int queue_depth = 0;          ///< events waiting or running
+  quint64 executed = 0;         ///<
+  quint64 failed = 0;           ///< exec returned a negative code
+  qint64 last_latency_us = 0;   ///<
+  qint64 max_latency_us = 0;    ///<
+  qint64 total_latency_us = 0;  ///< divided by executed gives the average
+  qint64 max_wait_us = 0;       ///< from triggering to the start of exec
+};
+
 class GF_CORE_EXPORT GlobalModuleContext : public QObject {
   Q_OBJECT
  public:
@@ -92,6 +107,13 @@ class GF_CORE_EXPORT GlobalModuleContext : public QObject {
 
   [[nodiscard]] auto GetRegisteredModuleNum() const -> int;
 
+  /**
+   * @brief statistics of the execution queue of the module
+   *
+   * @return ModuleExecStatistics
+   */
+  auto GetModuleExecStatistics(ModuleIdentifier) -> ModuleExecStatistics;
+
  private:
   class Impl;
   SecureUniquePtr<Impl> p_;
@@ -29,6 +29,7 @@
 #include "GlobalRegisterTable.h"
 
 #include <any>
+#include <mutex>
 #include <optional>
 #include <shared_mutex>
 #include <vector>
@@ -49,6 +50,7 @@ class GlobalRegisterTable::Impl {
     std::optional<std::any> value = std::nullopt;
     QMap<QString, QSharedPointer<RTNode>> children;
     QWeakPointer<RTNode> parent;
+    std::shared_ptr<RTSlot> slot = std::make_shared<RTSlot>();
 
     explicit RTNode(QString name, const QSharedPointer<RTNode>& parent)
         : name(std::move(name)), parent(parent) {}
@@ -61,89 +63,254 @@ class GlobalRegisterTable::Impl {
         root_node_(SecureCreateSharedObject<RTNode>("", nullptr)) {}
 
   auto PublishKV(const Namespace& n, const Key& k, std::any v) -> bool {
-    QStringList const segments = (n + "." + k).split('.');
-    int version = 0;
+    return PublishKVs(n, {{k, std::move(v)}});
+  }
 
+  auto PublishKVs(const Namespace& n, const KVList& kvs) -> bool {
+    if (kvs.isEmpty()) return true;
+
+    QContainer<int> versions;
     {
       std::unique_lock lock(lock_);
-
-      auto current = root_node_;
-      for (const QString& segment : segments) {
-        auto it = current->children.find(segment);
-        if (it == current->children.end()) {
-          it = current->children.insert(
-              segment, SecureCreateSharedObject<RTNode>(segment, current));
-        }
-        current = it.value();
+      for (const auto& kv : kvs) {
+        versions.push_back(upsert_node(n, kv.first, kv.second));
       }
+    }
 
-      current->name = segments.back();
-      current->type = tr("LEAF");
-      current->value = v;
-      current->value_type = &v.type();
-      version = ++current->version;
+    QContainer<QContainer<Subscription>> matched;
+    {
+      std::lock_guard<std::mutex> lock(subs_lock_);
+      for (const auto& kv : kvs) {
+        matched.push_back(match_subscriptions(n + "." + kv.first));
+      }
     }
 
-    emit parent_->SignalPublish(n, k, version, v);
+    for (int i = 0; i < kvs.size(); i++) {
+      const auto& kv = kvs[i];
+      for (const auto& sub : matched[i]) {
+        dispatch(sub, n, kv.first, versions[i], kv.second);
+      }
+      emit parent_->SignalPublish(n, kv.first, versions[i], kv.second);
+    }
     return true;
   }
 
   auto LookupKV(const Namespace& n, const Key& k) -> std::optional<std::any> {
-    QStringList const segments = (n + "." + k).split('.');
+    std::shared_ptr<RTSlot> slot;
+    {
+      std::shared_lock const lock(lock_);
+
+      auto it = path_index_.constFind(n + "." + k);
+      if (it == path_index_.constEnd()) return std::nullopt;
+      slot = it.value()->slot;
+    }
 
-    std::optional<std::any> rtn = std::nullopt;
+    auto value = std::atomic_load(&slot->value);
+    if (value == nullptr) return std::nullopt;
+    return *value;
+  }
+
+  auto InternPath(const Namespace& n, const Key& k)
+      -> std::shared_ptr<RTSlot> {
+    const auto path = n + "." + k;
     {
       std::shared_lock const lock(lock_);
 
-      auto current = root_node_;
-      for (const QString& segment : segments) {
-        auto it = current->children.find(segment);
-        if (it == current->children.end()) return std::nullopt;
-        current = it.value();
-      }
-      rtn = current->value;
+      auto it = path_index_.constFind(path);
+      if (it != path_index_.constEnd()) return it.value()->slot;
     }
-    return rtn;
+
+    std::unique_lock const lock(lock_);
+    return find_or_create_node(path)->slot;
   }
 
   auto ListChildKeys(const Namespace& n, const Key& k) -> QContainer<Key> {
-    QStringList const segments = (n + "." + k).split('.');
-
     QContainer<Key> rtn;
     {
       std::shared_lock lock(lock_);
 
-      auto current = root_node_;
-      for (const QString& segment : segments) {
-        auto it = current->children.find(segment);
-        if (it == current->children.end()) return {};
-        current = it.value();
-      }
+      auto it = path_index_.constFind(n + "." + k);
+      if (it == path_index_.constEnd()) return {};
 
-      for (auto& key : current->children.keys()) rtn.push_back(key);
+      for (auto& key : it.value()->children.keys()) rtn.push_back(key);
     }
     return rtn;
   }
 
   auto ListenPublish(QObject* o, const Namespace& n, const Key& k,
-                     LPCallback c) -> bool {
-    if (o == nullptr) return false;
-    return QObject::connect(parent_, &GlobalRegisterTable::SignalPublish, o,
-                            [n, k, c](const Namespace& pn, const Key& pk,
-                                      int ver, std::any value) {
-                              if (pn == n && pk == k) {
-                                c(pn, pk, ver, std::move(value));
-                              }
-                            }) == nullptr;
+                     LPCallback c, bool prefix) -> bool {
+    if (o == nullptr || c == nullptr) return false;
+
+    const auto path = k.isEmpty() ? n : n + "." + k;
+
+    Subscription sub;
+    sub.receiver = QSharedPointer<Receiver>::create();
+    sub.receiver->object = o;
+    sub.callback = std::move(c);
+    {
+      std::lock_guard<std::mutex> lock(subs_lock_);
+      sub.id = ++last_sub_id_;
+      (prefix ? prefix_subs_ : exact_subs_)[path].push_back(sub);
+    }
+
+    // runs directly in the thread destroying the receiver, publishers never
+    // get hold of a receiver which is being torn down
+    QObject::connect(o, &QObject::destroyed, [receiver = sub.receiver]() {
+      std::lock_guard<std::mutex> lock(receiver->mutex);
+      receiver->object = nullptr;
+    });
+
+    // drop the subscription together with its receiver
+    QObject::connect(o, &QObject::destroyed, parent_,
+                     [this, id = sub.id, path, prefix]() {
+                       std::lock_guard<std::mutex> lock(subs_lock_);
+                       auto& index = prefix ? prefix_subs_ : exact_subs_;
+                       auto it = index.find(path);
+                       if (it == index.end()) return;
+
+                       auto& subs = it.value();
+                       for (int i = 0; i < subs.size(); i++) {
+                         if (subs[i].id != id) continue;
+                         subs.removeAt(i);
+                         break;
+                       }
+                       if (subs.isEmpty()) index.erase(it);
+                     });
+    return true;
   }
 
   auto RootRTNode() -> RTNodePtr { return root_node_; }
 
  private:
+  /**
+   * @brief the receiver of a subscription, cleared under the lock as soon
+   * as it starts being destroyed.
+   *
+   */
+  struct Receiver {
+    std::mutex mutex;
+    QObject* object = nullptr;
+  };
+
+  struct Subscription {
+    quint64 id = 0;
+    QSharedPointer<Receiver> receiver;
+    LPCallback callback;
+  };
+
   std::shared_mutex lock_;
   GlobalRegisterTable* parent_;
 
   RTNodePtr root_node_;
+  QHash<QString, RTNodePtr> path_index_;  ///< every node by its full path
+
+  std::mutex subs_lock_;
+  quint64 last_sub_id_ = 0;
+  QHash<QString, QContainer<Subscription>> exact_subs_;   ///< by full path
+  QHash<QString, QContainer<Subscription>> prefix_subs_;  ///< by path prefix
+
+  /**
+   * @brief insert or update the leaf, the caller holds the write lock
+   *
+   * @return int new version of the leaf
+   */
+  auto upsert_node(const Namespace& n, const Key& k, const std::any& v)
+      -> int {
+    auto node = find_or_create_node(n + "." + k);
+
+    node->type = tr("LEAF");
+    node->value = v;
+    node->value_type = &v.type();
+    std::atomic_store(&node->slot->value,
+                      std::shared_ptr<const std::any>(
+                          std::make_shared<std::any>(v)));
+    return ++node->version;
+  }
+
+  /**
+   * @brief the node of the path, the trie is only walked when the path is
+   * seen for the first time. the caller holds the write lock.
+   *
+   * @param path
+   * @return RTNodePtr
+   */
+  auto find_or_create_node(const QString& path) -> RTNodePtr {
+    auto indexed = path_index_.constFind(path);
+    if (indexed != path_index_.constEnd()) return indexed.value();
+
+    auto current = root_node_;
+    qsizetype begin = 0;
+    while (true) {
+      const auto end = path.indexOf('.', begin);
+      const auto segment = path.mid(begin, end < 0 ? -1 : end - begin);
+
+      auto it = current->children.find(segment);
+      if (it == current->children.end()) {
+        it = current->children.insert(
+            segment, SecureCreateSharedObject<RTNode>(segment, current));
+        path_index_.insert(end < 0 ? path : path.left(end), it.value());
+      }
+      current = it.value();
+
+      if (end < 0) break;
+      begin = end + 1;
+    }
+    return current;
+  }
+
+  /**
+   * @brief listeners of the path itself and of every prefix of it, costs
+   * one lookup per segment instead of one comparison per listener. the
+   * caller holds the subscription lock.
+   *
+   * @param path
+   * @return QContainer<Subscription>
+   */
+  auto match_subscriptions(const QString& path) -> QContainer<Subscription> {
+    QContainer<Subscription> matched = exact_subs_.value(path);
+    if (prefix_subs_.isEmpty()) return matched;
+
+    qsizetype pos = 0;
+    while (true) {
+      pos = path.indexOf('.', pos);
+      const auto prefix = pos < 0 ? path : path.left(pos);
+
+      auto it = prefix_subs_.constFind(prefix);
+      if (it != prefix_subs_.constEnd()) matched.append(it.value());
+
+      if (pos < 0) break;
+      pos++;
+    }
+    return matched;
+  }
+
+  /**
+   * @brief run the callback in the thread of the receiver, directly if
+   * that is the current one.
+   *
+   */
+  static void dispatch(const Subscription& sub, const Namespace& n,
+                       const Key& k, int version, const std::any& v) {
+    {
+      // the receiver can't be destroyed while the lock is held, and a call
+      // it didn't process yet is dropped together with it
+      std::lock_guard<std::mutex> lock(sub.receiver->mutex);
+      auto* receiver = sub.receiver->object;
+      if (receiver == nullptr) return;
+
+      if (receiver->thread() != QThread::currentThread()) {
+        QMetaObject::invokeMethod(
+            receiver,
+            [cb = sub.callback, n, k, version, v]() { cb(n, k, version, v); },
+            Qt::QueuedConnection);
+        return;
+      }
+    }
+
+    // only this thread could destroy the receiver, and the callback may
+    // do so, so it runs without the lock
+    sub.callback(n, k, version, v);
+  }
 };
 
 class GlobalRegisterTableTreeModel::Impl {
@@ -291,14 +458,22 @@ auto GlobalRegisterTable::PublishKV(Namespace n, Key k, std::any v) -> bool {
   return p_->PublishKV(n, k, v);
 }
 
+auto GlobalRegisterTable::PublishKVs(Namespace n, const KVList& kvs) -> bool {
+  return p_->PublishKVs(n, kvs);
+}
+
+auto GlobalRegisterTable::InternPath(Namespace n, Key k) -> RTPath {
+  return RTPath(p_->InternPath(n, k));
+}
+
 auto GlobalRegisterTable::LookupKV(Namespace n,
                                    Key v) -> std::optional<std::any> {
   return p_->LookupKV(n, v);
 }
 
 auto GlobalRegisterTable::ListenPublish(QObject* o, Namespace n, Key k,
-                                        LPCallback c) -> bool {
-  return p_->ListenPublish(o, n, k, c);
+                                        LPCallback c, bool prefix) -> bool {
+  return p_->ListenPublish(o, n, k, std::move(c), prefix);
 }
 
 auto GlobalRegisterTable::ListChildKeys(Namespace n, Key k) -> QContainer<Key> {
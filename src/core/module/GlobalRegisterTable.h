@@ -33,6 +33,7 @@
 #include <optional>
 
 #include "core/function/SecureMemoryAllocator.h"
+#include "core/module/RTPath.h"
 #include "core/typedef/CoreTypedef.h"
 
 namespace GpgFrontend::Module {
@@ -40,6 +41,7 @@ namespace GpgFrontend::Module {
 using Namespace = QString;
 using Key = QString;
 using LPCallback = std::function<void(Namespace, Key, int, std::any)>;
+using KVList = QContainer<QPair<Key, std::any>>;
 
 class GlobalRegisterTable : public QObject {
   Q_OBJECT
@@ -52,9 +54,34 @@ class GlobalRegisterTable : public QObject {
 
   auto PublishKV(Namespace, Key, std::any) -> bool;
 
+  /**
+   * @brief publish several values of a namespace under one lock
+   *
+   * @return true
+   * @return false
+   */
+  auto PublishKVs(Namespace, const KVList &) -> bool;
+
   auto LookupKV(Namespace, Key) -> std::optional<std::any>;
 
-  auto ListenPublish(QObject *, Namespace, Key, LPCallback) -> bool;
+  /**
+   * @brief resolve the path once, the handle sees every later publishing
+   * of the key without going through the table again.
+   *
+   * @return RTPath
+   */
+  auto InternPath(Namespace, Key) -> RTPath;
+
+  /**
+   * @brief call back on publishing of the key, or of the key and every key
+   * below it if prefix is set. an empty key with prefix set listens to the
+   * whole namespace. the callback runs in the thread of the receiver.
+   *
+   * @return true
+   * @return false
+   */
+  auto ListenPublish(QObject *, Namespace, Key, LPCallback, bool prefix = false)
+      -> bool;
 
   auto ListChildKeys(Namespace n, Key k) -> QContainer<Key>;
 
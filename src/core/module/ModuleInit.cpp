@@ -31,6 +31,7 @@
 #include <QCoreApplication>
 #include <QDir>
 
+#include "core/GpgCoreInit.h"
 #include "core/function/GlobalSettingStation.h"
 #include "core/module/ModuleManager.h"
 #include "core/thread/Task.h"
@@ -91,10 +92,16 @@ auto LoadExternalMods() -> QMap<QString, bool> {
 namespace GpgFrontend::Module {
 
 void LoadGpgFrontendModules(ModuleInitArgs) {
+  // resolved by the module manager once every module is registered
+  BeginCoreInitStage("modules");
+
   // give user ability to give up all modules
   auto disable_loading_all_modules =
       GetSettings().value("basic/disable_loading_all_modules", false).toBool();
-  if (disable_loading_all_modules) return;
+  if (disable_loading_all_modules) {
+    ModuleManager::GetInstance().LoadModules({});
+    return;
+  }
 
   // must init at default thread before core
   Thread::TaskRunnerGetter::GetInstance()
@@ -104,21 +111,9 @@ void LoadGpgFrontendModules(ModuleInitArgs) {
             QMap<QString, bool> modules = LoadIntegratedMods();
             modules.insert(LoadExternalMods());
 
-            auto& manager = ModuleManager::GetInstance();
-            manager.SetNeedRegisterModulesNum(static_cast<int>(modules.size()));
-
-#if QT_VERSION >= QT_VERSION_CHECK(6, 4, 0)
-            for (const auto& m : modules.asKeyValueRange()) {
-              manager.LoadModule(m.first, m.second);
-            }
-#else
-            for (auto it = modules.keyValueBegin(); it != modules.keyValueEnd();
-                 ++it) {
-              manager.LoadModule(it->first, it->second);
-            }
-#endif
-
-            LOG_D() << "all modules are loaded into memory.";
+            ModuleManager::GetInstance().LoadModules(modules);
+
+            LOG_D() << "all modules are scheduled for loading.";
             return 0;
           },
           "modules_system_init_task"));
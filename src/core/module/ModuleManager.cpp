@@ -28,8 +28,12 @@
 
 #include "ModuleManager.h"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <vector>
 
+#include "core/GpgCoreInit.h"
 #include "core/function/GlobalSettingStation.h"
 #include "core/function/SecureMemoryAllocator.h"
 #include "core/function/basic/GpgFunctionObject.h"
@@ -54,78 +58,73 @@ class ModuleManager::Impl {
 
   auto LoadAndRegisterModule(const QString& module_library_path,
                              bool integrated_module) -> bool {
-    QLibrary module_library(module_library_path);
-    if (!module_library.load()) {
-      LOG_W() << "module manager failed to load module: "
-              << module_library.fileName()
-              << ", reason: " << module_library.errorString();
-      need_register_modules_--;
+    auto loaded = load_module(module_library_path, integrated_module);
+    if (loaded.module == nullptr) {
+      publish_registration_state();
       return false;
     }
 
-    auto module = SecureCreateSharedObject<Module>(module_library);
-    if (!module->IsGood()) {
-      LOG_W() << "module manager failed to load module, "
-                 "reason: illegal module: "
-              << module_library.fileName();
-      need_register_modules_--;
-      return false;
-    }
+    module_runner()->PostTask(new Thread::Task(
+        [=](GpgFrontend::DataObjectPtr) -> int {
+          return register_and_activate({loaded}) > 0 ? 0 : -1;
+        },
+        __func__, nullptr));
+    return true;
+  }
 
-    module->SetGPC(gmc_.get());
+  void LoadAndRegisterModules(const QMap<QString, bool>& modules) {
+    SetNeedRegisterModulesNum(static_cast<int>(modules.size()));
+    if (modules.isEmpty()) return;
 
-    LOG_D() << "a new need register module: "
-            << QFileInfo(module_library_path).fileName();
+    // every library is loaded and resolved on its own worker, the batch
+    // is registered on the module runner once the last one is done
+    auto batch = SecureCreateSharedObject<LoadBatch>();
+    batch->loaded.resize(modules.size());
+    batch->pending = static_cast<int>(modules.size());
+    batch->timer.start();
 
-    auto runner = Thread::TaskRunnerGetter::GetInstance().GetTaskRunner(
-        Thread::TaskRunnerGetter::kTaskRunnerType_Module);
+    auto executor =
+        Thread::TaskRunnerGetter::GetInstance().GetConcurrentExecutor();
 
-    runner->PostTask(new Thread::Task(
-        [=](GpgFrontend::DataObjectPtr) -> int {
-          // register module
-          if (!gmc_->RegisterModule(module, integrated_module)) return -1;
+    size_t index = 0;
+    for (auto it = modules.constBegin(); it != modules.constEnd(); ++it) {
+      executor->Post([=, path = it.key(), integrated = it.value()]() {
+        batch->loaded[index] = load_module(path, integrated);
+        if (--batch->pending != 0) return;
 
-          return 0;
-        },
-        __func__, nullptr));
+        module_runner()->PostTask(new Thread::Task(
+            [=](GpgFrontend::DataObjectPtr) -> int {
+              QContainer<LoadedModule> loaded;
+              for (const auto& m : batch->loaded) {
+                if (m.module != nullptr) loaded.push_back(m);
+              }
+
+              const auto registered = register_and_activate(loaded);
+              LOG_I() << "module manager registered" << registered << "of"
+                      << batch->loaded.size() << "modules in"
+                      << batch->timer.elapsed() << "ms";
+              return 0;
+            },
+            "modules_register_task", nullptr));
+      });
+      index++;
+    }
+  }
 
-    runner->PostTask(new Thread::Task(
-        [=](GpgFrontend::DataObjectPtr) -> int {
-          const auto module_id = module->GetModuleIdentifier();
-          const auto module_hash = module->GetModuleHash();
-
-          SettingsObject so(QString("module.%1.so").arg(module_id));
-          ModuleSO module_so(so);
-
-          // reset module settings if necessary
-          if (module_so.module_id != module_id ||
-              module_so.module_hash != module_hash) {
-            module_so.module_id = module_id;
-            module_so.module_hash = module_hash;
-            // auto active integrated module by default
-            module_so.auto_activate = integrated_module;
-            module_so.set_by_user = false;
-
-            so.Store(module_so.ToJson());
-          }
-
-          // if this module need auto active
-          if (module_so.auto_activate) {
-            if (!gmc_->ActiveModule(module_id)) {
-              return -1;
-            }
-          }
-
-          return 0;
-        },
-        __func__, nullptr));
+  auto GetModuleTimings() -> QMap<ModuleIdentifier, ModuleTiming> {
+    std::lock_guard<std::mutex> lock(timings_lock_);
+    return timings_;
+  }
 
-    return true;
+  auto GetModuleExecStatistics(const ModuleIdentifier& module_id)
+      -> ModuleExecStatistics {
+    return gmc_->GetModuleExecStatistics(module_id);
   }
 
   void SetNeedRegisterModulesNum(int n) {
     if (need_register_modules_ != -1 || n < 0) return;
     need_register_modules_ = n;
+    publish_registration_state();
   }
 
   auto SearchModule(ModuleIdentifier module_id) -> ModulePtr {
@@ -142,7 +141,9 @@ class ModuleManager::Impl {
         ->PostTask(new Thread::Task(
             [=](GpgFrontend::DataObjectPtr) -> int {
               module->SetGPC(gmc_.get());
-              return gmc_->RegisterModule(module, false) ? 0 : -1;
+              const auto succeed = gmc_->RegisterModule(module, false);
+              publish_registration_state();
+              return succeed ? 0 : -1;
             },
             __func__, nullptr));
   }
@@ -210,12 +211,21 @@ class ModuleManager::Impl {
     return grt_->PublishKV(n, k, v);
   }
 
+  auto UpsertRTValues(Namespace n, const KVList& kvs) -> bool {
+    return grt_->PublishKVs(n, kvs);
+  }
+
   auto RetrieveRTValue(Namespace n, Key k) -> std::optional<std::any> {
     return grt_->LookupKV(n, k);
   }
 
-  auto ListenPublish(QObject* o, Namespace n, Key k, LPCallback c) -> bool {
-    return grt_->ListenPublish(o, n, k, c);
+  auto InternRTPath(Namespace n, Key k) -> RTPath {
+    return grt_->InternPath(n, k);
+  }
+
+  auto ListenPublish(QObject* o, Namespace n, Key k, LPCallback c,
+                     bool prefix) -> bool {
+    return grt_->ListenPublish(o, n, k, c, prefix);
   }
 
   auto ListRTChildKeys(const QString& n, const QString& k) -> QContainer<Key> {
@@ -233,7 +243,7 @@ class ModuleManager::Impl {
   auto IsAllModulesRegistered() {
     if (need_register_modules_ == -1) return false;
     LOG_D() << "module manager report, need register: "
-            << need_register_modules_ << "registered"
+            << need_register_modules_.load() << "registered"
             << gmc_->GetRegisteredModuleNum();
     return need_register_modules_ == gmc_->GetRegisteredModuleNum();
   }
@@ -245,7 +255,221 @@ class ModuleManager::Impl {
   SecureUniquePtr<GlobalModuleContext> gmc_;
   SecureUniquePtr<GlobalRegisterTable> grt_;
   QContainer<QLibrary> module_libraries_;
-  int need_register_modules_ = -1;
+  std::atomic_int need_register_modules_ = -1;
+  std::atomic_bool registration_published_ = false;
+
+  std::mutex timings_lock_;
+  QMap<ModuleIdentifier, ModuleTiming> timings_;
+
+  struct LoadedModule {
+    ModulePtr module;
+    bool integrated = false;
+    qint64 load_us = 0;
+  };
+
+  struct LoadBatch {
+    std::vector<LoadedModule> loaded;  ///< in the order of the paths
+    std::atomic_int pending;
+    QElapsedTimer timer;
+  };
+
+  static auto module_runner() -> TaskRunnerPtr {
+    return Thread::TaskRunnerGetter::GetInstance().GetTaskRunner(
+        Thread::TaskRunnerGetter::kTaskRunnerType_Module);
+  }
+
+  /**
+   * @brief open the library and resolve the symbols of the module, safe to
+   * run on any thread.
+   *
+   * @return LoadedModule the module is nullptr on failure
+   */
+  auto load_module(const QString& module_library_path,
+                   bool integrated_module) -> LoadedModule {
+    QElapsedTimer timer;
+    timer.start();
+
+    QLibrary module_library(module_library_path);
+    if (!module_library.load()) {
+      LOG_W() << "module manager failed to load module: "
+              << module_library.fileName()
+              << ", reason: " << module_library.errorString();
+      need_register_modules_--;
+      return {};
+    }
+
+    auto module = SecureCreateSharedObject<Module>(module_library);
+    if (!module->IsGood()) {
+      LOG_W() << "module manager failed to load module, "
+                 "reason: illegal module: "
+              << module_library.fileName();
+      need_register_modules_--;
+      return {};
+    }
+
+    module->SetGPC(gmc_.get());
+
+    // hand the module over to the module runner from the creating thread
+    module->moveToThread(module_runner()->GetThread());
+
+    LOG_D() << "a new need register module: "
+            << QFileInfo(module_library_path).fileName();
+
+    return {module, integrated_module, timer.nsecsElapsed() / 1000};
+  }
+
+  /**
+   * @brief order the modules so that every module comes after the modules
+   * listed in its "Dependencies" metadata. unknown dependencies are
+   * ignored, modules in a cycle keep their original order.
+   *
+   */
+  static auto order_by_dependencies(const QContainer<LoadedModule>& loaded)
+      -> QContainer<LoadedModule> {
+    QHash<ModuleIdentifier, int> index_of;
+    for (int i = 0; i < loaded.size(); i++) {
+      index_of.insert(loaded[i].module->GetModuleIdentifier(), i);
+    }
+
+    QContainer<int> in_degree(loaded.size(), 0);
+    QContainer<QContainer<int>> dependents(loaded.size());
+    for (int i = 0; i < loaded.size(); i++) {
+      const auto& module = loaded[i].module;
+      const auto deps = module->GetModuleMetaData()
+                            .value("Dependencies")
+                            .split(',', Qt::SkipEmptyParts);
+
+      for (const auto& dep : deps) {
+        auto it = index_of.constFind(dep.trimmed());
+        if (it == index_of.constEnd()) {
+          LOG_W() << "module" << module->GetModuleIdentifier()
+                  << "depends on unknown module:" << dep.trimmed();
+          continue;
+        }
+        if (it.value() == i) continue;
+
+        dependents[it.value()].push_back(i);
+        in_degree[i]++;
+      }
+    }
+
+    QContainer<LoadedModule> ordered;
+    QContainer<bool> placed(loaded.size(), false);
+    while (ordered.size() < loaded.size()) {
+      // the first ready module keeps the order stable
+      int next = -1;
+      for (int i = 0; i < loaded.size(); i++) {
+        if (!placed[i] && in_degree[i] == 0) {
+          next = i;
+          break;
+        }
+      }
+
+      if (next < 0) {
+        for (int i = 0; i < loaded.size(); i++) {
+          if (placed[i]) continue;
+          LOG_W() << "module" << loaded[i].module->GetModuleIdentifier()
+                  << "is part of a dependency cycle";
+          next = i;
+          break;
+        }
+      }
+
+      placed[next] = true;
+      ordered.push_back(loaded[next]);
+      for (auto dependent : dependents[next]) in_degree[dependent]--;
+    }
+    return ordered;
+  }
+
+  /**
+   * @brief register the modules in dependency order, then activate the
+   * ones that need to be. runs on the module runner.
+   *
+   * @return int number of registered modules
+   */
+  auto register_and_activate(const QContainer<LoadedModule>& loaded) -> int {
+    const auto ordered = order_by_dependencies(loaded);
+
+    QContainer<LoadedModule> registered;
+    for (const auto& m : ordered) {
+      QElapsedTimer timer;
+      timer.start();
+
+      const auto succeed = gmc_->RegisterModule(m.module, m.integrated);
+
+      ModuleTiming timing;
+      timing.load_us = m.load_us;
+      timing.register_us = timer.nsecsElapsed() / 1000;
+      update_timing(m.module->GetModuleIdentifier(), timing);
+
+      if (succeed) registered.push_back(m);
+    }
+
+    for (const auto& m : registered) {
+      QElapsedTimer timer;
+      timer.start();
+
+      if (!auto_activate(m.module, m.integrated)) continue;
+
+      const auto module_id = m.module->GetModuleIdentifier();
+      std::lock_guard<std::mutex> lock(timings_lock_);
+      timings_[module_id].activate_us = timer.nsecsElapsed() / 1000;
+      LOG_D() << "module" << module_id
+              << "load:" << timings_[module_id].load_us
+              << "us, register:" << timings_[module_id].register_us
+              << "us, activate:" << timings_[module_id].activate_us << "us";
+    }
+
+    publish_registration_state();
+    return static_cast<int>(registered.size());
+  }
+
+  /**
+   * @brief set env.state.modules once every expected module is registered,
+   * the core waits for it instead of polling IsAllModulesRegistered().
+   *
+   */
+  void publish_registration_state() {
+    if (registration_published_ || !IsAllModulesRegistered()) return;
+    if (registration_published_.exchange(true)) return;
+    grt_->PublishKV("core", "env.state.modules", 1);
+    ResolveCoreInitStage("modules");
+  }
+
+  /**
+   * @brief activate the module if its settings say so
+   *
+   * @return true if the module was activated
+   */
+  auto auto_activate(const ModulePtr& module, bool integrated_module) -> bool {
+    const auto module_id = module->GetModuleIdentifier();
+    const auto module_hash = module->GetModuleHash();
+
+    SettingsObject so(QString("module.%1.so").arg(module_id));
+    ModuleSO module_so(so);
+
+    // reset module settings if necessary
+    if (module_so.module_id != module_id ||
+        module_so.module_hash != module_hash) {
+      module_so.module_id = module_id;
+      module_so.module_hash = module_hash;
+      // auto active integrated module by default
+      module_so.auto_activate = integrated_module;
+      module_so.set_by_user = false;
+
+      so.Store(module_so.ToJson());
+    }
+
+    // if this module need auto active
+    return module_so.auto_activate && gmc_->ActiveModule(module_id);
+  }
+
+  void update_timing(const ModuleIdentifier& module_id,
+                     const ModuleTiming& timing) {
+    std::lock_guard<std::mutex> lock(timings_lock_);
+    timings_[module_id] = timing;
+  }
 };
 
 auto IsModuleActivate(ModuleIdentifier id) -> bool {
@@ -263,9 +487,17 @@ auto UpsertRTValue(const QString& namespace_, const QString& key,
                                                     std::any(value));
 }
 
-auto ListenRTPublishEvent(QObject* o, Namespace n, Key k, LPCallback c)
-    -> bool {
-  return ModuleManager::GetInstance().ListenRTPublish(o, n, k, c);
+auto UpsertRTValues(const QString& namespace_, const KVList& kvs) -> bool {
+  return ModuleManager::GetInstance().UpsertRTValues(namespace_, kvs);
+}
+
+auto InternRTPath(const QString& namespace_, const QString& key) -> RTPath {
+  return ModuleManager::GetInstance().InternRTPath(namespace_, key);
+}
+
+auto ListenRTPublishEvent(QObject* o, Namespace n, Key k, LPCallback c,
+                          bool prefix) -> bool {
+  return ModuleManager::GetInstance().ListenRTPublish(o, n, k, c, prefix);
 }
 
 auto ListRTChildKeys(const QString& namespace_, const QString& key)
@@ -284,6 +516,19 @@ auto ModuleManager::LoadModule(QString module_library_path,
   return p_->LoadAndRegisterModule(module_library_path, integrated_module);
 }
 
+void ModuleManager::LoadModules(const QMap<QString, bool>& modules) {
+  p_->LoadAndRegisterModules(modules);
+}
+
+auto ModuleManager::GetModuleTimings() -> QMap<ModuleIdentifier, ModuleTiming> {
+  return p_->GetModuleTimings();
+}
+
+auto ModuleManager::GetModuleExecStatistics(ModuleIdentifier module_id)
+    -> ModuleExecStatistics {
+  return p_->GetModuleExecStatistics(module_id);
+}
+
 auto ModuleManager::SearchModule(ModuleIdentifier module_id) -> ModulePtr {
   return p_->SearchModule(std::move(module_id));
 }
@@ -333,9 +578,17 @@ auto ModuleManager::RetrieveRTValue(Namespace n, Key k)
   return p_->RetrieveRTValue(n, k);
 }
 
+auto ModuleManager::InternRTPath(Namespace n, Key k) -> RTPath {
+  return p_->InternRTPath(n, k);
+}
+
+auto ModuleManager::UpsertRTValues(Namespace n, const KVList& kvs) -> bool {
+  return p_->UpsertRTValues(n, kvs);
+}
+
 auto ModuleManager::ListenRTPublish(QObject* o, Namespace n, Key k,
-                                    LPCallback c) -> bool {
-  return p_->ListenPublish(o, n, k, c);
+                                    LPCallback c, bool prefix) -> bool {
+  return p_->ListenPublish(o, n, k, c, prefix);
 }
 
 auto ModuleManager::ListRTChildKeys(const QString& n, const QString& k)
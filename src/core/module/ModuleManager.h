@@ -33,6 +33,7 @@
 #include "core/function/SecureMemoryAllocator.h"
 #include "core/function/basic/GpgFunctionObject.h"
 #include "core/module/Event.h"
+#include "core/module/RTPath.h"
 #include "core/utils/MemoryUtils.h"
 
 namespace GpgFrontend::Thread {
@@ -48,6 +49,7 @@ class Module;
 class GlobalModuleContext;
 class ModuleManager;
 class GlobalRegisterTable;
+struct ModuleExecStatistics;
 
 using EventReference = QSharedPointer<Event>;
 using ModuleIdentifier = QString;
@@ -57,6 +59,17 @@ using GMCPtr = QSharedPointer<GlobalModuleContext>;
 using Namespace = QString;
 using Key = QString;
 using LPCallback = std::function<void(Namespace, Key, int, std::any)>;
+using KVList = QContainer<QPair<Key, std::any>>;
+
+/**
+ * @brief time spent on each startup step of a module, in microseconds
+ *
+ */
+struct ModuleTiming {
+  qint64 load_us = 0;      ///< open the library and resolve the symbols
+  qint64 register_us = 0;  ///<
+  qint64 activate_us = 0;  ///< zero if not activated at startup
+};
 
 class GF_CORE_EXPORT ModuleManager
     : public SingletonFunctionObject<ModuleManager> {
@@ -67,6 +80,28 @@ class GF_CORE_EXPORT ModuleManager
 
   auto LoadModule(QString, bool) -> bool;
 
+  /**
+   * @brief load the libraries in parallel, then register and activate the
+   * modules in the order of their "Dependencies" metadata.
+   *
+   * @param modules library path -> is integrated module
+   */
+  void LoadModules(const QMap<QString, bool>& modules);
+
+  /**
+   * @brief timings of the modules loaded at startup
+   *
+   * @return QMap<ModuleIdentifier, ModuleTiming>
+   */
+  auto GetModuleTimings() -> QMap<ModuleIdentifier, ModuleTiming>;
+
+  /**
+   * @brief statistics of the event queue of the module
+   *
+   * @return ModuleExecStatistics
+   */
+  auto GetModuleExecStatistics(ModuleIdentifier) -> ModuleExecStatistics;
+
   auto SearchModule(ModuleIdentifier) -> ModulePtr;
 
   void SetNeedRegisterModulesNum(int);
@@ -97,9 +132,14 @@ class GF_CORE_EXPORT ModuleManager
 
   auto UpsertRTValue(Namespace, Key, std::any) -> bool;
 
+  auto UpsertRTValues(Namespace, const KVList&) -> bool;
+
   auto RetrieveRTValue(Namespace, Key) -> std::optional<std::any>;
 
-  auto ListenRTPublish(QObject*, Namespace, Key, LPCallback) -> bool;
+  auto InternRTPath(Namespace, Key) -> RTPath;
+
+  auto ListenRTPublish(QObject*, Namespace, Key, LPCallback,
+                       bool prefix = false) -> bool;
 
   auto ListRTChildKeys(const QString&, const QString&) -> QContainer<Key>;
 
@@ -160,14 +200,27 @@ auto GF_CORE_EXPORT IsModuleExists(ModuleIdentifier) -> bool;
 auto GF_CORE_EXPORT UpsertRTValue(const QString& namespace_, const QString& key,
                                   const std::any& value) -> bool;
 
+/**
+ * @brief upsert several values of a namespace at once, listeners are
+ * notified after all of them are stored.
+ *
+ * @param namespace_
+ * @param kvs
+ * @return true
+ * @return false
+ */
+auto GF_CORE_EXPORT UpsertRTValues(const QString& namespace_,
+                                   const KVList& kvs) -> bool;
+
 /**
  * @brief
  *
+ * @param prefix also listen to every key below the key
  * @return true
  * @return false
  */
-auto GF_CORE_EXPORT ListenRTPublishEvent(QObject*, Namespace, Key, LPCallback)
-    -> bool;
+auto GF_CORE_EXPORT ListenRTPublishEvent(QObject*, Namespace, Key, LPCallback,
+                                         bool prefix = false) -> bool;
 
 /**
  * @brief
@@ -179,6 +232,17 @@ auto GF_CORE_EXPORT ListenRTPublishEvent(QObject*, Namespace, Key, LPCallback)
 auto GF_CORE_EXPORT ListRTChildKeys(const QString& namespace_,
                                     const QString& key) -> QContainer<Key>;
 
+/**
+ * @brief resolve the path of a runtime value once, for values read on hot
+ * paths.
+ *
+ * @param namespace_
+ * @param key
+ * @return RTPath
+ */
+auto GF_CORE_EXPORT InternRTPath(const QString& namespace_, const QString& key)
+    -> RTPath;
+
 template <typename T>
 auto RetrieveRTValueTyped(const QString& namespace_, const QString& key)
     -> std::optional<T> {
@@ -202,4 +266,23 @@ auto RetrieveRTValueTypedOrDefault(const QString& namespace_,
   return defaultValue;
 }
 
+template <typename T>
+auto RetrieveRTValueTyped(const RTPath& path) -> std::optional<T> {
+  auto any_value = path.Load();
+  if (any_value && any_value->type() == typeid(T)) {
+    return std::any_cast<T>(*any_value);
+  }
+  return std::nullopt;
+}
+
+template <typename T>
+auto RetrieveRTValueTypedOrDefault(const RTPath& path, const T& defaultValue)
+    -> T {
+  auto any_value = path.Load();
+  if (any_value && any_value->type() == typeid(T)) {
+    return std::any_cast<T>(*any_value);
+  }
+  return defaultValue;
+}
+
 }  // namespace GpgFrontend::Module
\ No newline at end of file
@@ -0,0 +1,86 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include <any>
+#include <memory>
+
+#include "core/GpgFrontendCore.h"
+
+namespace GpgFrontend::Module {
+
+class GlobalRegisterTable;
+
+/**
+ * @brief storage of one value in the global register table. the value is
+ * replaced as a whole on publishing, readers take a reference to the
+ * current one through an atomic load and never block on the table.
+ *
+ */
+struct RTSlot {
+  std::shared_ptr<const std::any> value;
+};
+
+/**
+ * @brief interned path of a runtime value. resolving the path costs one
+ * lookup in the register table, reading through the handle afterwards
+ * costs one atomic load.
+ *
+ */
+class RTPath {
+ public:
+  RTPath() = default;
+
+  /**
+   * @brief
+   *
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] auto IsValid() const -> bool { return slot_ != nullptr; }
+
+  /**
+   * @brief current value, or nullptr if none was published yet
+   *
+   * @return std::shared_ptr<const std::any>
+   */
+  [[nodiscard]] auto Load() const -> std::shared_ptr<const std::any> {
+    if (slot_ == nullptr) return nullptr;
+    return std::atomic_load(&slot_->value);
+  }
+
+ private:
+  friend class GlobalRegisterTable;
+
+  explicit RTPath(std::shared_ptr<RTSlot> slot) : slot_(std::move(slot)) {}
+
+  std::shared_ptr<RTSlot> slot_;
+};
+
+}  // namespace GpgFrontend::Module
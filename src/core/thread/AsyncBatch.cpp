@@ -0,0 +1,230 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "core/thread/AsyncBatch.h"
+
+#include <mutex>
+
+#include "core/utils/MemoryUtils.h"
+
+namespace GpgFrontend::Thread {
+
+class AsyncBatch::Impl : public QEnableSharedFromThis<AsyncBatch::Impl> {
+ public:
+  Impl(qsizetype total, int parallelism, Starter starter)
+      : total_(total),
+        parallelism_(std::max(1, parallelism)),
+        starter_(std::move(starter)),
+        start_ms_(total, -1),
+        item_ms_(total, -1) {}
+
+  void OnProgress(ProgressCallback callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    progress_cb_ = std::move(callback);
+  }
+
+  void OnFinished(FinishCallback callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    finish_cb_ = std::move(callback);
+  }
+
+  void Start() {
+    bool finished = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (started_) return;
+
+      started_ = true;
+      timer_.start();
+      schedule_locked();
+      finished = try_finish_locked();
+    }
+
+    launch();
+    if (finished) finish();
+  }
+
+  void Cancel() {
+    bool finished = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      cancelled_ = true;
+
+      // scheduled items which haven't been handed to the starter yet
+      for (const auto index : ready_) start_ms_[index] = -1;
+      in_flight_ -= static_cast<int>(ready_.size());
+      ready_.clear();
+
+      finished = started_ && try_finish_locked();
+    }
+
+    if (finished) finish();
+  }
+
+  auto IsCancelled() -> bool {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cancelled_;
+  }
+
+  auto GetStatistics() -> Statistics {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return {total_,         done_,       skipped_, parallelism_,
+            max_in_flight_, elapsed_ms_, item_ms_};
+  }
+
+ private:
+  const qsizetype total_;
+  const int parallelism_;
+  Starter starter_;
+  ProgressCallback progress_cb_;
+  FinishCallback finish_cb_;
+
+  std::mutex mutex_;
+  QElapsedTimer timer_;
+  bool started_ = false;
+  bool cancelled_ = false;
+  bool finished_ = false;
+  bool launching_ = false;
+  qsizetype next_ = 0;
+  qsizetype done_ = 0;
+  qsizetype skipped_ = 0;
+  int in_flight_ = 0;
+  int max_in_flight_ = 0;
+  qint64 elapsed_ms_ = 0;
+  QContainer<qint64> start_ms_;
+  QContainer<qint64> item_ms_;
+  QContainer<qsizetype> ready_;  ///< scheduled but not yet started
+
+  /**
+   * @brief fill the free slots with the next items, caller must hold
+   * mutex_
+   *
+   */
+  void schedule_locked() {
+    while (!cancelled_ && in_flight_ < parallelism_ && next_ < total_) {
+      start_ms_[next_] = timer_.elapsed();
+      ready_.push_back(next_++);
+      max_in_flight_ = std::max(max_in_flight_, ++in_flight_);
+    }
+  }
+
+  /**
+   * @brief caller must hold mutex_
+   *
+   * @return true if the batch has just finished
+   */
+  auto try_finish_locked() -> bool {
+    if (finished_ || in_flight_ != 0) return false;
+    if (!cancelled_ && next_ < total_) return false;
+
+    finished_ = true;
+    skipped_ = total_ - done_;
+    elapsed_ms_ = timer_.elapsed();
+    return true;
+  }
+
+  /**
+   * @brief start the scheduled items. items may be done before their
+   * starter returns, so only one caller drains the queue at a time and
+   * the others leave their items to it, instead of recursing.
+   *
+   */
+  void launch() {
+    auto self = sharedFromThis();
+    while (true) {
+      qsizetype index = 0;
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (launching_ || ready_.isEmpty()) return;
+        launching_ = true;
+        index = ready_.takeFirst();
+      }
+
+      auto done_once = QSharedPointer<std::once_flag>::create();
+      starter_(index, [self, index, done_once]() {
+        std::call_once(*done_once, [&]() { self->complete(index); });
+      });
+
+      std::lock_guard<std::mutex> lock(mutex_);
+      launching_ = false;
+    }
+  }
+
+  void complete(qsizetype index) {
+    bool finished = false;
+    ProgressCallback progress_cb;
+    qsizetype done = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      item_ms_[index] = timer_.elapsed() - start_ms_[index];
+      done = ++done_;
+      in_flight_--;
+
+      schedule_locked();
+      finished = try_finish_locked();
+      progress_cb = progress_cb_;
+    }
+
+    launch();
+    if (progress_cb) progress_cb(done, total_);
+    if (finished) finish();
+  }
+
+  void finish() {
+    FinishCallback finish_cb;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      finish_cb.swap(finish_cb_);
+    }
+    if (finish_cb) finish_cb();
+  }
+};
+
+AsyncBatch::AsyncBatch(qsizetype total, int parallelism, Starter starter)
+    : p_(SecureCreateSharedObject<Impl>(total, parallelism,
+                                        std::move(starter))) {}
+
+AsyncBatch::~AsyncBatch() = default;
+
+void AsyncBatch::OnProgress(ProgressCallback callback) {
+  p_->OnProgress(std::move(callback));
+}
+
+void AsyncBatch::OnFinished(FinishCallback callback) {
+  p_->OnFinished(std::move(callback));
+}
+
+void AsyncBatch::Start() { p_->Start(); }
+
+void AsyncBatch::Cancel() { p_->Cancel(); }
+
+auto AsyncBatch::IsCancelled() -> bool { return p_->IsCancelled(); }
+
+auto AsyncBatch::GetStatistics() -> Statistics { return p_->GetStatistics(); }
+
+}  // namespace GpgFrontend::Thread
@@ -0,0 +1,122 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include "core/GpgFrontendCore.h"
+
+namespace GpgFrontend::Thread {
+
+/**
+ * @brief runs a fixed number of asynchronous items with at most a given
+ * number of them in flight. An item is started by the starter and counts
+ * as in flight until the done handler it was given is called, the next
+ * waiting item is started right away, from the thread calling the done
+ * handler. All methods are thread-safe.
+ *
+ */
+class GF_CORE_EXPORT AsyncBatch {
+ public:
+  using DoneHandler = std::function<void()>;
+  using Starter = std::function<void(qsizetype index, DoneHandler done)>;
+  using ProgressCallback = std::function<void(qsizetype done, qsizetype total)>;
+  using FinishCallback = std::function<void()>;
+
+  struct Statistics {
+    qsizetype total;             ///<
+    qsizetype done;              ///< items which ran to completion
+    qsizetype skipped;           ///< items never started due to Cancel()
+    int parallelism;             ///<
+    int max_in_flight;           ///<
+    qint64 elapsed_ms;           ///< from Start() until the last item is done
+    QContainer<qint64> item_ms;  ///< per item, -1 if it was never started
+  };
+
+  /**
+   * @brief Construct a new Async Batch object
+   *
+   * @param total
+   * @param parallelism at least 1
+   * @param starter
+   */
+  AsyncBatch(qsizetype total, int parallelism, Starter starter);
+
+  /**
+   * @brief Destroy the Async Batch object, items still in flight may call
+   * their done handlers later.
+   *
+   */
+  ~AsyncBatch();
+
+  /**
+   * @brief called after each item is done
+   *
+   * @param callback
+   */
+  void OnProgress(ProgressCallback callback);
+
+  /**
+   * @brief called once when the last started item is done
+   *
+   * @param callback
+   */
+  void OnFinished(FinishCallback callback);
+
+  /**
+   * @brief start the first items, callbacks should be set before.
+   *
+   */
+  void Start();
+
+  /**
+   * @brief start no more items, the ones in flight are waited for.
+   *
+   */
+  void Cancel();
+
+  /**
+   * @brief
+   *
+   * @return true
+   * @return false
+   */
+  auto IsCancelled() -> bool;
+
+  /**
+   * @brief
+   *
+   * @return Statistics
+   */
+  auto GetStatistics() -> Statistics;
+
+ private:
+  class Impl;
+  QSharedPointer<Impl> p_;
+};
+
+}  // namespace GpgFrontend::Thread
@@ -0,0 +1,192 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "core/thread/ConcurrentExecutor.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace GpgFrontend::Thread {
+
+class ConcurrentExecutor::Impl {
+ public:
+  explicit Impl(int workers)
+      : worker_count_(workers > 0 ? workers
+                                  : std::max(1, QThread::idealThreadCount())) {
+    for (int i = 0; i < worker_count_; i++) {
+      workers_.push_back(std::make_unique<Worker>());
+    }
+  }
+
+  ~Impl() { Stop(); }
+
+  void Start() {
+    std::lock_guard<std::mutex> lock(idle_lock_);
+    if (started_) return;
+    started_ = true;
+
+    for (int i = 0; i < worker_count_; i++) {
+      workers_[i]->thread = std::thread([this, i]() { worker_loop(i); });
+    }
+  }
+
+  void Stop() {
+    {
+      std::lock_guard<std::mutex> lock(idle_lock_);
+      stop_ = true;
+    }
+    idle_cv_.notify_all();
+
+    for (auto& worker : workers_) {
+      if (worker->thread.joinable()) worker->thread.join();
+    }
+  }
+
+  void Post(Job job) {
+    if (job == nullptr) return;
+
+    const auto index = tls_executor == this
+                           ? tls_worker_index
+                           : static_cast<int>(next_worker_++ % worker_count_);
+
+    auto& worker = *workers_[index];
+    {
+      std::lock_guard<std::mutex> lock(worker.lock);
+      worker.jobs.push_back(std::move(job));
+      worker.depth++;
+    }
+    pending_++;
+
+    {
+      std::lock_guard<std::mutex> lock(idle_lock_);
+    }
+    idle_cv_.notify_one();
+  }
+
+  auto GetStatistics() -> Statistics {
+    Statistics statistics{worker_count_, {}, steals_, executed_};
+    for (const auto& worker : workers_) {
+      statistics.queue_depths.append(worker->depth);
+    }
+    return statistics;
+  }
+
+ private:
+  struct Worker {
+    std::mutex lock;
+    std::deque<Job> jobs;
+    std::atomic_int depth = 0;
+    std::thread thread;
+  };
+
+  static thread_local Impl* tls_executor;
+  static thread_local int tls_worker_index;
+
+  const int worker_count_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::mutex idle_lock_;
+  std::condition_variable idle_cv_;
+  std::atomic_int pending_ = 0;
+  std::atomic_uint next_worker_ = 0;
+  std::atomic<quint64> steals_ = 0;
+  std::atomic<quint64> executed_ = 0;
+  bool started_ = false;
+  bool stop_ = false;
+
+  auto pop_local(int index, Job& job) -> bool {
+    auto& worker = *workers_[index];
+    std::lock_guard<std::mutex> lock(worker.lock);
+    if (worker.jobs.empty()) return false;
+
+    job = std::move(worker.jobs.back());
+    worker.jobs.pop_back();
+    worker.depth--;
+    return true;
+  }
+
+  auto steal(int index, Job& job) -> bool {
+    for (int i = 1; i < worker_count_; i++) {
+      auto& victim = *workers_[(index + i) % worker_count_];
+      std::lock_guard<std::mutex> lock(victim.lock);
+      if (victim.jobs.empty()) continue;
+
+      // take the oldest job, the owner keeps working on its newest ones
+      job = std::move(victim.jobs.front());
+      victim.jobs.pop_front();
+      victim.depth--;
+      steals_++;
+      return true;
+    }
+    return false;
+  }
+
+  void worker_loop(int index) {
+    tls_executor = this;
+    tls_worker_index = index;
+
+    for (;;) {
+      Job job;
+      if (pop_local(index, job) || steal(index, job)) {
+        pending_--;
+        try {
+          job();
+        } catch (...) {
+          LOG_W() << "concurrent executor caught exception from a job";
+        }
+        executed_++;
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(idle_lock_);
+      idle_cv_.wait(lock, [this]() { return stop_ || pending_ > 0; });
+      if (stop_ && pending_ == 0) return;
+    }
+  }
+};
+
+thread_local ConcurrentExecutor::Impl* ConcurrentExecutor::Impl::tls_executor =
+    nullptr;
+thread_local int ConcurrentExecutor::Impl::tls_worker_index = -1;
+
+ConcurrentExecutor::ConcurrentExecutor(int workers)
+    : p_(SecureCreateUniqueObject<Impl>(workers)) {}
+
+ConcurrentExecutor::~ConcurrentExecutor() = default;
+
+void ConcurrentExecutor::Start() { p_->Start(); }
+
+void ConcurrentExecutor::Stop() { p_->Stop(); }
+
+void ConcurrentExecutor::Post(Job job) { p_->Post(std::move(job)); }
+
+auto ConcurrentExecutor::GetStatistics() -> Statistics {
+  return p_->GetStatistics();
+}
+
+}  // namespace GpgFrontend::Thread
@@ -0,0 +1,97 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#pragma once
+
+#include "core/GpgFrontendCore.h"
+#include "core/function/SecureMemoryAllocator.h"
+
+namespace GpgFrontend::Thread {
+
+/**
+ * @brief a fixed pool of worker threads with one job deque per worker.
+ * A worker pops its own deque from the back and steals from the front of
+ * the others when it runs dry.
+ *
+ */
+class GF_CORE_EXPORT ConcurrentExecutor {
+ public:
+  using Job = std::function<void()>;
+
+  struct Statistics {
+    int workers;              ///<
+    QList<int> queue_depths;  ///< per worker
+    quint64 steals;           ///< jobs taken from another worker's deque
+    quint64 executed;         ///<
+  };
+
+  /**
+   * @brief Construct a new Concurrent Executor object
+   *
+   * @param workers 0 means one per hardware thread
+   */
+  explicit ConcurrentExecutor(int workers = 0);
+
+  /**
+   * @brief Destroy the Concurrent Executor object
+   *
+   */
+  ~ConcurrentExecutor();
+
+  /**
+   * @brief
+   *
+   */
+  void Start();
+
+  /**
+   * @brief run the remaining jobs and join all workers
+   *
+   */
+  void Stop();
+
+  /**
+   * @brief jobs posted from a worker go to its own deque, others are
+   * spread over the workers round-robin
+   *
+   * @param job
+   */
+  void Post(Job job);
+
+  /**
+   * @brief Get the Statistics object
+   *
+   * @return Statistics
+   */
+  auto GetStatistics() -> Statistics;
+
+ private:
+  class Impl;
+  SecureUniquePtr<Impl> p_;
+};
+
+}  // namespace GpgFrontend::Thread
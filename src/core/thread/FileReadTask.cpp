@@ -30,7 +30,9 @@
 
 namespace GpgFrontend::UI {
 
-constexpr size_t kBufferSize = 8192;
+// the reader adapts the size of the following chunks, see
+// PlainTextEditorPage::slot_insert_text
+constexpr qint64 kInitialChunkSize = 256 * 1024;
 
 FileReadTask::FileReadTask(QString path)
     : Task("file_read_task"), read_file_path_(std::move(path)) {
@@ -50,18 +52,17 @@ auto FileReadTask::Run() -> int {
       return -1;
     }
 
-    slot_read_bytes();
+    slot_read_bytes(kInitialChunkSize);
   } else {
     emit SignalFileBytesReadEnd();
   }
   return 0;
 }
 
-void FileReadTask::slot_read_bytes() {
-  QByteArray read_buffer;
+void FileReadTask::slot_read_bytes(qint64 chunk_size) {
   if (QByteArray read_buffer;
       !target_file_.atEnd() &&
-      (read_buffer = target_file_.read(kBufferSize)).size() > 0) {
+      (read_buffer = target_file_.read(chunk_size)).size() > 0) {
     emit SignalFileBytesRead(std::move(read_buffer));
   } else {
     emit SignalFileBytesReadEnd();
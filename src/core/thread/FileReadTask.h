@@ -49,7 +49,7 @@ class GF_CORE_EXPORT FileReadTask : public GpgFrontend::Thread::Task {
  signals:
   void SignalFileBytesRead(QByteArray bytes);
   void SignalFileBytesReadEnd();
-  void SignalFileBytesReadNext();
+  void SignalFileBytesReadNext(qint64 chunk_size);
 
  private:
   QString read_file_path_;
@@ -57,7 +57,7 @@ class GF_CORE_EXPORT FileReadTask : public GpgFrontend::Thread::Task {
   QEventLoop looper;
 
  private slots:
-  void slot_read_bytes();
+  void slot_read_bytes(qint64 chunk_size);
 };
 
 }  // namespace GpgFrontend::UI
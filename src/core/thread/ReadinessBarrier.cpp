@@ -0,0 +1,207 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "core/thread/ReadinessBarrier.h"
+
+#include <mutex>
+
+#include "core/utils/MemoryUtils.h"
+
+namespace GpgFrontend::Thread {
+
+class ReadinessBarrier::Impl {
+ public:
+  Impl() { timer_.start(); }
+
+  void AddStage(const QString& stage, const QStringList& dependencies) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& s = stage_locked(stage);
+    for (const auto& dep : dependencies) {
+      stage_locked(dep);
+      if (!s.dependencies.contains(dep)) s.dependencies.append(dep);
+    }
+  }
+
+  void Start(const QString& stage) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& s = stage_locked(stage);
+    if (s.started_ms < 0) s.started_ms = timer_.elapsed();
+  }
+
+  void Resolve(const QString& stage, bool succeed) {
+    QContainer<Callback> callbacks;
+    bool result = false;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto& s = stage_locked(stage);
+      if (s.reported || finished_) return;
+
+      s.reported = true;
+      s.done_ms = timer_.elapsed();
+      if (!succeed) {
+        s.state = -1;
+        s.resolved_ms = s.done_ms;
+        s.own_ms = s.started_ms >= 0 ? s.done_ms - s.started_ms : s.done_ms;
+        finished_ = true;
+      } else {
+        settle_locked();
+        finished_ = all_resolved_locked();
+      }
+
+      if (!finished_) return;
+      result = succeed;
+      succeed_ = succeed;
+      callbacks.swap(callbacks_);
+    }
+
+    for (const auto& cb : callbacks) cb(result);
+  }
+
+  void OnReady(Callback callback) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!finished_) {
+        callbacks_.push_back(std::move(callback));
+        return;
+      }
+    }
+    callback(succeed_);
+  }
+
+  auto IsReady() -> bool {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return finished_ && succeed_;
+  }
+
+  auto GetTimings() -> QContainer<StageTiming> {
+    std::lock_guard<std::mutex> lock(mutex_);
+    QContainer<StageTiming> timings;
+    for (const auto& name : order_) {
+      const auto& s = stages_[name];
+      timings.push_back(
+          {name, s.state, s.started_ms, s.resolved_ms, s.own_ms});
+    }
+    return timings;
+  }
+
+ private:
+  struct Stage {
+    QStringList dependencies;
+    bool reported = false;  ///< the work of the stage itself is done
+    int state = 0;
+    qint64 started_ms = -1;
+    qint64 done_ms = -1;  ///< when the work was reported done
+    qint64 resolved_ms = -1;
+    qint64 own_ms = -1;
+  };
+
+  std::mutex mutex_;
+  QElapsedTimer timer_;
+  QHash<QString, Stage> stages_;
+  QStringList order_;
+  QContainer<Callback> callbacks_;
+  bool finished_ = false;
+  bool succeed_ = false;
+
+  auto stage_locked(const QString& name) -> Stage& {
+    auto it = stages_.find(name);
+    if (it == stages_.end()) {
+      order_.append(name);
+      it = stages_.insert(name, Stage{});
+    }
+    return it.value();
+  }
+
+  /**
+   * @brief resolve every reported stage whose dependencies are resolved,
+   * until nothing changes
+   *
+   */
+  void settle_locked() {
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      for (const auto& name : order_) {
+        auto& s = stages_[name];
+        if (!s.reported || s.state != 0) continue;
+
+        qint64 deps_resolved_ms = 0;
+        bool ready = true;
+        for (const auto& dep : s.dependencies) {
+          const auto& d = stages_[dep];
+          if (d.state != 1) {
+            ready = false;
+            break;
+          }
+          deps_resolved_ms = std::max(deps_resolved_ms, d.resolved_ms);
+        }
+        if (!ready) continue;
+
+        s.state = 1;
+        s.resolved_ms = timer_.elapsed();
+        s.own_ms = s.started_ms >= 0 ? s.done_ms - s.started_ms
+                                     : s.resolved_ms - deps_resolved_ms;
+        changed = true;
+      }
+    }
+  }
+
+  auto all_resolved_locked() -> bool {
+    for (const auto& s : stages_) {
+      if (s.state != 1) return false;
+    }
+    return true;
+  }
+};
+
+ReadinessBarrier::ReadinessBarrier() : p_(SecureCreateUniqueObject<Impl>()) {}
+
+ReadinessBarrier::~ReadinessBarrier() = default;
+
+void ReadinessBarrier::AddStage(const QString& stage,
+                                const QStringList& dependencies) {
+  p_->AddStage(stage, dependencies);
+}
+
+void ReadinessBarrier::Start(const QString& stage) { p_->Start(stage); }
+
+void ReadinessBarrier::Resolve(const QString& stage, bool succeed) {
+  p_->Resolve(stage, succeed);
+}
+
+void ReadinessBarrier::OnReady(Callback callback) {
+  p_->OnReady(std::move(callback));
+}
+
+auto ReadinessBarrier::IsReady() -> bool { return p_->IsReady(); }
+
+auto ReadinessBarrier::GetTimings() -> QContainer<StageTiming> {
+  return p_->GetTimings();
+}
+
+}  // namespace GpgFrontend::Thread
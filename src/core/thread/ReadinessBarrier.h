@@ -0,0 +1,122 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include "core/GpgFrontendCore.h"
+#include "core/function/SecureMemoryAllocator.h"
+
+namespace GpgFrontend::Thread {
+
+/**
+ * @brief a set of named stages with dependencies between them. A stage
+ * resolves once it is reported done and all of its dependencies are
+ * resolved, the barrier opens the moment the last stage resolves. All
+ * methods are thread-safe, callbacks run on the thread that resolved the
+ * last stage.
+ *
+ */
+class GF_CORE_EXPORT ReadinessBarrier {
+ public:
+  using Callback = std::function<void(bool)>;
+
+  struct StageTiming {
+    QString stage;       ///<
+    int state;           ///< 0 pending, 1 resolved, -1 failed
+    qint64 started_ms;   ///< since the barrier was created, -1 if unknown
+    qint64 resolved_ms;  ///< since the barrier was created
+    qint64 own_ms;       ///< since it started, or since its last dependency
+                         ///< resolved if its start wasn't reported
+  };
+
+  /**
+   * @brief Construct a new Readiness Barrier object
+   *
+   */
+  ReadinessBarrier();
+
+  /**
+   * @brief Destroy the Readiness Barrier object
+   *
+   */
+  ~ReadinessBarrier();
+
+  /**
+   * @brief declare a stage, dependencies may be declared later
+   *
+   * @param stage
+   * @param dependencies
+   */
+  void AddStage(const QString& stage, const QStringList& dependencies = {});
+
+  /**
+   * @brief report that the work of the stage begins. repeated reports are
+   * ignored.
+   *
+   * @param stage
+   */
+  void Start(const QString& stage);
+
+  /**
+   * @brief report the work of the stage as done. reporting a failure fails
+   * the barrier at once. repeated reports are ignored.
+   *
+   * @param stage
+   * @param succeed
+   */
+  void Resolve(const QString& stage, bool succeed = true);
+
+  /**
+   * @brief called once with true when all stages are resolved, or with
+   * false on the first failure. called at once if that already happened.
+   *
+   * @param callback
+   */
+  void OnReady(Callback callback);
+
+  /**
+   * @brief
+   *
+   * @return true
+   * @return false
+   */
+  auto IsReady() -> bool;
+
+  /**
+   * @brief timings of all stages in the order they were declared
+   *
+   * @return QContainer<StageTiming>
+   */
+  auto GetTimings() -> QContainer<StageTiming>;
+
+ private:
+  class Impl;
+  SecureUniquePtr<Impl> p_;
+};
+
+}  // namespace GpgFrontend::Thread
@@ -216,6 +216,13 @@ auto Task::TaskHandler::GetTask() -> Task * {
 }
 
 void Task::slot_exception_safe_run() noexcept {
+  auto rtn = exception_safe_run();
+
+  // raise signal to anounce after runnable returned
+  if (this->autoDelete()) emit this->SignalTaskShouldEnd(rtn);
+}
+
+auto Task::exception_safe_run() noexcept -> int {
   auto rtn = p_->GetRTN();
   try {
     // Run() will set rtn by itself
@@ -224,9 +231,7 @@ void Task::slot_exception_safe_run() noexcept {
   } catch (...) {
     LOG_W() << "exception was caught at task: {}" << GetFullID();
   }
-
-  // raise signal to anounce after runnable returned
-  if (this->autoDelete()) emit this->SignalTaskShouldEnd(rtn);
+  return rtn;
 }
 
 auto Task::GetRTN() -> int { return p_->GetRTN(); }
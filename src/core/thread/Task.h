@@ -170,6 +170,14 @@ class GF_CORE_EXPORT Task : public QObject, public QRunnable {
   class Impl;
   SecureUniquePtr<Impl> p_;
 
+  /**
+   * @brief run the runnable and swallow its exceptions, it may be called
+   * on any thread.
+   *
+   * @return int
+   */
+  auto exception_safe_run() noexcept -> int;
+
   void run() override;
 };
 }  // namespace GpgFrontend::Thread
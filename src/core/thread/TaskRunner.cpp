@@ -29,6 +29,7 @@
 #include "core/thread/TaskRunner.h"
 
 #include "core/thread/Task.h"
+#include "core/thread/TaskRunnerGetter.h"
 
 namespace GpgFrontend::Thread {
 
@@ -44,6 +45,7 @@ class TaskRunner::Impl : public QThread {
 
     task->setParent(nullptr);
     task->moveToThread(this);
+    track_pending_task(task);
 
     task->SafelyRun();
   }
@@ -54,6 +56,7 @@ class TaskRunner::Impl : public QThread {
     auto* raw_task = new Task(runnerable, name, std::move(params), cb);
     raw_task->setParent(nullptr);
     raw_task->moveToThread(this);
+    track_pending_task(raw_task);
 
     connect(raw_task, &Task::SignalRun, this, [this, raw_task]() {
       pending_tasks_[raw_task->GetFullID()] = raw_task;
@@ -77,27 +80,66 @@ class TaskRunner::Impl : public QThread {
       return;
     }
 
-    auto* concurrent_thread = new QThread(this);
-
+    // the task object stays on this thread, whose event loop handles its
+    // signals and deletion, only the runnable is executed by the workers
     task->setParent(nullptr);
-    task->moveToThread(concurrent_thread);
-
-    connect(task, &Task::SignalTaskEnd, concurrent_thread, &QThread::quit);
-    connect(concurrent_thread, &QThread::finished, concurrent_thread,
-            &QThread::deleteLater);
+    task->moveToThread(this);
+    track_pending_task(task);
+
+    // the task can't end before its runnable returned, so it is still
+    // alive on the worker; the end is announced from its own thread
+    TaskRunnerGetter::GetInstance().GetConcurrentExecutor()->Post([task]() {
+      auto rtn = task->exception_safe_run();
+      QMetaObject::invokeMethod(
+          task,
+          [task, rtn]() {
+            if (task->autoDelete()) emit task->SignalTaskShouldEnd(rtn);
+          },
+          Qt::QueuedConnection);
+    });
+  }
 
-    concurrent_thread->start();
+  void PostScheduleTask(Task* task, size_t seconds) {
+    if (task == nullptr) {
+      FLOG_W("task posted is null");
+      return;
+    }
 
-    task->SafelyRun();
+    task->setParent(nullptr);
+    task->moveToThread(this);
+    track_pending_task(task);
+
+    // SafelyRun() only queues the task to this thread, it's fine to call it
+    // from the scheduler thread
+    auto p_task = QPointer<Task>(task);
+    TaskRunnerGetter::GetInstance().GetTaskScheduler()->PostDelayedTask(
+        task->GetFullID(), nullptr,
+        [p_task]() {
+          if (p_task != nullptr) p_task->SafelyRun();
+        },
+        static_cast<qint64>(seconds) * 1000);
   }
 
-  void PostScheduleTask(Task* task, size_t seconds) {
-    if (task == nullptr) return;
-    // TODO
+  [[nodiscard]] auto GetPendingTaskCount() const -> int {
+    return pending_task_count_;
   }
 
  private:
   QMap<QString, Task*> pending_tasks_;
+  std::atomic_int pending_task_count_ = 0;
+
+  void track_pending_task(Task* task) {
+    pending_task_count_++;
+
+    // a cancelled task may announce its end more than once
+    auto ended = QSharedPointer<std::atomic_bool>::create(false);
+    connect(
+        task, &Task::SignalTaskEnd, this,
+        [this, ended]() {
+          if (!ended->exchange(true)) pending_task_count_--;
+        },
+        Qt::DirectConnection);
+  }
 };
 
 TaskRunner::TaskRunner() : p_(SecureCreateUniqueObject<Impl>()) {}
@@ -134,6 +176,10 @@ auto TaskRunner::GetThread() -> QThread* { return p_.get(); }
 
 auto TaskRunner::IsRunning() -> bool { return p_->isRunning(); }
 
+auto TaskRunner::GetPendingTaskCount() -> int {
+  return p_->GetPendingTaskCount();
+}
+
 auto TaskRunner::RegisterTask(const QString& name,
                               const Task::TaskRunnable& runnable,
                               const Task::TaskCallback& cb,
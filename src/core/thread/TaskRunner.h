@@ -76,6 +76,14 @@ class GF_CORE_EXPORT TaskRunner : public QObject {
    */
   auto IsRunning() -> bool;
 
+  /**
+   * @brief Get the number of tasks posted or registered to this runner
+   * which have not ended yet
+   *
+   * @return int
+   */
+  auto GetPendingTaskCount() -> int;
+
   /**
    * @brief
    *
@@ -102,7 +110,10 @@ class GF_CORE_EXPORT TaskRunner : public QObject {
       -> Task::TaskHandler;
 
   /**
-   * @brief
+   * @brief run the runnable of the task on a worker of the concurrent
+   * executor. The task object itself stays on this runner, its callback
+   * and end signal are delivered as with PostTask(). The runnable must not
+   * wait for other concurrent tasks, the executor has a fixed size.
    *
    * @param task
    */
@@ -41,6 +41,11 @@ TaskRunnerGetter::TaskRunnerGetter(int)
 auto TaskRunnerGetter::GetTaskRunner(TaskRunnerType runner_type)
     -> TaskRunnerPtr {
   std::lock_guard<std::mutex> lock_guard(task_runners_map_lock_);
+  if (runner_type == kTaskRunnerType_GPG_Worker ||
+      runner_type == kTaskRunnerType_Key_Database) {
+    return get_pooled_task_runner(runner_type);
+  }
+
   while (true) {
     auto it = task_runners_.find(runner_type);
     if (it != task_runners_.end()) {
@@ -53,12 +58,69 @@ auto TaskRunnerGetter::GetTaskRunner(TaskRunnerType runner_type)
   }
 }
 
+auto TaskRunnerGetter::get_pooled_task_runner(TaskRunnerType runner_type)
+    -> TaskRunnerPtr {
+  auto& pool = task_runner_pools_[runner_type];
+
+  if (pool.isEmpty()) {
+    // loading key databases mostly waits for gpg, a few runners are enough
+    const auto size = runner_type == kTaskRunnerType_Key_Database
+                          ? 4
+                          : std::max(2, QThread::idealThreadCount());
+    for (int i = 0; i < size; i++) {
+      auto runner = GpgFrontend::SecureCreateSharedObject<TaskRunner>();
+      pool.append(runner);
+      runner->Start();
+    }
+  }
+
+  // ties go to the runner created first, so a mostly idle pool keeps
+  // reusing the same threads (and their leased gpgme contexts)
+  auto target = pool.front();
+  for (const auto& runner : pool) {
+    if (runner->GetPendingTaskCount() < target->GetPendingTaskCount()) {
+      target = runner;
+    }
+  }
+  return target;
+}
+
+auto TaskRunnerGetter::GetTaskScheduler() -> QSharedPointer<TaskScheduler> {
+  std::lock_guard<std::mutex> lock_guard(task_runners_map_lock_);
+  if (task_scheduler_ == nullptr) {
+    task_scheduler_ = GpgFrontend::SecureCreateSharedObject<TaskScheduler>();
+    task_scheduler_->Start();
+  }
+  return task_scheduler_;
+}
+
+auto TaskRunnerGetter::GetConcurrentExecutor()
+    -> QSharedPointer<ConcurrentExecutor> {
+  std::lock_guard<std::mutex> lock_guard(task_runners_map_lock_);
+  if (concurrent_executor_ == nullptr) {
+    concurrent_executor_ =
+        GpgFrontend::SecureCreateSharedObject<ConcurrentExecutor>();
+    concurrent_executor_->Start();
+  }
+  return concurrent_executor_;
+}
+
 void TaskRunnerGetter::StopAllTeakRunner() {
+  // stop the scheduler first, so it won't post to stopped runners
+  if (task_scheduler_ != nullptr) task_scheduler_->Stop();
+  if (concurrent_executor_ != nullptr) concurrent_executor_->Stop();
+
   for (const auto& [key, value] : task_runners_) {
     if (value->IsRunning()) {
       value->Stop();
     }
   }
+
+  for (const auto& [key, pool] : task_runner_pools_) {
+    for (const auto& runner : pool) {
+      if (runner->IsRunning()) runner->Stop();
+    }
+  }
 }
 
 }  // namespace GpgFrontend::Thread
\ No newline at end of file
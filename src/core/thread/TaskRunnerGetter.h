@@ -32,7 +32,9 @@
 
 #include "core/GpgFrontendCore.h"
 #include "core/function/basic/GpgFunctionObject.h"
+#include "core/thread/ConcurrentExecutor.h"
 #include "core/thread/TaskRunner.h"
+#include "core/thread/TaskScheduler.h"
 
 namespace GpgFrontend::Thread {
 
@@ -48,19 +50,56 @@ class GF_CORE_EXPORT TaskRunnerGetter
     kTaskRunnerType_Network,
     kTaskRunnerType_Module,
     kTaskRunnerType_External_Process,
+    kTaskRunnerType_GPG_Worker,
+    kTaskRunnerType_Key_Database,
   };
 
   explicit TaskRunnerGetter(
       int channel = SingletonFunctionObject::GetDefaultChannel());
 
+  /**
+   * @brief Get the Task Runner object. Pooled runner types
+   * (kTaskRunnerType_GPG_Worker and kTaskRunnerType_Key_Database) hand out
+   * the least busy runner of the pool.
+   *
+   * @param runner_type
+   * @return TaskRunnerPtr
+   */
   auto GetTaskRunner(TaskRunnerType runner_type = kTaskRunnerType_Default)
       -> TaskRunnerPtr;
 
+  /**
+   * @brief Get the timer wheel shared by the core, use it instead of a
+   * QTimer on the gui thread for delayed or periodic background work.
+   *
+   * @return QSharedPointer<TaskScheduler>
+   */
+  auto GetTaskScheduler() -> QSharedPointer<TaskScheduler>;
+
+  /**
+   * @brief Get the work-stealing executor behind concurrent tasks, sized to
+   * the hardware concurrency
+   *
+   * @return QSharedPointer<ConcurrentExecutor>
+   */
+  auto GetConcurrentExecutor() -> QSharedPointer<ConcurrentExecutor>;
+
   void StopAllTeakRunner();
 
  private:
   std::map<TaskRunnerType, TaskRunnerPtr> task_runners_;
+  std::map<TaskRunnerType, QList<TaskRunnerPtr>> task_runner_pools_;
   std::mutex task_runners_map_lock_;
+  QSharedPointer<TaskScheduler> task_scheduler_;
+  QSharedPointer<ConcurrentExecutor> concurrent_executor_;
+
+  /**
+   * @brief
+   *
+   * @param runner_type
+   * @return TaskRunnerPtr
+   */
+  auto get_pooled_task_runner(TaskRunnerType runner_type) -> TaskRunnerPtr;
 };
 
 }  // namespace GpgFrontend::Thread
@@ -0,0 +1,366 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "core/thread/TaskScheduler.h"
+
+#include <mutex>
+
+namespace GpgFrontend::Thread {
+
+namespace {
+
+constexpr qint64 kTickMs = 10;
+constexpr int kWheelBits = 6;
+constexpr int kWheelSize = 1 << kWheelBits;
+constexpr int kWheelLevels = 4;
+constexpr qint64 kWheelSpan = qint64{1} << (kWheelBits * kWheelLevels);
+
+struct ScheduleEntry {
+  TaskScheduler::ScheduleID id;
+  QString name;
+  QString coalesce_key;
+  QSharedPointer<TaskRunner> runner;
+  TaskScheduler::Callback callback;
+  qint64 expires;   ///< tick
+  qint64 interval;  ///< tick, 0 for one-shot tasks
+  std::atomic_bool cancelled = false;
+  std::atomic_bool running = false;
+};
+
+using ScheduleEntryPtr = QSharedPointer<ScheduleEntry>;
+
+}  // namespace
+
+class TaskScheduler::Impl : public QThread {
+ public:
+  Impl() : QThread(nullptr), timer_(new QTimer()) {
+    timer_->setSingleShot(true);
+    timer_->setTimerType(Qt::PreciseTimer);
+    timer_->moveToThread(this);
+
+    connect(timer_, &QTimer::timeout, timer_, [this]() { slot_tick(); });
+    clock_.start();
+  }
+
+  ~Impl() override {
+    Stop();
+    delete timer_;
+  }
+
+  void Stop() {
+    quit();
+    wait();
+  }
+
+  auto Post(const QString& name, const QSharedPointer<TaskRunner>& runner,
+            Callback callback, qint64 delay_ms, qint64 interval_ms,
+            const QString& coalesce_key) -> ScheduleID {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    if (!coalesce_key.isEmpty()) {
+      auto it = coalesce_keys_.find(coalesce_key);
+      if (it != coalesce_keys_.end()) return it.value();
+    }
+
+    auto entry = ScheduleEntryPtr::create();
+    entry->id = ++last_id_;
+    entry->name = name;
+    entry->coalesce_key = coalesce_key;
+    entry->runner = runner;
+    entry->callback = std::move(callback);
+    entry->interval = interval_ms > 0 ? to_ticks(interval_ms) : 0;
+
+    // an empty wheel has not been advanced for a while, catch up first
+    if (entries_.isEmpty()) reset();
+    entry->expires = std::max(
+        now_tick() + to_ticks(std::max<qint64>(delay_ms, 0)), current_ + 1);
+
+    entries_.insert(entry->id, entry);
+    if (!coalesce_key.isEmpty()) coalesce_keys_.insert(coalesce_key, entry->id);
+    insert(entry);
+
+    if (entry->expires < armed_tick_) {
+      armed_tick_ = entry->expires;
+      lock.unlock();
+      QMetaObject::invokeMethod(
+          timer_, [this]() { rearm(); }, Qt::QueuedConnection);
+    }
+    return entry->id;
+  }
+
+  auto Cancel(ScheduleID id) -> bool {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // the entry stays in its slot and is dropped when the slot is visited
+    auto entry = entries_.take(id);
+    if (entry == nullptr) return false;
+
+    entry->cancelled = true;
+    if (!entry->coalesce_key.isEmpty()) {
+      coalesce_keys_.remove(entry->coalesce_key);
+    }
+    return true;
+  }
+
+  auto GetPendingTaskCount() -> int {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return static_cast<int>(entries_.size());
+  }
+
+ private:
+  std::mutex mutex_;
+  QTimer* timer_;
+  QElapsedTimer clock_;
+  qint64 current_ = 0;                                      ///< tick
+  qint64 armed_tick_ = std::numeric_limits<qint64>::max();  ///< tick
+  ScheduleID last_id_ = 0;
+  QHash<ScheduleID, ScheduleEntryPtr> entries_;
+  QHash<QString, ScheduleID> coalesce_keys_;
+  std::array<std::array<QList<ScheduleEntryPtr>, kWheelSize>, kWheelLevels>
+      wheel_;
+
+  static auto to_ticks(qint64 ms) -> qint64 {
+    return (ms + kTickMs - 1) / kTickMs;
+  }
+
+  auto now_tick() -> qint64 { return clock_.elapsed() / kTickMs; }
+
+  static auto slot_of(qint64 tick, int level) -> int {
+    return static_cast<int>((tick >> (kWheelBits * level)) & (kWheelSize - 1));
+  }
+
+  /**
+   * @brief drop the cancelled leftovers and jump to now. The caller must
+   * hold the lock.
+   *
+   */
+  void reset() {
+    for (auto& level : wheel_) {
+      for (auto& slot : level) slot.clear();
+    }
+    current_ = now_tick();
+  }
+
+  /**
+   * @brief put the entry into the lowest level whose range covers it. The
+   * caller must hold the lock.
+   *
+   */
+  void insert(const ScheduleEntryPtr& entry) {
+    // an entry cascaded on its own tick lands in the slot about to fire
+    auto expires = std::max(entry->expires, current_);
+    auto delta = expires - current_;
+
+    // beyond the top level, park it at the far end and re-cascade later
+    if (delta >= kWheelSpan) expires = current_ + kWheelSpan - 1;
+
+    int level = 0;
+    while (level < kWheelLevels - 1 &&
+           delta >= (qint64{1} << (kWheelBits * (level + 1)))) {
+      level++;
+    }
+    wheel_[level][slot_of(expires, level)].append(entry);
+  }
+
+  /**
+   * @brief move the entries of a higher level slot down the wheel. The
+   * caller must hold the lock.
+   *
+   */
+  void cascade(int level, int slot) {
+    auto entries = std::move(wheel_[level][slot]);
+    wheel_[level][slot].clear();
+
+    for (const auto& entry : entries) {
+      if (!entry->cancelled) insert(entry);
+    }
+  }
+
+  /**
+   * @brief advance the wheel by one tick and collect what became due. The
+   * caller must hold the lock.
+   *
+   */
+  void advance(QList<ScheduleEntryPtr>& due) {
+    current_++;
+
+    for (int level = 1; level < kWheelLevels; level++) {
+      if (slot_of(current_, level - 1) != 0) break;
+      cascade(level, slot_of(current_, level));
+    }
+
+    auto entries = std::move(wheel_[0][slot_of(current_, 0)]);
+    wheel_[0][slot_of(current_, 0)].clear();
+
+    for (const auto& entry : entries) {
+      if (entry->cancelled) continue;
+      if (entry->expires > current_) {
+        insert(entry);
+        continue;
+      }
+
+      due.append(entry);
+
+      if (entry->interval > 0) {
+        // missed intervals are coalesced into this single firing
+        entry->expires = std::max(entry->expires + entry->interval,
+                                  current_ + 1);
+        insert(entry);
+      } else {
+        entries_.remove(entry->id);
+        if (!entry->coalesce_key.isEmpty()) {
+          coalesce_keys_.remove(entry->coalesce_key);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief find the next tick on which the wheel has work to do. The
+   * caller must hold the lock.
+   *
+   * @return qint64 the tick, or max() if the wheel is empty
+   */
+  auto next_wake_tick() -> qint64 {
+    auto wake = std::numeric_limits<qint64>::max();
+    if (entries_.isEmpty()) return wake;
+
+    for (int i = 1; i <= kWheelSize; i++) {
+      if (!wheel_[0][slot_of(current_ + i, 0)].isEmpty()) {
+        wake = current_ + i;
+        break;
+      }
+    }
+
+    // a higher level slot is visited when its block begins
+    for (int level = 1; level < kWheelLevels; level++) {
+      const auto block = current_ >> (kWheelBits * level);
+      for (int i = 1; i <= kWheelSize; i++) {
+        const auto tick = (block + i) << (kWheelBits * level);
+        if (tick >= wake) break;
+        if (!wheel_[level][slot_of(tick, level)].isEmpty()) {
+          wake = tick;
+          break;
+        }
+      }
+    }
+    return wake;
+  }
+
+  void rearm() {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    armed_tick_ = next_wake_tick();
+    if (armed_tick_ == std::numeric_limits<qint64>::max()) {
+      timer_->stop();
+      return;
+    }
+
+    timer_->start(static_cast<int>(
+        std::clamp<qint64>(armed_tick_ * kTickMs - clock_.elapsed(), 0,
+                           std::numeric_limits<int>::max())));
+  }
+
+  void slot_tick() {
+    QList<ScheduleEntryPtr> due;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      const auto now = now_tick();
+      if (entries_.isEmpty()) reset();
+      while (current_ < now) advance(due);
+    }
+
+    for (const auto& entry : due) dispatch(entry);
+    rearm();
+  }
+
+  static void dispatch(const ScheduleEntryPtr& entry) {
+    // the last firing has not finished yet, fold this one into it
+    if (entry->running.exchange(true)) {
+      LOG_D() << "scheduled task" << entry->name
+              << "is still running, skip this firing";
+      return;
+    }
+
+    if (entry->runner == nullptr) {
+      run_entry(entry);
+      return;
+    }
+
+    entry->runner->PostTask(
+        entry->name,
+        [entry](const DataObjectPtr&) -> int {
+          run_entry(entry);
+          return 0;
+        },
+        nullptr, nullptr);
+  }
+
+  static void run_entry(const ScheduleEntryPtr& entry) {
+    try {
+      if (!entry->cancelled && entry->callback) entry->callback();
+    } catch (...) {
+      LOG_W() << "scheduled task" << entry->name << "caught exception";
+    }
+    entry->running = false;
+  }
+};
+
+TaskScheduler::TaskScheduler() : p_(SecureCreateUniqueObject<Impl>()) {}
+
+TaskScheduler::~TaskScheduler() = default;
+
+void TaskScheduler::Start() { p_->start(); }
+
+void TaskScheduler::Stop() { p_->Stop(); }
+
+auto TaskScheduler::PostDelayedTask(const QString& name,
+                                    const QSharedPointer<TaskRunner>& runner,
+                                    Callback callback, qint64 delay_ms,
+                                    const QString& coalesce_key)
+    -> ScheduleID {
+  return p_->Post(name, runner, std::move(callback), delay_ms, 0,
+                  coalesce_key);
+}
+
+auto TaskScheduler::PostPeriodicTask(const QString& name,
+                                     const QSharedPointer<TaskRunner>& runner,
+                                     Callback callback, qint64 interval_ms,
+                                     const QString& coalesce_key)
+    -> ScheduleID {
+  return p_->Post(name, runner, std::move(callback), interval_ms, interval_ms,
+                  coalesce_key);
+}
+
+auto TaskScheduler::Cancel(ScheduleID id) -> bool { return p_->Cancel(id); }
+
+auto TaskScheduler::GetPendingTaskCount() -> int {
+  return p_->GetPendingTaskCount();
+}
+
+}  // namespace GpgFrontend::Thread
@@ -0,0 +1,118 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#pragma once
+
+#include "core/GpgFrontendCore.h"
+#include "core/function/SecureMemoryAllocator.h"
+#include "core/thread/TaskRunner.h"
+
+namespace GpgFrontend::Thread {
+
+/**
+ * @brief a hierarchical timer wheel running on its own thread. Due
+ * callbacks are handed to a TaskRunner, so the wheel itself never blocks
+ * on the scheduled work.
+ *
+ */
+class GF_CORE_EXPORT TaskScheduler {
+ public:
+  using ScheduleID = quint64;
+  using Callback = std::function<void()>;
+
+  /**
+   * @brief Construct a new Task Scheduler object
+   *
+   */
+  TaskScheduler();
+
+  /**
+   * @brief Destroy the Task Scheduler object
+   *
+   */
+  ~TaskScheduler();
+
+  /**
+   * @brief
+   *
+   */
+  void Start();
+
+  /**
+   * @brief
+   *
+   */
+  void Stop();
+
+  /**
+   * @brief run the callback once on the runner after delay_ms. A null
+   * runner runs the callback on the scheduler thread, which is only meant
+   * for callbacks that hand the work to somewhere else.
+   *
+   * If coalesce_key is not empty and a task with the same key is still
+   * pending, no new task is created and the pending one's id is returned.
+   *
+   * @return ScheduleID
+   */
+  auto PostDelayedTask(const QString& name,
+                       const QSharedPointer<TaskRunner>& runner,
+                       Callback callback, qint64 delay_ms,
+                       const QString& coalesce_key = {}) -> ScheduleID;
+
+  /**
+   * @brief run the callback on the runner every interval_ms until it is
+   * cancelled. A firing is skipped while the previous one is still
+   * running, and missed firings are not replayed.
+   *
+   * @return ScheduleID
+   */
+  auto PostPeriodicTask(const QString& name,
+                        const QSharedPointer<TaskRunner>& runner,
+                        Callback callback, qint64 interval_ms,
+                        const QString& coalesce_key = {}) -> ScheduleID;
+
+  /**
+   * @brief
+   *
+   * @param id
+   * @return true if the task was still pending
+   */
+  auto Cancel(ScheduleID id) -> bool;
+
+  /**
+   * @brief Get the number of tasks waiting in the wheel
+   *
+   * @return int
+   */
+  auto GetPendingTaskCount() -> int;
+
+ private:
+  class Impl;
+  SecureUniquePtr<Impl> p_;
+};
+
+}  // namespace GpgFrontend::Thread
@@ -28,6 +28,7 @@
 
 #include "AsyncUtils.h"
 
+#include "core/function/gpg/GpgContext.h"
 #include "core/model/DataObject.h"
 #include "core/module/ModuleManager.h"
 #include "core/thread/Task.h"
@@ -36,9 +37,11 @@
 
 namespace GpgFrontend {
 
-auto RunGpgOperaAsync(int channel, const GpgOperaRunnable& runnable,
-                      const GpgOperationCallback& callback,
-                      const QString& operation, const QString& minimal_version)
+auto RunGpgOperaAsyncImpl(Thread::TaskRunnerGetter::TaskRunnerType runner_type,
+                          int channel, const GpgOperaRunnable& runnable,
+                          const GpgOperationCallback& callback,
+                          const QString& operation,
+                          const QString& minimal_version)
     -> Thread::Task::TaskHandler {
   if (!CheckGpgVersion(channel, minimal_version)) {
     LOG_W() << "operation: " << operation << "is not supported.";
@@ -46,12 +49,25 @@ auto RunGpgOperaAsync(int channel, const GpgOperaRunnable& runnable,
     return Thread::Task::TaskHandler(nullptr);
   }
 
+  const auto lease_contexts =
+      runner_type == Thread::TaskRunnerGetter::kTaskRunnerType_GPG_Worker;
+
   auto handler =
       Thread::TaskRunnerGetter::GetInstance()
-          .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_GPG)
+          .GetTaskRunner(runner_type)
           ->RegisterTask(
               operation,
               [=](const DataObjectPtr& data_object) -> int {
+                // workers run side by side, each one needs its own contexts
+                auto lease = lease_contexts
+                                 ? GpgContext::GetInstance(channel)
+                                       .LeaseContexts()
+                                 : GpgContextLease{};
+                if (lease_contexts && !lease.Good()) {
+                  data_object->Swap({lease.Error(), TransferParams()});
+                  return 0;
+                }
+
                 auto custom_data_object = TransferParams();
                 auto err = runnable(custom_data_object);
                 data_object->Swap({err, custom_data_object});
@@ -71,6 +87,25 @@ auto RunGpgOperaAsync(int channel, const GpgOperaRunnable& runnable,
   return handler;
 }
 
+auto RunGpgOperaAsync(int channel, const GpgOperaRunnable& runnable,
+                      const GpgOperationCallback& callback,
+                      const QString& operation, const QString& minimal_version)
+    -> Thread::Task::TaskHandler {
+  return RunGpgOperaAsyncImpl(Thread::TaskRunnerGetter::kTaskRunnerType_GPG,
+                              channel, runnable, callback, operation,
+                              minimal_version);
+}
+
+auto RunGpgOperaConcurrentAsync(int channel, const GpgOperaRunnable& runnable,
+                                const GpgOperationCallback& callback,
+                                const QString& operation,
+                                const QString& minimal_version)
+    -> Thread::Task::TaskHandler {
+  return RunGpgOperaAsyncImpl(
+      Thread::TaskRunnerGetter::kTaskRunnerType_GPG_Worker, channel, runnable,
+      callback, operation, minimal_version);
+}
+
 auto RunGpgOperaSync(int channel, const GpgOperaRunnable& runnable,
                      const QString& operation, const QString& minimal_version)
     -> std::tuple<GpgError, DataObjectPtr> {
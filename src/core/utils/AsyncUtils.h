@@ -50,6 +50,22 @@ auto GF_CORE_EXPORT RunGpgOperaAsync(int channel,
                                      const QString& minimal_version)
     -> Thread::Task::TaskHandler;
 
+/**
+ * @brief like RunGpgOperaAsync, but the operation is dispatched to the pool
+ * of gpg workers and runs on its own leased gpgme contexts, in parallel
+ * with other operations. Only use it for operations which don't modify the
+ * key database, those must stay ordered on the single gpg runner.
+ *
+ * @param runnable
+ * @param callback
+ * @param operation
+ * @param minimal_version
+ */
+auto GF_CORE_EXPORT RunGpgOperaConcurrentAsync(
+    int channel, const GpgOperaRunnable& runnable,
+    const GpgOperationCallback& callback, const QString& operation,
+    const QString& minimal_version) -> Thread::Task::TaskHandler;
+
 /**
  * @brief
  *
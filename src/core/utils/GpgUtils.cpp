@@ -28,6 +28,8 @@
 
 #include "GpgUtils.h"
 
+#include <mutex>
+
 #include "core/function/GlobalSettingStation.h"
 #include "core/function/gpg/GpgAbstractKeyGetter.h"
 #include "core/function/gpg/GpgComponentManager.h"
@@ -181,21 +183,18 @@ auto SetExtensionOfOutputFileForArchive(const QString& path, GpgOperation opera,
 }
 
 static QContainer<KeyDatabaseInfo> gpg_key_database_info_cache;
+static std::mutex gpg_key_database_info_cache_lock;
 
 auto GF_CORE_EXPORT GetGpgKeyDatabaseInfos() -> QContainer<KeyDatabaseInfo> {
-  if (!gpg_key_database_info_cache.empty()) return gpg_key_database_info_cache;
+  {
+    std::lock_guard<std::mutex> lock(gpg_key_database_info_cache_lock);
+    if (!gpg_key_database_info_cache.empty()) {
+      return gpg_key_database_info_cache;
+    }
+  }
 
+  QContainer<KeyDatabaseInfo> infos;
   auto context_index_list = Module::ListRTChildKeys("core", "gpgme.ctx.list");
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-  gpg_key_database_info_cache.resize(
-      static_cast<qsizetype>(context_index_list.size()));
-#else
-  gpg_key_database_info_cache.reserve(
-      static_cast<qsizetype>(context_index_list.size()));
-  std::fill_n(std::back_inserter(gpg_key_database_info_cache),
-              context_index_list.size(), KeyDatabaseInfo{});
-#endif
-
   for (auto& context_index : context_index_list) {
     LOG_D() << "context grt key: " << context_index;
 
@@ -207,6 +206,12 @@ auto GF_CORE_EXPORT GetGpgKeyDatabaseInfos() -> QContainer<KeyDatabaseInfo> {
     auto database_path = Module::RetrieveRTValueTypedOrDefault(
         "core", grt_key_prefix + ".database_path", QString{});
 
+    // skip key databases still loading in the background or failed,
+    // contexts created without the core init have no state
+    auto state = Module::RetrieveRTValueTypedOrDefault(
+        "core", QString("env.state.key_db.%1").arg(channel), 1);
+    if (channel < 0 || state != 1) continue;
+
     LOG_D() << "context grt channel: " << channel
             << "GRT key prefix: " << grt_key_prefix
             << "database name: " << database_name;
@@ -215,15 +220,28 @@ auto GF_CORE_EXPORT GetGpgKeyDatabaseInfos() -> QContainer<KeyDatabaseInfo> {
     i.channel = channel;
     i.name = database_name;
     i.path = database_path;
-    gpg_key_database_info_cache[channel] = i;
+    infos.push_back(i);
   }
 
-  return gpg_key_database_info_cache;
+  std::sort(infos.begin(), infos.end(),
+            [](const KeyDatabaseInfo& a, const KeyDatabaseInfo& b) {
+              return a.channel < b.channel;
+            });
+
+  // the list is final once every key database is loaded
+  if (Module::RetrieveRTValueTypedOrDefault("core", "env.state.key_dbs", 0) ==
+      1) {
+    std::lock_guard<std::mutex> lock(gpg_key_database_info_cache_lock);
+    gpg_key_database_info_cache = infos;
+  }
+  return infos;
 }
+
 auto GF_CORE_EXPORT GetGpgKeyDatabaseName(int channel) -> QString {
-  auto info = GetGpgKeyDatabaseInfos();
-  if (channel >= info.size()) return {};
-  return info[channel].name;
+  for (const auto& info : GetGpgKeyDatabaseInfos()) {
+    if (info.channel == channel) return info.name;
+  }
+  return {};
 }
 
 auto GetKeyDatabasesBySettings() -> QContainer<KeyDatabaseItemSO> {
@@ -381,17 +399,22 @@ auto GF_CORE_EXPORT ConvertKey2GpgKeyList(int channel,
 
 auto GF_CORE_EXPORT Convert2RawGpgMEKeyList(int channel,
                                             const GpgAbstractKeyPtrList& keys)
-    -> QContainer<gpgme_key_t> {
+    -> std::tuple<GpgError, QContainer<gpgme_key_t>> {
   QContainer<gpgme_key_t> recipients;
 
   auto g_keys = ConvertKey2GpgKeyList(channel, keys);
   for (const auto& key : g_keys) {
-    recipients.push_back(
-        static_cast<gpgme_key_t>(*qSharedPointerDynamicCast<GpgKey>(key)));
+    // a null entry would end the array early and drop the keys after it
+    auto* raw_key = static_cast<gpgme_key_t>(*key);
+    if (raw_key == nullptr) {
+      LOG_W() << "cannot resolve key" << key->ID() << "channel:" << channel;
+      return {GPG_ERR_NO_PUBKEY, {}};
+    }
+    recipients.push_back(raw_key);
   }
 
   recipients.push_back(nullptr);
-  return recipients;
+  return {GPG_ERR_NO_ERROR, recipients};
 }
 
 auto GF_CORE_EXPORT GetUsagesByAbstractKey(const GpgAbstractKey* key)
@@ -445,8 +468,11 @@ auto GF_CORE_EXPORT CheckGpgVersion(int channel, const QString& v) -> bool {
     return false;
   }
 
-  const auto gnupg_version = Module::RetrieveRTValueTypedOrDefault<>(
-      "core", "gpgme.ctx.gnupg_version", QString{});
+  // checked before every gpg operation, resolve the path only once
+  static const auto kGnupgVersionPath =
+      Module::InternRTPath("core", "gpgme.ctx.gnupg_version");
+  const auto gnupg_version =
+      Module::RetrieveRTValueTypedOrDefault<>(kGnupgVersionPath, QString{});
 
   if (gnupg_version.isEmpty() ||
       GFCompareSoftwareVersion(gnupg_version, v) < 0) {
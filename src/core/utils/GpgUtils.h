@@ -171,14 +171,16 @@ auto GF_CORE_EXPORT ConvertKey2GpgKeyList(int channel,
     -> GpgKeyPtrList;
 
 /**
- * @brief
+ * @brief resolve the keys to a null terminated gpgme key array
  *
+ * @param channel
  * @param keys
- * @return QContainer<gpgme_key_t>
+ * @return std::tuple<GpgError, QContainer<gpgme_key_t>> the array is empty
+ * if any key can't be resolved
  */
 auto GF_CORE_EXPORT Convert2RawGpgMEKeyList(int channel,
                                             const GpgAbstractKeyPtrList& keys)
-    -> QContainer<gpgme_key_t>;
+    -> std::tuple<GpgError, QContainer<gpgme_key_t>>;
 
 /**
  * @brief
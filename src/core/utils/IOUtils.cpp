@@ -28,22 +28,20 @@
 
 #include "IOUtils.h"
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
+
 #include "core/utils/FilesystemUtils.h"
 
 namespace GpgFrontend {
 
-auto GetFileChecksum(const QString& file_name,
-                     QCryptographicHash::Algorithm hashAlgorithm)
-    -> QByteArray {
-  QFile f(file_name);
-  if (f.open(QFile::ReadOnly)) {
-    QCryptographicHash hash(hashAlgorithm);
-    if (hash.addData(&f)) {
-      return hash.result();
-    }
-  }
-  return {};
-}
+// mapped per step, aligned to the page size of every supported platform
+constexpr qint64 kHashMapWindowSize = 64 * 1024 * 1024;
+// read per step when the file cannot be mapped
+constexpr qint64 kHashReadChunkSize = 4 * 1024 * 1024;
+// fed to every digest in turn, small enough to stay in the cpu cache
+constexpr qint64 kHashBlockSize = 256 * 1024;
 
 auto ReadFile(const QString& file_name, QByteArray& data) -> bool {
   QFile file(file_name);
@@ -78,13 +76,109 @@ auto WriteFileGFBuffer(const QString& file_name, GFBuffer data) -> bool {
   return WriteFile(file_name, data.ConvertToQByteArray());
 }
 
-auto CalculateHash(const QString& file_path) -> QString {
+auto CalculateFileDigests(
+    const QString& file_path,
+    const QContainer<QCryptographicHash::Algorithm>& algorithms,
+    const HashProgressCallback& progress,
+    qint64 map_limit) -> QContainer<QByteArray> {
+  QFile file(file_path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    LOG_W() << "failed to open file: " << file_path;
+    return {};
+  }
+
+  std::vector<std::unique_ptr<QCryptographicHash>> hashes;
+  for (const auto& algorithm : algorithms) {
+    hashes.push_back(std::make_unique<QCryptographicHash>(algorithm));
+  }
+
+  const auto total = file.size();
+  QByteArray read_buffer;
+  qint64 offset = 0;
+
+  while (offset < total) {
+    const char* data = nullptr;
+    qint64 length = std::min(kHashMapWindowSize, total - offset);
+
+    uchar* mapped = nullptr;
+    if (map_limit < 0 || offset + length <= map_limit) {
+      mapped = file.map(offset, length);
+    }
+
+    if (mapped != nullptr) {
+#if defined(__unix__) || defined(__APPLE__)
+      posix_madvise(mapped, length, POSIX_MADV_SEQUENTIAL);
+#endif
+      data = reinterpret_cast<const char*>(mapped);
+    } else {
+      // mapping doesn't move the file position
+      if (!file.seek(offset)) {
+        LOG_W() << "failed to seek file: " << file_path << "to" << offset;
+        return {};
+      }
+
+      read_buffer.resize(std::min(kHashReadChunkSize, total - offset));
+      length = file.read(read_buffer.data(), read_buffer.size());
+      if (length <= 0) {
+        LOG_W() << "failed to read file: " << file_path;
+        return {};
+      }
+      data = read_buffer.constData();
+    }
+
+    for (qint64 block = 0; block < length; block += kHashBlockSize) {
+      const auto size = std::min(kHashBlockSize, length - block);
+      for (auto& hash : hashes) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+        hash->addData(QByteArrayView(data + block, size));
+#else
+        hash->addData(data + block, static_cast<int>(size));
+#endif
+      }
+    }
+
+    if (mapped != nullptr) file.unmap(mapped);
+
+    offset += length;
+    if (progress) progress(offset, total);
+  }
+
+  QContainer<QByteArray> digests;
+  for (auto& hash : hashes) digests.append(hash->result());
+  return digests;
+}
+
+auto CalculateHash(const QString& file_path,
+                   const HashProgressCallback& progress,
+                   bool extended) -> QString {
   // Returns empty QByteArray() on failure.
   QFileInfo const info(file_path);
   QString buffer;
   QTextStream ss(&buffer);
 
-  if (info.isFile() && info.isReadable()) {
+  QContainer<QPair<QString, QCryptographicHash::Algorithm>> algorithms{
+      {"MD5", QCryptographicHash::Md5},
+      {"SHA1", QCryptographicHash::Sha1},
+      {"SHA256", QCryptographicHash::Sha256},
+  };
+  if (extended) {
+    algorithms.append({"SHA512", QCryptographicHash::Sha512});
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    algorithms.append({"BLAKE2b-512", QCryptographicHash::Blake2b_512});
+#endif
+  }
+
+  QContainer<QCryptographicHash::Algorithm> digest_algorithms;
+  for (const auto& algorithm : algorithms) {
+    digest_algorithms.append(algorithm.second);
+  }
+
+  auto digests = info.isFile() && info.isReadable()
+                     ? CalculateFileDigests(file_path, digest_algorithms,
+                                            progress)
+                     : QContainer<QByteArray>{};
+
+  if (digests.size() == algorithms.size()) {
     ss << "# " << QCoreApplication::tr("File Hash Information") << Qt::endl;
     ss << "- " << QCoreApplication::tr("Filename") << QCoreApplication::tr(": ")
        << info.fileName() << Qt::endl;
@@ -98,20 +192,10 @@ auto CalculateHash(const QString& file_path) -> QString {
        << QCoreApplication::tr(": ") << GetHumanFriendlyFileSize(info.size())
        << Qt::endl;
 
-    // md5
-    ss << "- " << "MD5" << QCoreApplication::tr(": ")
-       << GetFileChecksum(file_path, QCryptographicHash::Md5).toHex()
-       << Qt::endl;
-
-    // sha1
-    ss << "- " << "SHA1" << QCoreApplication::tr(": ")
-       << GetFileChecksum(file_path, QCryptographicHash::Sha1).toHex()
-       << Qt::endl;
-
-    // sha1
-    ss << "- " << "SHA256" << QCoreApplication::tr(": ")
-       << GetFileChecksum(file_path, QCryptographicHash::Sha256).toHex()
-       << Qt::endl;
+    for (int i = 0; i < algorithms.size(); i++) {
+      ss << "- " << algorithms[i].first << QCoreApplication::tr(": ")
+         << digests[i].toHex() << Qt::endl;
+    }
 
     ss << Qt::endl;
 
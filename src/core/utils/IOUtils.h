@@ -29,6 +29,7 @@
 #pragma once
 
 #include "core/model/GFBuffer.h"
+#include "core/typedef/CoreTypedef.h"
 
 namespace GpgFrontend {
 
@@ -74,12 +75,36 @@ auto GF_CORE_EXPORT ReadFile(const QString &file_name, QByteArray &data)
 auto GF_CORE_EXPORT WriteFile(const QString &file_name, const QByteArray &data)
     -> bool;
 
+using HashProgressCallback = std::function<void(qint64 done, qint64 total)>;
+
+/**
+ * @brief digest a file with all the given algorithms while reading it only
+ * once, through memory mapped windows when possible
+ *
+ * @param file_path
+ * @param algorithms
+ * @param progress called after each chunk, may be empty
+ * @param map_limit bytes from the start of the file which may be mapped,
+ * the rest is read in chunks; -1 means no limit
+ * @return QContainer<QByteArray> one digest per algorithm, empty on failure
+ */
+auto GF_CORE_EXPORT CalculateFileDigests(
+    const QString &file_path,
+    const QContainer<QCryptographicHash::Algorithm> &algorithms,
+    const HashProgressCallback &progress = nullptr, qint64 map_limit = -1)
+    -> QContainer<QByteArray>;
+
 /**
  * calculate the hash of a file
  * @param file_path
+ * @param progress
+ * @param extended also calculate SHA512 (and BLAKE2b with Qt6)
  * @return
  */
-auto GF_CORE_EXPORT CalculateHash(const QString &file_path) -> QString;
+auto GF_CORE_EXPORT
+CalculateHash(const QString &file_path,
+              const HashProgressCallback &progress = nullptr,
+              bool extended = false) -> QString;
 
 /**
  * @brief
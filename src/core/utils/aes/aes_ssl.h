@@ -66,4 +66,43 @@ uint8_t *aes_256_cbc_encrypt(EVP_CIPHER_CTX *e, uint8_t *plaintext, int *len);
  */
 uint8_t *aes_256_cbc_decrypt(EVP_CIPHER_CTX *e, uint8_t *ciphertext, int *len);
 
+/**
+ * @brief AES-256-GCM encryption, uses the AES instructions of the cpu when
+ * OpenSSL finds them. ciphertext has the size of the plaintext.
+ *
+ * @param key 32 bytes
+ * @param iv
+ * @param iv_len
+ * @param aad additional authenticated data, may be nullptr
+ * @param aad_len
+ * @param plaintext
+ * @param len
+ * @param ciphertext
+ * @param tag 16 bytes
+ * @return true on success
+ */
+bool aes_256_gcm_encrypt(const uint8_t *key, const uint8_t *iv, int iv_len,
+                         const uint8_t *aad, int aad_len,
+                         const uint8_t *plaintext, int len,
+                         uint8_t *ciphertext, uint8_t *tag);
+
+/**
+ * @brief AES-256-GCM decryption
+ *
+ * @param key 32 bytes
+ * @param iv
+ * @param iv_len
+ * @param aad additional authenticated data, may be nullptr
+ * @param aad_len
+ * @param ciphertext
+ * @param len
+ * @param tag 16 bytes
+ * @param plaintext
+ * @return true if the tag matched
+ */
+bool aes_256_gcm_decrypt(const uint8_t *key, const uint8_t *iv, int iv_len,
+                         const uint8_t *aad, int aad_len,
+                         const uint8_t *ciphertext, int len, const uint8_t *tag,
+                         uint8_t *plaintext);
+
 }  // namespace GpgFrontend::RawAPI
@@ -0,0 +1,120 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "aes_ssl.h"
+
+#include <memory>
+
+namespace GpgFrontend::RawAPI {
+
+namespace {
+
+constexpr int kGcmTagSize = 16;
+
+using CipherCtxPtr =
+    std::unique_ptr<EVP_CIPHER_CTX, decltype(&EVP_CIPHER_CTX_free)>;
+
+auto NewCipherCtx() -> CipherCtxPtr {
+  return {EVP_CIPHER_CTX_new(), &EVP_CIPHER_CTX_free};
+}
+
+}  // namespace
+
+bool aes_256_gcm_encrypt(const uint8_t *key, const uint8_t *iv, int iv_len,
+                         const uint8_t *aad, int aad_len,
+                         const uint8_t *plaintext, int len,
+                         uint8_t *ciphertext, uint8_t *tag) {
+  auto ctx = NewCipherCtx();
+  if (ctx == nullptr) return false;
+
+  int out_len = 0;
+  if (EVP_EncryptInit_ex(ctx.get(), EVP_aes_256_gcm(), nullptr, nullptr,
+                         nullptr) != 1 ||
+      EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_SET_IVLEN, iv_len,
+                          nullptr) != 1 ||
+      EVP_EncryptInit_ex(ctx.get(), nullptr, nullptr, key, iv) != 1) {
+    return false;
+  }
+
+  if (aad != nullptr && aad_len > 0 &&
+      EVP_EncryptUpdate(ctx.get(), nullptr, &out_len, aad, aad_len) != 1) {
+    return false;
+  }
+
+  int c_len = 0;
+  if (len > 0 &&
+      EVP_EncryptUpdate(ctx.get(), ciphertext, &c_len, plaintext, len) != 1) {
+    return false;
+  }
+
+  // gcm is a stream mode, final doesn't produce any more output
+  if (EVP_EncryptFinal_ex(ctx.get(), ciphertext + c_len, &out_len) != 1) {
+    return false;
+  }
+
+  return EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_GET_TAG, kGcmTagSize,
+                             tag) == 1;
+}
+
+bool aes_256_gcm_decrypt(const uint8_t *key, const uint8_t *iv, int iv_len,
+                         const uint8_t *aad, int aad_len,
+                         const uint8_t *ciphertext, int len, const uint8_t *tag,
+                         uint8_t *plaintext) {
+  auto ctx = NewCipherCtx();
+  if (ctx == nullptr) return false;
+
+  int out_len = 0;
+  if (EVP_DecryptInit_ex(ctx.get(), EVP_aes_256_gcm(), nullptr, nullptr,
+                         nullptr) != 1 ||
+      EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_SET_IVLEN, iv_len,
+                          nullptr) != 1 ||
+      EVP_DecryptInit_ex(ctx.get(), nullptr, nullptr, key, iv) != 1) {
+    return false;
+  }
+
+  if (aad != nullptr && aad_len > 0 &&
+      EVP_DecryptUpdate(ctx.get(), nullptr, &out_len, aad, aad_len) != 1) {
+    return false;
+  }
+
+  int p_len = 0;
+  if (len > 0 &&
+      EVP_DecryptUpdate(ctx.get(), plaintext, &p_len, ciphertext, len) != 1) {
+    return false;
+  }
+
+  if (EVP_CIPHER_CTX_ctrl(ctx.get(), EVP_CTRL_GCM_SET_TAG, kGcmTagSize,
+                          const_cast<uint8_t *>(tag)) != 1) {
+    return false;
+  }
+
+  // fails if the data or the tag was tampered with
+  return EVP_DecryptFinal_ex(ctx.get(), plaintext + p_len, &out_len) == 1;
+}
+
+}  // namespace GpgFrontend::RawAPI
@@ -95,6 +95,7 @@ void InitGpgFrontendCoreAsync(CoreInitArgs core_init_args) {
             // then load core
             if (InitGpgFrontendCore(core_init_args) != 0) {
               Module::UpsertRTValue("core", "env.state.basic", -1);
+              ResolveCoreInitStage("basic", false);
               QTextStream(stdout)
                   << "Fatal: InitGpgFrontendCore() Failed" << Qt::endl;
             };
@@ -112,6 +113,9 @@ void InitGlobalBasicEnv(const GFCxtWPtr &p_ctx, bool gui_mode) {
   // change path to search for related
   InitGlobalPathEnv();
 
+  // monitor, before any stage of the initialization begins
+  StartMonitorCoreInitializationStatus();
+
   // should load module system first
   Module::ModuleInitArgs module_init_args;
   Module::LoadGpgFrontendModules(module_init_args);
@@ -124,9 +128,6 @@ void InitGlobalBasicEnv(const GFCxtWPtr &p_ctx, bool gui_mode) {
   core_init_args.unit_test_mode = ctx->unit_test_mode;
 
   InitGpgFrontendCoreAsync(core_init_args);
-
-  // monitor
-  StartMonitorCoreInitializationStatus();
 }
 
 /**
@@ -74,4 +74,48 @@ TEST_F(GpgCoreTest, CoreAssuanConnectTestB) {
 
   LOG_D() << "status lines of command keyinfo --list: " << status;
 }
+
+TEST_F(GpgCoreTest, CoreAssuanBatchCommandTest) {
+  auto& helper = GpgAssuanHelper::GetInstance();
+
+  auto results = helper.SendCommands(
+      GpgComponentType::kGPG_AGENT,
+      {"GETINFO version", "keyinfo --list", "GETINFO pid"});
+  ASSERT_EQ(results.size(), 3);
+
+  ASSERT_TRUE(results[0].Good());
+  ASSERT_FALSE(results[0].data.isEmpty());
+  ASSERT_TRUE(results[1].Good());
+  ASSERT_TRUE(results[1].status.front().startsWith("KEYINFO"));
+  ASSERT_TRUE(results[2].Good());
+  ASSERT_FALSE(results[2].data.isEmpty());
+
+  // the failing command stops the batch
+  results = helper.SendCommands(GpgComponentType::kGPG_AGENT,
+                                {"NO_SUCH_COMMAND", "GETINFO pid"});
+  ASSERT_EQ(results.size(), 1);
+  ASSERT_FALSE(results.front().Good());
+
+  results = helper.SendCommands(GpgComponentType::kGPG_AGENT,
+                                {"NO_SUCH_COMMAND", "GETINFO pid"}, false);
+  ASSERT_EQ(results.size(), 2);
+  ASSERT_TRUE(results.back().Good());
+}
+
+TEST_F(GpgCoreTest, CoreAssuanReconnectTest) {
+  auto& helper = GpgAssuanHelper::GetInstance();
+
+  auto [ret, data] =
+      helper.SendDataCommand(GpgComponentType::kGPG_AGENT, "GETINFO pid");
+  ASSERT_EQ(ret, GPG_ERR_NO_ERROR);
+  ASSERT_FALSE(data.isEmpty());
+
+  // a reset drops the pooled connections, the next command reconnects
+  helper.ResetAllConnections();
+
+  auto [ret_2, data_2] =
+      helper.SendDataCommand(GpgComponentType::kGPG_AGENT, "GETINFO pid");
+  ASSERT_EQ(ret_2, GPG_ERR_NO_ERROR);
+  ASSERT_EQ(data, data_2);
+}
 }  // namespace GpgFrontend::Test
\ No newline at end of file
@@ -0,0 +1,132 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include "GpgCoreTest.h"
+#include "core/thread/AsyncBatch.h"
+#include "core/thread/ConcurrentExecutor.h"
+
+namespace GpgFrontend::Test {
+
+TEST_F(GpgCoreTest, CoreAsyncBatchParallelismTest) {
+  Thread::ConcurrentExecutor executor(8);
+  executor.Start();
+
+  std::atomic_int in_flight = 0;
+  std::atomic_int max_in_flight = 0;
+
+  Thread::AsyncBatch batch(
+      64, 3, [&](qsizetype, const Thread::AsyncBatch::DoneHandler& done) {
+        auto current = ++in_flight;
+        auto max = max_in_flight.load();
+        while (current > max &&
+               !max_in_flight.compare_exchange_weak(max, current)) {
+        }
+
+        executor.Post([&, done]() {
+          std::this_thread::sleep_for(std::chrono::milliseconds(2));
+          --in_flight;
+          done();
+        });
+      });
+
+  std::promise<void> finished;
+  batch.OnFinished([&]() { finished.set_value(); });
+  batch.Start();
+  finished.get_future().wait();
+  executor.Stop();
+
+  ASSERT_LE(max_in_flight.load(), 3);
+
+  auto statistics = batch.GetStatistics();
+  ASSERT_EQ(statistics.total, 64);
+  ASSERT_EQ(statistics.done, 64);
+  ASSERT_EQ(statistics.skipped, 0);
+  ASSERT_EQ(statistics.max_in_flight, 3);
+  for (const auto& ms : statistics.item_ms) ASSERT_GE(ms, 0);
+}
+
+TEST_F(GpgCoreTest, CoreAsyncBatchCancelTest) {
+  Thread::ConcurrentExecutor executor(4);
+  executor.Start();
+
+  std::atomic_int started = 0;
+  std::promise<void> finished;
+
+  Thread::AsyncBatch* p_batch = nullptr;
+  Thread::AsyncBatch batch(
+      128, 2, [&](qsizetype, const Thread::AsyncBatch::DoneHandler& done) {
+        started++;
+        executor.Post([done]() {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          done();
+        });
+      });
+  p_batch = &batch;
+
+  batch.OnProgress([&](qsizetype done, qsizetype) {
+    if (done == 8) p_batch->Cancel();
+  });
+  batch.OnFinished([&]() { finished.set_value(); });
+  batch.Start();
+  finished.get_future().wait();
+  executor.Stop();
+
+  auto statistics = batch.GetStatistics();
+  ASSERT_TRUE(batch.IsCancelled());
+  ASSERT_EQ(statistics.done, started.load());
+  ASSERT_LT(statistics.done, 128);
+  ASSERT_EQ(statistics.done + statistics.skipped, 128);
+}
+
+TEST_F(GpgCoreTest, CoreAsyncBatchSynchronousDoneTest) {
+  // items done before their starter returns must not recurse
+  qsizetype order_errors = 0;
+  qsizetype next = 0;
+  bool finished = false;
+
+  Thread::AsyncBatch batch(
+      100000, 4,
+      [&](qsizetype index, const Thread::AsyncBatch::DoneHandler& done) {
+        if (index != next++) order_errors++;
+        done();
+        done();  // a second call is ignored
+      });
+  batch.OnFinished([&]() { finished = true; });
+  batch.Start();
+
+  ASSERT_TRUE(finished);
+  ASSERT_EQ(order_errors, 0);
+  ASSERT_EQ(batch.GetStatistics().done, 100000);
+}
+
+}  // namespace GpgFrontend::Test
@@ -26,8 +26,11 @@
  *
  */
 
+#include <thread>
+
 #include "GpgCoreTest.h"
 #include "core/function/gpg/GpgBasicOperator.h"
+#include "core/function/gpg/GpgContext.h"
 #include "core/function/gpg/GpgKeyGetter.h"
 #include "core/function/result_analyse/GpgDecryptResultAnalyse.h"
 #include "core/model/GpgDecryptResult.h"
@@ -70,6 +73,48 @@ TEST_F(GpgCoreTest, CoreEncryptDecrTest) {
   ASSERT_EQ(decr_out_buffer, buffer);
 }
 
+TEST_F(GpgCoreTest, CoreConcurrentEncryptDecrTest) {
+  auto encrypt_key = GpgKeyGetter::GetInstance().GetPubkeyPtr(
+      "E87C6A2D8D95C818DE93B3AE6A2764F8298DEB29");
+  ASSERT_TRUE(encrypt_key != nullptr);
+
+  auto& ctx = GpgContext::GetInstance();
+  auto* shared_ctx = ctx.DefaultContext();
+
+  std::vector<std::thread> workers;
+  std::atomic_int succeed = 0;
+  for (int i = 0; i < 4; i++) {
+    workers.emplace_back([&, i]() {
+      auto lease = ctx.LeaseContexts();
+      if (!lease.Good() || ctx.DefaultContext() == shared_ctx) return;
+
+      // a nested lease keeps using the pair held by the thread
+      auto* leased_ctx = ctx.DefaultContext();
+      {
+        auto nested_lease = ctx.LeaseContexts();
+        if (!nested_lease.Good() || ctx.DefaultContext() != leased_ctx) return;
+      }
+      if (ctx.DefaultContext() != leased_ctx) return;
+
+      auto buffer = GFBuffer(QString("Hello GpgFrontend! %1").arg(i));
+      auto [err, data_object] =
+          GpgBasicOperator::GetInstance().EncryptSync({encrypt_key}, buffer,
+                                                      true);
+      if (CheckGpgError(err) != GPG_ERR_NO_ERROR) return;
+
+      auto [err_0, data_object_0] = GpgBasicOperator::GetInstance().DecryptSync(
+          ExtractParams<GFBuffer>(data_object, 1));
+      if (CheckGpgError(err_0) != GPG_ERR_NO_ERROR) return;
+
+      if (ExtractParams<GFBuffer>(data_object_0, 1) == buffer) succeed++;
+    });
+  }
+  for (auto& worker : workers) worker.join();
+
+  ASSERT_EQ(succeed.load(), 4);
+  ASSERT_EQ(ctx.DefaultContext(), shared_ctx);
+}
+
 TEST_F(GpgCoreTest, CoreEncryptSymmetricDecrTest) {
   auto encrypt_text = GFBuffer(QString("Hello GpgFrontend!"));
   auto [err, data_object] =
@@ -30,8 +30,13 @@
 #include <thread>
 
 #include "GpgCoreTest.h"
+#include "GpgCoreTestUtils.h"
 #include "core/GpgConstants.h"
 #include "core/function/CacheManager.h"
+#include "core/function/DataObjectOperator.h"
+#include "core/function/GlobalSettingStation.h"
+#include "core/module/ModuleManager.h"
+#include "core/utils/IOUtils.h"
 #include "core/utils/GpgUtils.h"
 
 namespace GpgFrontend::Test {
@@ -54,4 +59,148 @@ TEST_F(GpgCoreTest, CoreCacheTestC) {
   ASSERT_EQ(CacheManager::GetInstance().LoadCache("ABCDEF"), QString(""));
 }
 
-}  // namespace GpgFrontend::Test
\ No newline at end of file
+TEST_F(GpgCoreTest, CoreDataObjectTest) {
+  auto& op = DataObjectOperator::GetInstance();
+
+  QJsonObject obj;
+  obj["name"] = "data object";
+  obj["size"] = 42;
+
+  auto ref = op.SaveDataObj({}, QJsonDocument(obj));
+  ASSERT_EQ(ref.size(), 64);
+
+  auto doc = op.GetDataObjectByRef(ref);
+  ASSERT_TRUE(doc.has_value());
+  ASSERT_EQ(doc->object(), obj);
+
+  const auto data_path = GlobalSettingStation::GetInstance().GetAppDataPath();
+  const auto path = data_path + "/data_objs/" + ref;
+  QByteArray encoded;
+  ASSERT_TRUE(ReadFile(path, encoded));
+  ASSERT_TRUE(encoded.startsWith("GFDO"));
+  ASSERT_FALSE(encoded.contains("data object"));
+
+  QByteArray app_key;
+  ASSERT_TRUE(ReadFile(data_path + "/secure/app.key", app_key));
+  const auto hash_key =
+      QCryptographicHash::hash(app_key, QCryptographicHash::Sha256);
+  const auto named_path =
+      data_path + "/data_objs/" +
+      QCryptographicHash::hash(hash_key + "core_test_data_object",
+                               QCryptographicHash::Sha256)
+          .toHex();
+
+  // every write uses a fresh nonce, so equal bytes mean the write was skipped
+  op.SaveDataObj("core_test_data_object", QJsonDocument(obj));
+  QByteArray first;
+  ASSERT_TRUE(ReadFile(named_path, first));
+
+  op.SaveDataObj("core_test_data_object", QJsonDocument(obj));
+  QByteArray second;
+  ASSERT_TRUE(ReadFile(named_path, second));
+  ASSERT_EQ(first, second);
+
+  obj["size"] = 43;
+  op.SaveDataObj("core_test_data_object", QJsonDocument(obj));
+  ASSERT_TRUE(ReadFile(named_path, second));
+  ASSERT_NE(first, second);
+
+  auto named = op.GetDataObject("core_test_data_object");
+  ASSERT_TRUE(named.has_value());
+  ASSERT_EQ(named->object(), obj);
+
+  // a modified object doesn't authenticate
+  const auto pos = encoded.size() / 2;
+  encoded[pos] = static_cast<char>(encoded[pos] ^ 1);
+  ASSERT_TRUE(WriteFile(path, encoded));
+  ASSERT_FALSE(op.GetDataObjectByRef(ref).has_value());
+}
+
+TEST_F(GpgCoreTest, CoreDurableCacheTest) {
+  auto& cache = CacheManager::GetInstance();
+  auto& op = DataObjectOperator::GetInstance();
+
+  QJsonObject obj;
+  obj["value"] = "first";
+  cache.SaveDurableCache("core_test_durable", QJsonDocument(obj), true);
+  ASSERT_EQ(cache.LoadDurableCache("core_test_durable").object(), obj);
+
+  auto stored = op.GetDataObject("__cache_data_core_test_durable");
+  ASSERT_TRUE(stored.has_value());
+  ASSERT_EQ(stored->object(), obj);
+
+  // without a forced flush the entry is written behind on the io runner
+  QJsonObject obj_2;
+  obj_2["value"] = "second";
+  cache.SaveDurableCache("core_test_durable", QJsonDocument(obj_2));
+  ASSERT_EQ(cache.LoadDurableCache("core_test_durable").object(), obj_2);
+
+  ASSERT_TRUE(WaitUntil([&]() {
+    auto stored = op.GetDataObject("__cache_data_core_test_durable");
+    return stored.has_value() && stored->object() == obj_2;
+  }));
+
+  // a reset is written behind as well and doesn't come back from disk
+  ASSERT_TRUE(cache.ResetDurableCache("core_test_durable"));
+  ASSERT_TRUE(cache.LoadDurableCache("core_test_durable").isNull());
+  ASSERT_TRUE(WaitUntil([&]() {
+    auto stored = op.GetDataObject("__cache_data_core_test_durable");
+    return !stored.has_value() || stored->isNull();
+  }));
+
+  QJsonObject fallback;
+  fallback["value"] = "default";
+  ASSERT_EQ(cache.LoadDurableCache("core_test_durable", QJsonDocument(fallback))
+                .object(),
+            fallback);
+}
+
+TEST_F(GpgCoreTest, CoreRuntimeCacheQuotaTest) {
+  auto& cache = CacheManager::GetInstance();
+
+  // room for about three of the values below
+  cache.SetCacheQuota("core_test", 3 * 1200);
+
+  const auto value = QString(512, 'x');
+  cache.SaveCache("core_test:a", value);
+  cache.SaveCache("core_test:b", value);
+  cache.SaveCache("core_test:c", value);
+
+  // touch a, so b is the least recently used one
+  ASSERT_EQ(cache.LoadCache("core_test:a"), value);
+  cache.SaveCache("core_test:d", value);
+
+  ASSERT_EQ(cache.LoadCache("core_test:a"), value);
+  ASSERT_EQ(cache.LoadCache("core_test:b"), QString());
+  ASSERT_EQ(cache.LoadCache("core_test:c"), value);
+  ASSERT_EQ(cache.LoadCache("core_test:d"), value);
+
+  // other namespaces are not affected by the quota
+  cache.SaveCache("ABCQuota", value);
+  ASSERT_EQ(cache.LoadCache("ABCQuota"), value);
+
+  // too large for the namespace, not cached at all
+  cache.SaveCache("core_test:e", QString(4096, 'y'));
+  ASSERT_EQ(cache.LoadCache("core_test:e"), QString());
+  ASSERT_EQ(cache.LoadCache("core_test:a"), value);
+
+  // expires once the clock has passed the next full second
+  cache.SaveCache("core_test:ttl", value, 1);
+  const auto saved_at = QDateTime::currentSecsSinceEpoch();
+  ASSERT_TRUE(WaitUntil(
+      [&]() { return QDateTime::currentSecsSinceEpoch() > saved_at + 1; }));
+  cache.SweepCache();
+
+  ASSERT_GT(Module::RetrieveRTValueTypedOrDefault<>(
+                "core", "cache.runtime.expirations", qint64{0}),
+            0);
+  ASSERT_GT(Module::RetrieveRTValueTypedOrDefault<>(
+                "core", "cache.runtime.evictions", qint64{0}),
+            0);
+  ASSERT_GT(Module::RetrieveRTValueTypedOrDefault<>(
+                "core", "cache.runtime.hits", qint64{0}),
+            0);
+  ASSERT_EQ(cache.LoadCache("core_test:ttl"), QString());
+}
+
+}  // namespace GpgFrontend::Test
@@ -0,0 +1,97 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <chrono>
+#include <thread>
+
+#include "GpgCoreTest.h"
+#include "GpgCoreTestUtils.h"
+#include "core/thread/ConcurrentExecutor.h"
+#include "core/thread/TaskRunner.h"
+
+namespace GpgFrontend::Test {
+
+TEST_F(GpgCoreTest, CoreConcurrentExecutorTest) {
+  Thread::ConcurrentExecutor executor(4);
+  executor.Start();
+
+  // nested posts land on the posting worker's deque and get stolen
+  std::atomic_int executed = 0;
+  for (int i = 0; i < 256; i++) {
+    executor.Post([&]() {
+      executed++;
+      for (int j = 0; j < 3; j++) {
+        executor.Post([&]() {
+          std::this_thread::sleep_for(std::chrono::microseconds(50));
+          executed++;
+        });
+      }
+    });
+  }
+
+  executor.Stop();
+  ASSERT_EQ(executed.load(), 1024);
+
+  auto statistics = executor.GetStatistics();
+  ASSERT_EQ(statistics.workers, 4);
+  ASSERT_EQ(statistics.executed, 1024);
+  ASSERT_EQ(statistics.queue_depths.size(), 4);
+  for (const auto& depth : statistics.queue_depths) ASSERT_EQ(depth, 0);
+}
+
+TEST_F(GpgCoreTest, CoreTaskRunnerPostConcurrentTaskTest) {
+  Thread::TaskRunner runner;
+  runner.Start();
+
+  // runnables run on the executor, callbacks come back to this thread
+  std::atomic_int on_runner_thread = 0;
+  int callbacks = 0;
+  for (int i = 0; i < 16; i++) {
+    runner.PostConcurrentTask(new Thread::Task(
+        [&](const DataObjectPtr&) -> int {
+          if (QThread::currentThread() == runner.GetThread()) {
+            on_runner_thread++;
+          }
+          return 0;
+        },
+        "concurrent_task", nullptr,
+        [&](int rtn, const DataObjectPtr&) {
+          if (rtn == 0) callbacks++;
+        }));
+  }
+
+  ASSERT_TRUE(WaitUntil([&]() {
+    QCoreApplication::processEvents();
+    return callbacks == 16 && runner.GetPendingTaskCount() == 0;
+  }));
+  ASSERT_EQ(on_runner_thread.load(), 0);
+
+  runner.Stop();
+}
+
+}  // namespace GpgFrontend::Test
@@ -0,0 +1,235 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+#include "GpgCoreTest.h"
+#include "GpgCoreTestUtils.h"
+#include "core/model/GFDataExchanger.h"
+#include "core/model/GpgData.h"
+
+namespace GpgFrontend::Test {
+
+namespace {
+
+/**
+ * @brief the exchanger as it was before the ring buffer, a byte queue
+ * behind one mutex, kept as the baseline of the throughput benchmark
+ *
+ */
+class ByteQueueExchanger {
+ public:
+  explicit ByteQueueExchanger(size_t max_size) : max_size_(max_size) {}
+
+  auto Write(const std::byte* buffer, size_t size) -> ssize_t {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < size; i++) {
+      if (queue_.size() == max_size_) not_empty_.notify_all();
+      not_full_.wait(lock,
+                     [this] { return queue_.size() < max_size_ || close_; });
+      if (close_) return -1;
+      queue_.push(buffer[i]);
+    }
+    not_empty_.notify_all();
+    return static_cast<ssize_t>(size);
+  }
+
+  auto Read(std::byte* buffer, size_t size) -> ssize_t {
+    std::unique_lock<std::mutex> lock(mutex_);
+    size_t i = 0;
+    for (; i < size; i++) {
+      if (queue_.empty()) not_full_.notify_all();
+      not_empty_.wait(lock, [this] { return !queue_.empty() || close_; });
+      if (queue_.empty()) break;
+      buffer[i] = queue_.front();
+      queue_.pop();
+    }
+    not_full_.notify_all();
+    return static_cast<ssize_t>(i);
+  }
+
+  void CloseWrite() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    close_ = true;
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+ private:
+  const size_t max_size_;
+  std::queue<std::byte> queue_;
+  std::mutex mutex_;
+  std::condition_variable not_full_, not_empty_;
+  bool close_ = false;
+};
+
+/**
+ * @brief pipe total bytes through the exchanger in 32 KB chunks, from a
+ * writer thread to the calling thread
+ *
+ * @return double wall time in seconds
+ */
+template <typename Exchanger>
+auto PipeSeconds(Exchanger& ex, size_t total, size_t& read) -> double {
+  return MeasureSeconds([&]() {
+    std::thread writer([&] {
+      std::vector<std::byte> chunk(32 * 1024, std::byte{'G'});
+      size_t written = 0;
+      while (written < total) {
+        auto n = std::min(chunk.size(), total - written);
+        auto ret = ex.Write(chunk.data(), n);
+        if (ret <= 0) break;
+        written += ret;
+      }
+      ex.CloseWrite();
+    });
+
+    std::vector<std::byte> chunk(32 * 1024);
+    ssize_t ret;
+    while ((ret = ex.Read(chunk.data(), chunk.size())) > 0) read += ret;
+    writer.join();
+  });
+}
+
+}  // namespace
+
+TEST_F(GpgCoreTest, CoreDataExchangerRoundTripTest) {
+  // a tiny ring with odd chunk sizes forces every wrap-around path
+  auto ex = QSharedPointer<GFDataExchanger>::create(61);
+
+  const auto data = MakeTestData(100003);
+  const auto* bytes = reinterpret_cast<const std::byte*>(data.constData());
+  const std::vector<std::byte> in(bytes, bytes + data.size());
+
+  // gtest assertions only fail the test on the main thread
+  bool written = true;
+  std::thread writer([&] {
+    size_t offset = 0;
+    while (offset < in.size()) {
+      auto n = std::min<size_t>(37, in.size() - offset);
+      if (ex->Write(in.data() + offset, n) != static_cast<ssize_t>(n)) {
+        written = false;
+        break;
+      }
+      offset += n;
+    }
+    ex->CloseWrite();
+  });
+
+  std::vector<std::byte> out;
+  std::array<std::byte, 53> buf;
+  ssize_t ret;
+  while ((ret = ex->Read(buf.data(), buf.size())) > 0) {
+    out.insert(out.end(), buf.begin(), buf.begin() + ret);
+  }
+  writer.join();
+
+  ASSERT_TRUE(written);
+  ASSERT_EQ(ret, 0);
+  ASSERT_EQ(in, out);
+}
+
+TEST_F(GpgCoreTest, CoreDataExchangerCloseWriteTest) {
+  auto ex = QSharedPointer<GFDataExchanger>::create(16);
+
+  std::array<std::byte, 8> in{};
+  ASSERT_EQ(ex->Write(in.data(), in.size()), 8);
+
+  std::thread closer([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ex->CloseWrite();
+  });
+
+  // buffered data survives closing, then the reader sees eof
+  std::array<std::byte, 32> buf;
+  ASSERT_EQ(ex->Read(buf.data(), buf.size()), 8);
+  ASSERT_EQ(ex->Read(buf.data(), buf.size()), 0);
+  closer.join();
+
+  ASSERT_EQ(ex->Write(in.data(), in.size()), -1);
+}
+
+TEST_F(GpgCoreTest, CoreDataExchangerThroughputTest) {
+  // set GF_TEST_EXCHANGER_BENCH_GB=1..4 to pipe that many gigabytes
+  GF_TEST_BENCH_SCALE(gigabytes, "GF_TEST_EXCHANGER_BENCH_GB");
+
+  const auto total = static_cast<size_t>(std::min(gigabytes, 4)) << 30;
+  auto ex = CreateStandardGFDataExchanger();
+
+  std::thread writer([&] {
+    GpgData data_in(ex);
+    std::vector<char> chunk(32 * 1024, 'G');
+
+    size_t written = 0;
+    while (written < total) {
+      auto ret = gpgme_data_write(data_in, chunk.data(), chunk.size());
+      if (ret <= 0) break;
+      written += ret;
+    }
+    ex->CloseWrite();
+  });
+
+  size_t read = 0;
+  const auto elapsed = MeasureSeconds([&]() {
+    GpgData data_out(ex);
+    std::vector<char> chunk(32 * 1024);
+    ssize_t ret;
+    while ((ret = gpgme_data_read(data_out, chunk.data(), chunk.size())) > 0) {
+      read += ret;
+    }
+    writer.join();
+  });
+
+  ASSERT_EQ(read, total);
+  LOG_I() << "data exchanger piped" << (total >> 20) << "MB in" << elapsed
+          << "s," << (total >> 20) / elapsed << "MB/s through gpgme";
+
+  // the same pipe without gpgme, against the old byte queue; the baseline
+  // moves a byte at a time, so it only gets a slice of the payload
+  const auto baseline_total = std::min<size_t>(total, 64 << 20);
+
+  size_t ring_read = 0;
+  auto ring = CreateStandardGFDataExchanger();
+  const auto ring_elapsed = PipeSeconds(*ring, total, ring_read);
+  ASSERT_EQ(ring_read, total);
+
+  size_t queue_read = 0;
+  ByteQueueExchanger queue(static_cast<size_t>(kDataExchangerSize));
+  const auto queue_elapsed = PipeSeconds(queue, baseline_total, queue_read);
+  ASSERT_EQ(queue_read, baseline_total);
+
+  const auto ring_rate = (total >> 20) / ring_elapsed;
+  const auto queue_rate = (baseline_total >> 20) / queue_elapsed;
+  LOG_I() << "ring buffer:" << ring_rate << "MB/s, byte queue baseline:"
+          << queue_rate << "MB/s, speedup:" << ring_rate / queue_rate;
+}
+
+}  // namespace GpgFrontend::Test
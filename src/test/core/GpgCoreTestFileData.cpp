@@ -0,0 +1,127 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "GpgCoreTest.h"
+#include "GpgCoreTestUtils.h"
+#include "core/model/GpgData.h"
+#include "core/utils/IOUtils.h"
+
+namespace GpgFrontend::Test {
+
+namespace {
+
+auto WriteThroughGpgData(const QString& path, const QByteArray& data,
+                         bool use_stream) -> bool {
+  GpgData data_out(path, false, use_stream);
+
+  // odd block sizes, plus one block larger than the output buffer
+  qsizetype offset = 0;
+  qsizetype block = 4093;
+  while (offset < data.size()) {
+    auto n = std::min<qsizetype>(block, data.size() - offset);
+    auto ret = gpgme_data_write(data_out, data.constData() + offset, n);
+    if (ret != n) return false;
+    offset += n;
+    block = block == 4093 ? 5 * 1024 * 1024 : 4093;
+  }
+  return gpgme_err_code(data_out.FlushOutput()) == GPG_ERR_NO_ERROR;
+}
+
+auto ReadThroughGpgData(const QString& path, bool use_stream) -> QByteArray {
+  GpgData data_in(path, true, use_stream);
+
+  QByteArray out;
+  std::array<char, 64 * 1024> buf;
+  ssize_t ret;
+  while ((ret = gpgme_data_read(data_in, buf.data(), buf.size())) > 0) {
+    out.append(buf.data(), static_cast<qsizetype>(ret));
+  }
+  return out;
+}
+
+}  // namespace
+
+TEST_F(GpgCoreTest, CoreFileDataRoundTripTest) {
+  const auto data = MakeTestData(13 * 1024 * 1024 + 17);
+  const auto path = GetTempFilePath();
+
+  ASSERT_TRUE(WriteThroughGpgData(path, data, false));
+  ASSERT_EQ(ReadThroughGpgData(path, false), data);
+  ASSERT_EQ(ReadThroughGpgData(path, true), data);
+
+  // the mapped input supports seeking for Read2GFBuffer
+  GpgData data_in(path, true);
+  ASSERT_EQ(data_in.Read2GFBuffer().ConvertToQByteArray(), data);
+
+  // empty files fall back to the stream path
+  const auto empty_path = GetTempFilePath();
+  ASSERT_TRUE(WriteThroughGpgData(empty_path, {}, false));
+  ASSERT_TRUE(ReadThroughGpgData(empty_path, false).isEmpty());
+}
+
+TEST_F(GpgCoreTest, CoreFileDataFinalWriteFailureTest) {
+  // every write to /dev/full fails with ENOSPC
+  if (!QFileInfo::exists("/dev/full")) GTEST_SKIP();
+
+  // smaller than both the output and the stdio buffer, so nothing reaches
+  // the file before the final write
+  const auto data = MakeTestData(1000);
+
+  for (const auto use_stream : {false, true}) {
+    GpgData data_out(QString("/dev/full"), false, use_stream);
+    ASSERT_EQ(gpgme_data_write(data_out, data.constData(), data.size()),
+              data.size());
+    ASSERT_NE(gpgme_err_code(data_out.FlushOutput()), GPG_ERR_NO_ERROR);
+  }
+}
+
+TEST_F(GpgCoreTest, CoreFileDataThroughputTest) {
+  // set GF_TEST_FILE_DATA_BENCH_MB to compare with the stream path
+  GF_TEST_BENCH_SCALE(megabytes, "GF_TEST_FILE_DATA_BENCH_MB");
+
+  const auto data = MakeTestData(static_cast<qsizetype>(megabytes) << 20);
+  const auto path = GetTempFilePath();
+
+  for (const auto use_stream : {true, false}) {
+    bool written = false;
+    const auto write_elapsed = MeasureSeconds(
+        [&]() { written = WriteThroughGpgData(path, data, use_stream); });
+    ASSERT_TRUE(written);
+
+    qsizetype read = 0;
+    const auto read_elapsed = MeasureSeconds(
+        [&]() { read = ReadThroughGpgData(path, use_stream).size(); });
+    ASSERT_EQ(read, data.size());
+
+    LOG_I() << (use_stream ? "stream" : "mapped/buffered")
+            << "gpg data, write:" << megabytes / write_elapsed
+            << "MB/s, read:" << megabytes / read_elapsed << "MB/s";
+  }
+}
+
+}  // namespace GpgFrontend::Test
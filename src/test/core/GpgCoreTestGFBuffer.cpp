@@ -0,0 +1,68 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "GpgCoreTest.h"
+#include "GpgCoreTestUtils.h"
+#include "core/model/GFBuffer.h"
+#include "core/model/GpgData.h"
+
+namespace GpgFrontend::Test {
+
+TEST_F(GpgCoreTest, GpgDataReadLargeTest) {
+  const auto raw = MakeTestData(3 * 1024 * 1024 + 7);
+
+  GpgData data;
+  ASSERT_EQ(gpgme_data_write(data, raw.constData(), raw.size()), raw.size());
+
+  auto out_buffer = data.Read2GFBuffer();
+  ASSERT_EQ(out_buffer.ConvertToQByteArray(), raw);
+
+  // a second read starts over from the beginning
+  ASSERT_EQ(data.Read2GFBuffer(), out_buffer);
+}
+
+TEST_F(GpgCoreTest, GFBufferSliceTest) {
+  auto buffer = GFBuffer(QByteArray("0123456789"));
+
+  auto slice = buffer.Slice(2, 5);
+  ASSERT_EQ(slice.Size(), 5);
+  ASSERT_EQ(slice.Data(), buffer.Data() + 2);
+  ASSERT_EQ(slice.ConvertToQByteArray(), QByteArray("23456"));
+  ASSERT_EQ(slice.Slice(1).ConvertToQByteArray(), QByteArray("3456"));
+
+  ASSERT_EQ(buffer.Slice(8, 100).Size(), 2);
+  ASSERT_TRUE(buffer.Slice(100).Empty());
+  ASSERT_EQ(buffer.Slice(0), buffer);
+
+  // writing to a slice never touches the shared storage
+  slice.Append("ab", 2);
+  ASSERT_EQ(slice.ConvertToQByteArray(), QByteArray("23456ab"));
+  ASSERT_EQ(buffer.ConvertToQByteArray(), QByteArray("0123456789"));
+}
+
+}  // namespace GpgFrontend::Test
@@ -0,0 +1,187 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <atomic>
+#include <thread>
+
+#include "GpgCoreTest.h"
+#include "GpgCoreTestUtils.h"
+#include "core/module/GlobalRegisterTable.h"
+
+namespace GpgFrontend::Test {
+
+using Module::GlobalRegisterTable;
+using Module::Key;
+using Module::Namespace;
+
+TEST_F(GpgCoreTest, CoreGRTExactListenTest) {
+  GlobalRegisterTable grt;
+  QObject receiver;
+
+  QStringList keys;
+  ASSERT_TRUE(grt.ListenPublish(
+      &receiver, "test", "a.b",
+      [&](Namespace, Key k, int, std::any) { keys.append(k); }));
+
+  grt.PublishKV("test", "a.b", 1);
+  grt.PublishKV("test", "a.b.c", 2);
+  grt.PublishKV("test", "a", 3);
+  grt.PublishKV("other", "a.b", 4);
+
+  ASSERT_EQ(keys, QStringList{"a.b"});
+}
+
+TEST_F(GpgCoreTest, CoreGRTPrefixListenTest) {
+  GlobalRegisterTable grt;
+  QObject receiver;
+
+  QStringList keys;
+  QStringList all_keys;
+  grt.ListenPublish(
+      &receiver, "test", "a",
+      [&](Namespace, Key k, int, std::any) { keys.append(k); }, true);
+  grt.ListenPublish(
+      &receiver, "test", "",
+      [&](Namespace, Key k, int, std::any) { all_keys.append(k); }, true);
+
+  grt.PublishKV("test", "a", 1);
+  grt.PublishKV("test", "a.b.c", 2);
+  grt.PublishKV("test", "ab", 3);
+  grt.PublishKV("other", "a", 4);
+
+  ASSERT_EQ(keys, (QStringList{"a", "a.b.c"}));
+  ASSERT_EQ(all_keys, (QStringList{"a", "a.b.c", "ab"}));
+}
+
+TEST_F(GpgCoreTest, CoreGRTPublishKVsTest) {
+  GlobalRegisterTable grt;
+  QObject receiver;
+
+  int sum = 0;
+  grt.ListenPublish(
+      &receiver, "test", "stats",
+      [&](Namespace, Key, int, std::any v) { sum += std::any_cast<int>(v); },
+      true);
+
+  ASSERT_TRUE(grt.PublishKVs(
+      "test", {{"stats.a", 1}, {"stats.b", 2}, {"stats.c", 3}}));
+  ASSERT_EQ(sum, 6);
+
+  auto value = grt.LookupKV("test", "stats.b");
+  ASSERT_TRUE(value.has_value());
+  ASSERT_EQ(std::any_cast<int>(value.value()), 2);
+}
+
+TEST_F(GpgCoreTest, CoreGRTDestroyedReceiverTest) {
+  GlobalRegisterTable grt;
+
+  int calls = 0;
+  {
+    QObject receiver;
+    grt.ListenPublish(&receiver, "test", "a",
+                      [&](Namespace, Key, int, std::any) { calls++; });
+    grt.PublishKV("test", "a", 1);
+  }
+  grt.PublishKV("test", "a", 2);
+
+  ASSERT_EQ(calls, 1);
+}
+
+TEST_F(GpgCoreTest, CoreGRTInternPathTest) {
+  GlobalRegisterTable grt;
+
+  auto path = grt.InternPath("test", "a.b");
+  ASSERT_TRUE(path.IsValid());
+  ASSERT_EQ(path.Load(), nullptr);
+  ASSERT_FALSE(grt.LookupKV("test", "a.b").has_value());
+
+  grt.PublishKV("test", "a.b", QString("v1"));
+  ASSERT_EQ(std::any_cast<QString>(*path.Load()), QString("v1"));
+
+  grt.PublishKV("test", "a.b", QString("v2"));
+  ASSERT_EQ(std::any_cast<QString>(*path.Load()), QString("v2"));
+  ASSERT_EQ(std::any_cast<QString>(grt.LookupKV("test", "a.b").value()),
+            QString("v2"));
+
+  grt.PublishKV("test", "a.c", 1);
+  ASSERT_EQ(grt.ListChildKeys("test", "a"), (QContainer<Key>{"b", "c"}));
+}
+
+TEST_F(GpgCoreTest, CoreGRTConcurrentReadTest) {
+  GlobalRegisterTable grt;
+  grt.PublishKV("test", "counter", 0);
+  auto path = grt.InternPath("test", "counter");
+
+  std::atomic_bool stop = false;
+  std::atomic_bool monotonic = true;
+  std::thread reader([&] {
+    int last = 0;
+    while (!stop) {
+      const auto current = std::any_cast<int>(*path.Load());
+      if (current < last) monotonic = false;
+      last = current;
+    }
+  });
+
+  for (int i = 1; i <= 10000; i++) grt.PublishKV("test", "counter", i);
+  stop = true;
+  reader.join();
+
+  ASSERT_TRUE(monotonic);
+  ASSERT_EQ(std::any_cast<int>(*path.Load()), 10000);
+}
+
+TEST_F(GpgCoreTest, CoreGRTFanOutBenchTest) {
+  // set GF_TEST_GRT_BENCH_LISTENERS to the number of unrelated listeners
+  GF_TEST_BENCH_SCALE(listeners, "GF_TEST_GRT_BENCH_LISTENERS");
+
+  GlobalRegisterTable grt;
+  QObject receiver;
+
+  int unrelated = 0;
+  for (int i = 0; i < listeners; i++) {
+    grt.ListenPublish(&receiver, "bench", QString("key.%1").arg(i),
+                      [&](Namespace, Key, int, std::any) { unrelated++; });
+  }
+
+  int hits = 0;
+  grt.ListenPublish(&receiver, "bench", "target",
+                    [&](Namespace, Key, int, std::any) { hits++; });
+
+  const int publishes = 10000;
+  const auto elapsed = MeasureSeconds([&]() {
+    for (int i = 0; i < publishes; i++) grt.PublishKV("bench", "target", i);
+  });
+
+  ASSERT_EQ(hits, publishes);
+  ASSERT_EQ(unrelated, 0);
+  LOG_I() << "register table published" << publishes << "values with"
+          << listeners << "listeners in" << elapsed << "s";
+}
+
+}  // namespace GpgFrontend::Test
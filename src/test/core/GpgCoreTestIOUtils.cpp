@@ -0,0 +1,86 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "GpgCoreTest.h"
+#include "GpgCoreTestUtils.h"
+#include "core/utils/IOUtils.h"
+
+namespace GpgFrontend::Test {
+
+TEST_F(GpgCoreTest, CoreFileDigestsTest) {
+  // spans several hash blocks and ends in a partial one
+  const auto data = MakeTestData(1024 * 1024 + 4099);
+  auto file_path = CreateTempFileAndWriteData(GFBuffer(data));
+
+  qint64 last_done = 0;
+  auto digests = CalculateFileDigests(
+      file_path,
+      {QCryptographicHash::Md5, QCryptographicHash::Sha1,
+       QCryptographicHash::Sha256, QCryptographicHash::Sha512},
+      [&](qint64 done, qint64 total) {
+        ASSERT_GT(done, last_done);
+        ASSERT_EQ(total, data.size());
+        last_done = done;
+      });
+
+  ASSERT_EQ(last_done, data.size());
+  ASSERT_EQ(digests.size(), 4);
+  ASSERT_EQ(digests[0],
+            QCryptographicHash::hash(data, QCryptographicHash::Md5));
+  ASSERT_EQ(digests[1],
+            QCryptographicHash::hash(data, QCryptographicHash::Sha1));
+  ASSERT_EQ(digests[2],
+            QCryptographicHash::hash(data, QCryptographicHash::Sha256));
+  ASSERT_EQ(digests[3],
+            QCryptographicHash::hash(data, QCryptographicHash::Sha512));
+
+  ASSERT_TRUE(CalculateFileDigests(file_path + ".missing",
+                                   {QCryptographicHash::Md5})
+                  .isEmpty());
+}
+
+TEST_F(GpgCoreTest, CoreFileDigestsReadAfterMappedTest) {
+  // one mapped window, then the rest is read in several chunks
+  constexpr qint64 kMapWindowSize = 64 * 1024 * 1024;
+  const auto data = MakeTestData(kMapWindowSize + (9 * 1024 * 1024) + 4099);
+  auto file_path = CreateTempFileAndWriteData(GFBuffer(data));
+
+  QContainer<qint64> steps;
+  auto digests = CalculateFileDigests(
+      file_path, {QCryptographicHash::Sha256},
+      [&](qint64 done, qint64) { steps.append(done); }, kMapWindowSize);
+
+  ASSERT_GT(steps.size(), 2);
+  ASSERT_EQ(steps.front(), kMapWindowSize);
+  ASSERT_EQ(steps.back(), data.size());
+  ASSERT_EQ(digests.size(), 1);
+  ASSERT_EQ(digests[0],
+            QCryptographicHash::hash(data, QCryptographicHash::Sha256));
+}
+
+}  // namespace GpgFrontend::Test
@@ -28,7 +28,10 @@
 
 #include "GpgCoreTest.h"
 #include "core/GpgConstants.h"
+#include "core/function/gpg/GpgAbstractKeyGetter.h"
 #include "core/function/gpg/GpgKeyImportExporter.h"
+#include "core/model/GpgData.h"
+#include "core/model/GpgImportInformation.h"
 #include "core/utils/GpgUtils.h"
 
 namespace GpgFrontend::Test {
@@ -93,4 +96,55 @@ TEST_F(GpgCoreTest, CoreExportSubkeyTestD) {
           "6e3375060aa889d9eb61e2966eabb31eb6b5359a7742ee7adeedec09e6afa36a"));
 }
 
-}  // namespace GpgFrontend::Test
\ No newline at end of file
+TEST_F(GpgCoreTest, CoreExportAllKeysStreamTest) {
+  auto keys = GpgAbstractKeyGetter::GetInstance().Fetch();
+  ASSERT_FALSE(keys.isEmpty());
+
+  GpgData data_out;
+  auto err = GpgKeyImportExporter::GetInstance().ExportAllKeys(keys, false,
+                                                               true, data_out);
+  ASSERT_EQ(CheckGpgError(err), GPG_ERR_NO_ERROR);
+  auto buffered = data_out.Read2GFBuffer().ConvertToQByteArray();
+  ASSERT_FALSE(buffered.isEmpty());
+
+  // the stream sees the chunks gpgme writes, nothing is buffered in between
+  QByteArray streamed;
+  GpgData stream_out(GpgData::StreamCallbacks{
+      nullptr, [&](const void* buffer, size_t size) -> ssize_t {
+        streamed.append(static_cast<const char*>(buffer),
+                        static_cast<qsizetype>(size));
+        return static_cast<ssize_t>(size);
+      }});
+  err = GpgKeyImportExporter::GetInstance().ExportAllKeys(keys, false, true,
+                                                          stream_out);
+  ASSERT_EQ(CheckGpgError(err), GPG_ERR_NO_ERROR);
+  ASSERT_EQ(streamed, buffered);
+}
+
+TEST_F(GpgCoreTest, CoreImportKeyFromFileTest) {
+  auto keys = GpgAbstractKeyGetter::GetInstance().Fetch();
+  ASSERT_FALSE(keys.isEmpty());
+
+  QTemporaryDir dir;
+  ASSERT_TRUE(dir.isValid());
+  const auto path = dir.filePath("keyring.asc");
+
+  {
+    GpgData data_out(path, false);
+    auto err = GpgKeyImportExporter::GetInstance().ExportAllKeys(
+        keys, false, true, data_out);
+    ASSERT_EQ(CheckGpgError(err), GPG_ERR_NO_ERROR);
+    ASSERT_EQ(CheckGpgError(data_out.FlushOutput()), GPG_ERR_NO_ERROR);
+  }
+  ASSERT_GT(QFileInfo(path).size(), 0);
+
+  auto info = GpgKeyImportExporter::GetInstance().ImportKey(path);
+  ASSERT_TRUE(info != nullptr);
+  ASSERT_GT(info->considered, 0);
+  ASSERT_EQ(info->not_imported, 0);
+
+  ASSERT_TRUE(GpgKeyImportExporter::GetInstance().ImportKey(
+                  dir.filePath("missing.asc")) == nullptr);
+}
+
+}  // namespace GpgFrontend::Test
@@ -251,4 +251,38 @@ TEST_F(GpgCoreTest, CoreRevokeSubkeyTestA) {
   GpgKeyOpera::GetInstance().DeleteKey(key);
 }
 
+TEST_F(GpgCoreTest, CoreRefreshKeysTest) {
+  auto info = GpgKeyImportExporter::GetInstance().ImportKey(
+      GFBuffer(QString::fromLatin1(test_private_key_data)));
+
+  ASSERT_EQ(info->imported, 1);
+  ASSERT_FALSE(info->imported_keys.empty());
+
+  auto fpr = info->imported_keys.front().fpr;
+  auto& getter = GpgKeyGetter::GetInstance(kGpgFrontendDefaultChannel);
+  ASSERT_TRUE(getter.RefreshKeys({fpr}));
+
+  auto key = getter.GetKeyORSubkeyPtr("822D7E13F5B85D7D");
+  ASSERT_TRUE(key != nullptr);
+  ASSERT_TRUE(getter.GetKeyORSubkeyPtr("2D1F9FC59B568A8C") != nullptr);
+
+  auto g_key = getter.GetKeyPtr("822D7E13F5B85D7D");
+  ASSERT_TRUE(GpgKeyManager::GetInstance().DeleteSubkey(g_key, 2));
+
+  // only the changed key is re-listed, its dropped subkey leaves the cache
+  ASSERT_TRUE(getter.RefreshKeys({fpr}));
+  g_key = getter.GetKeyPtr("822D7E13F5B85D7D");
+  ASSERT_TRUE(g_key != nullptr);
+  ASSERT_EQ(g_key->SubKeys().size(), 4);
+  ASSERT_TRUE(getter.GetKeyORSubkeyPtr("2D1F9FC59B568A8C") == nullptr);
+
+  GpgKeyOpera::GetInstance().DeleteKey(g_key);
+
+  ASSERT_TRUE(getter.RefreshKeys({fpr}));
+  ASSERT_TRUE(getter.GetKeyORSubkeyPtr(fpr) == nullptr);
+  for (const auto& k : getter.Fetch()) {
+    ASSERT_NE(k->Fingerprint(), fpr);
+  }
+}
+
 }  // namespace GpgFrontend::Test
\ No newline at end of file
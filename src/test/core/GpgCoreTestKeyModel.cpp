@@ -29,10 +29,12 @@
 #include <gtest/gtest.h>
 
 #include "GpgCoreTest.h"
+#include "core/function/gpg/GpgAbstractKeyGetter.h"
 #include "core/function/gpg/GpgContext.h"
 #include "core/function/gpg/GpgKeyGetter.h"
 #include "core/model/GpgData.h"
 #include "core/model/GpgKey.h"
+#include "core/model/GpgKeyTableModel.h"
 #include "core/utils/GpgUtils.h"
 
 namespace GpgFrontend::Test {
@@ -158,9 +160,16 @@ TEST_F(GpgCoreTest, GpgUIDTest) {
 }
 
 TEST_F(GpgCoreTest, GpgKeySignatureTest) {
+  // the cached key is listed without key signatures
+  auto light_key = GpgKeyGetter::GetInstance(kGpgFrontendDefaultChannel)
+                       .GetKey("9490795B78F8AFE9F93BD09281704859182661FB");
+  ASSERT_TRUE(light_key.IsGood());
+  ASSERT_TRUE(light_key.UIDs().front().GetSignatures()->empty());
+
   auto key = GpgKeyGetter::GetInstance(kGpgFrontendDefaultChannel)
-                 .GetKey("9490795B78F8AFE9F93BD09281704859182661FB");
-  auto uids = key.UIDs();
+                 .GetKeyWithDetails("9490795B78F8AFE9F93BD09281704859182661FB");
+  ASSERT_TRUE(key != nullptr);
+  auto uids = key->UIDs();
   ASSERT_EQ(uids.size(), 1);
   auto& uid = uids.front();
 
@@ -181,6 +190,26 @@ TEST_F(GpgCoreTest, GpgKeySignatureTest) {
             "GpgFrontendTest <gpgfrontend@gpgfrontend.pub>");
 }
 
+TEST_F(GpgCoreTest, GpgKeyDecodedViewTest) {
+  auto key = GpgKeyGetter::GetInstance(kGpgFrontendDefaultChannel)
+                 .GetKey("9490795B78F8AFE9F93BD09281704859182661FB");
+  ASSERT_TRUE(key.IsGood());
+
+  // the decoded subkeys and uids are shared, not rebuilt per call
+  auto copy = key;
+  ASSERT_EQ(key.SubKeys().constData(), copy.SubKeys().constData());
+  ASSERT_EQ(key.UIDs().constData(), key.UIDs().constData());
+
+  auto s_keys = key.SubKeys();
+  ASSERT_EQ(s_keys.front().ID(), key.PrimaryKey().ID());
+  ASSERT_EQ(s_keys.front().Algo(), key.Algo());
+
+  auto bad_key = GpgKey();
+  ASSERT_FALSE(bad_key.IsGood());
+  ASSERT_TRUE(bad_key.SubKeys().isEmpty());
+  ASSERT_TRUE(bad_key.Algo().isEmpty());
+}
+
 TEST_F(GpgCoreTest, GpgKeyGetterTest) {
   auto key = GpgKeyGetter::GetInstance(kGpgFrontendDefaultChannel)
                  .GetKeyPtr("9490795B78F8AFE9F93BD09281704859182661FB");
@@ -191,4 +220,24 @@ TEST_F(GpgCoreTest, GpgKeyGetterTest) {
   ASSERT_TRUE(std::find(keys.begin(), keys.end(), key) != keys.end());
 }
 
+TEST_F(GpgCoreTest, GpgKeyTableModelSearchTest) {
+  auto model = GpgAbstractKeyGetter::GetInstance(kGpgFrontendDefaultChannel)
+                   .GetGpgKeyTableModel();
+  ASSERT_TRUE(model != nullptr);
+
+  int row = -1;
+  for (int i = 0; i < model->rowCount({}); ++i) {
+    auto *item = static_cast<GpgKeyTableItem *>(
+        model->index(i, 0, {}).internalPointer());
+    if (item->Key()->ID() == "81704859182661FB") row = i;
+  }
+  ASSERT_GE(row, 0);
+
+  EXPECT_TRUE(model->IsRowMatchKeywords(row, "81704859182661fb"));
+  EXPECT_TRUE(model->IsRowMatchKeywords(
+      row, QString("GpgFrontend@GpgFrontend.pub").toCaseFolded()));
+  EXPECT_FALSE(model->IsRowMatchKeywords(row, "no such keyword"));
+  EXPECT_FALSE(model->IsRowMatchKeywords(model->rowCount({}), "8170"));
+}
+
 }  // namespace GpgFrontend::Test
\ No newline at end of file
@@ -0,0 +1,108 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "GpgCoreTest.h"
+#include "GpgCoreTestUtils.h"
+#include "core/function/KeyPackageStream.h"
+#include "core/utils/IOUtils.h"
+
+namespace GpgFrontend::Test {
+
+namespace {
+
+// the raw payload the writer encodes per chunk
+constexpr qsizetype kRawChunkSize = 3 * 16 * 16384;
+
+auto WriteKeyPackage(const QString& path, const QByteArray& key,
+                     const QByteArray& data) -> bool {
+  KeyPackageWriter writer(path, key);
+  if (!writer.Open()) return false;
+
+  // odd pieces, like the ones gpgme hands over while exporting
+  qsizetype offset = 0;
+  while (offset < data.size()) {
+    auto n = std::min<qsizetype>(4093, data.size() - offset);
+    if (!writer.Write(data.constData() + offset, n)) return false;
+    offset += n;
+  }
+  return writer.Finish();
+}
+
+auto ReadKeyPackage(const QString& path, const QByteArray& key) -> QByteArray {
+  KeyPackageReader reader(path, key);
+  if (!reader.Open()) return {};
+
+  QByteArray out;
+  std::array<char, 7001> buf;
+  qsizetype ret;
+  while ((ret = reader.Read(buf.data(), buf.size())) > 0) {
+    out.append(buf.data(), ret);
+  }
+  return out;
+}
+
+}  // namespace
+
+TEST_F(GpgCoreTest, CoreKeyPackageRoundTripTest) {
+  const auto key =
+      QCryptographicHash::hash("key package", QCryptographicHash::Sha256);
+
+  for (const qsizetype size :
+       {qsizetype{0}, qsizetype{1}, qsizetype{12}, qsizetype{48 * 1024},
+        kRawChunkSize - 1, kRawChunkSize, kRawChunkSize + 1,
+        2 * kRawChunkSize + 7}) {
+    const auto data = MakeTestData(size);
+    const auto path = GetTempFilePath();
+
+    ASSERT_TRUE(WriteKeyPackage(path, key, data)) << size;
+    ASSERT_EQ(ReadKeyPackage(path, key), data) << size;
+
+    // base64 of the payload plus the padding, which takes a whole block
+    // when the base64 is already aligned
+    const auto encoded = data.toBase64().size();
+    ASSERT_EQ(QFileInfo(path).size(), (encoded / 16 + 1) * 16) << size;
+  }
+}
+
+TEST_F(GpgCoreTest, CoreKeyPackagePeekTest) {
+  const auto key =
+      QCryptographicHash::hash("key package", QCryptographicHash::Sha256);
+  const auto data = MakeTestData(kRawChunkSize + 1);
+  const auto path = GetTempFilePath();
+  ASSERT_TRUE(WriteKeyPackage(path, key, data));
+
+  KeyPackageReader reader(path, key);
+  ASSERT_TRUE(reader.Open());
+  ASSERT_EQ(reader.Peek(64), data.left(64));
+
+  // peeking doesn't consume anything
+  std::array<char, 64> buf;
+  ASSERT_EQ(reader.Read(buf.data(), buf.size()), 64);
+  ASSERT_EQ(QByteArray(buf.data(), buf.size()), data.left(64));
+}
+
+}  // namespace GpgFrontend::Test
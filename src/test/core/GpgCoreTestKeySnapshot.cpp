@@ -0,0 +1,163 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include "GpgCoreTest.h"
+#include "GpgCoreTestUtils.h"
+#include "core/GpgConstants.h"
+#include "core/function/gpg/GpgContext.h"
+#include "core/function/gpg/GpgKeyGetter.h"
+#include "core/function/gpg/GpgKeySnapshot.h"
+#include "core/model/GpgKey.h"
+#include "core/utils/IOUtils.h"
+
+namespace GpgFrontend::Test {
+
+namespace {
+
+auto FetchRealKey(const QString& fpr) -> gpgme_key_t {
+  auto* ctx =
+      GpgContext::GetInstance(kGpgFrontendDefaultChannel).DefaultContext();
+
+  gpgme_key_t p_key = nullptr;
+  gpgme_get_key(ctx, fpr.toUtf8(), &p_key, 0);
+  return p_key;
+}
+
+}  // namespace
+
+TEST_F(GpgCoreTest, CoreKeySnapshotRoundTripTest) {
+  auto key = GpgKeyGetter::GetInstance(kGpgFrontendDefaultChannel)
+                 .GetKeyPtr("9490795B78F8AFE9F93BD09281704859182661FB");
+  ASSERT_TRUE(key != nullptr);
+
+  auto encoded = GpgKeySnapshot::EncodeKey(*key);
+  int fetches = 0;
+  auto decoded = GpgKeySnapshot::DecodeKey(encoded, [&](const QString& fpr) {
+    fetches++;
+    return FetchRealKey(fpr);
+  });
+  ASSERT_TRUE(decoded != nullptr);
+  ASSERT_EQ(GpgKeySnapshot::EncodeKey(*decoded), encoded);
+
+  ASSERT_EQ(decoded->ID(), key->ID());
+  ASSERT_EQ(decoded->Fingerprint(), key->Fingerprint());
+  ASSERT_EQ(decoded->Name(), key->Name());
+  ASSERT_EQ(decoded->Email(), key->Email());
+  ASSERT_EQ(decoded->Algo(), key->Algo());
+  ASSERT_EQ(decoded->OwnerTrust(), key->OwnerTrust());
+  ASSERT_EQ(decoded->CreationTime(), key->CreationTime());
+  ASSERT_EQ(decoded->ExpirationTime(), key->ExpirationTime());
+  ASSERT_EQ(decoded->IsPrivateKey(), key->IsPrivateKey());
+  ASSERT_EQ(decoded->IsHasMasterKey(), key->IsHasMasterKey());
+  ASSERT_EQ(decoded->IsHasActualEncrCap(), key->IsHasActualEncrCap());
+  ASSERT_EQ(decoded->IsHasActualSignCap(), key->IsHasActualSignCap());
+  ASSERT_EQ(decoded->SubKeys().size(), key->SubKeys().size());
+  ASSERT_EQ(decoded->UIDs().size(), key->UIDs().size());
+  ASSERT_EQ(decoded->UIDs().front().GetUID(), key->UIDs().front().GetUID());
+
+  // showing the key never lists it, handing it to gpgme lists it once
+  ASSERT_TRUE(decoded->IsDisplayOnly());
+  ASSERT_EQ(fetches, 0);
+
+  gpgme_key_t real_key = *decoded;
+  ASSERT_TRUE(real_key != nullptr);
+  ASSERT_TRUE(real_key != decoded->DisplayData());
+  ASSERT_EQ(QString(real_key->fpr), key->Fingerprint());
+  ASSERT_EQ(static_cast<gpgme_key_t>(*decoded), real_key);
+  ASSERT_EQ(fetches, 1);
+}
+
+TEST_F(GpgCoreTest, CoreKeySnapshotDeletedKeyTest) {
+  auto key = GpgKeyGetter::GetInstance(kGpgFrontendDefaultChannel)
+                 .GetKeyPtr("9490795B78F8AFE9F93BD09281704859182661FB");
+  ASSERT_TRUE(key != nullptr);
+
+  auto decoded = GpgKeySnapshot::DecodeKey(
+      GpgKeySnapshot::EncodeKey(*key),
+      [](const QString&) -> gpgme_key_t { return nullptr; });
+  ASSERT_TRUE(decoded != nullptr);
+
+  // a key deleted since the snapshot reaches gpgme as no key at all
+  ASSERT_EQ(decoded->Fingerprint(), key->Fingerprint());
+  ASSERT_TRUE(static_cast<gpgme_key_t>(*decoded) == nullptr);
+}
+
+TEST_F(GpgCoreTest, CoreKeySnapshotFetchRetryTest) {
+  auto key = GpgKeyGetter::GetInstance(kGpgFrontendDefaultChannel)
+                 .GetKeyPtr("9490795B78F8AFE9F93BD09281704859182661FB");
+  ASSERT_TRUE(key != nullptr);
+
+  int fetches = 0;
+  auto decoded = GpgKeySnapshot::DecodeKey(
+      GpgKeySnapshot::EncodeKey(*key),
+      [&](const QString& fpr) -> gpgme_key_t {
+        return ++fetches == 1 ? nullptr : FetchRealKey(fpr);
+      });
+  ASSERT_TRUE(decoded != nullptr);
+
+  // a failed fetch isn't remembered, the next use lists the key again
+  ASSERT_TRUE(static_cast<gpgme_key_t>(*decoded) == nullptr);
+  ASSERT_TRUE(static_cast<gpgme_key_t>(*decoded) != nullptr);
+  ASSERT_TRUE(static_cast<gpgme_key_t>(*decoded) != nullptr);
+  ASSERT_EQ(fetches, 2);
+}
+
+TEST_F(GpgCoreTest, CoreKeySnapshotKeyringStateTest) {
+  auto keys = GpgKeyGetter::GetInstance(kGpgFrontendDefaultChannel).Fetch();
+  ASSERT_FALSE(keys.isEmpty());
+
+  QTemporaryDir dir;
+  ASSERT_TRUE(dir.isValid());
+  const auto keyring = dir.filePath("pubring.kbx");
+  ASSERT_TRUE(WriteFile(keyring, "keyring"));
+
+  GpgKeySnapshot(dir.path()).Save(keys);
+
+  auto loaded = GpgKeySnapshot(dir.path()).Load(FetchRealKey);
+  ASSERT_TRUE(loaded.has_value());
+  ASSERT_EQ(loaded->size(), keys.size());
+
+  // a changed keyring invalidates the snapshot
+  ASSERT_TRUE(WriteFile(keyring, "changed keyring"));
+  ASSERT_FALSE(GpgKeySnapshot(dir.path()).Load(FetchRealKey).has_value());
+}
+
+TEST_F(GpgCoreTest, CoreKeySnapshotReconcileTest) {
+  auto& getter = GpgKeyGetter::GetInstance(kGpgFrontendDefaultChannel);
+  ASSERT_TRUE(getter.FlushKeyCache());
+
+  // the snapshot is written in the background
+  ASSERT_TRUE(WaitUntil([&]() { return getter.LoadKeyCacheSnapshot(); }));
+
+  // nothing changed since the listing which saved the snapshot
+  ASSERT_TRUE(getter.ReconcileKeyCache().isEmpty());
+  ASSERT_TRUE(getter.GetKeyPtr("9490795B78F8AFE9F93BD09281704859182661FB") !=
+              nullptr);
+}
+
+}  // namespace GpgFrontend::Test
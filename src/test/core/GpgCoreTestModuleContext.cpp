@@ -0,0 +1,189 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include "GpgCoreTest.h"
+#include "GpgCoreTestUtils.h"
+#include "core/module/GlobalModuleContext.h"
+#include "core/module/Module.h"
+
+namespace GpgFrontend::Test {
+
+namespace {
+
+class TestModule : public Module::Module {
+ public:
+  TestModule(const QString& id, bool gated)
+      : Module::Module(id, "1.0.0", {}), open_(!gated) {}
+
+  auto Register() -> int override { return 0; }
+
+  auto Active() -> int override { return 0; }
+
+  auto Exec(Module::EventReference event) -> int override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cond_.wait(lock, [this]() { return open_; });
+
+    trigger_ids_.append(event->GetTriggerIdentifier());
+    executed++;
+    return 0;
+  }
+
+  auto Deactivate() -> int override { return 0; }
+
+  auto UnRegister() -> int override { return 0; }
+
+  /**
+   * @brief let the blocked and all later executions run
+   *
+   */
+  void Open() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      open_ = true;
+    }
+    cond_.notify_all();
+  }
+
+  auto TriggerIds() -> QStringList {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return trigger_ids_;
+  }
+
+  std::atomic_int executed = 0;
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool open_;
+  QStringList trigger_ids_;
+};
+
+auto RegisterTestModule(Module::GlobalModuleContext& ctx,
+                        const QSharedPointer<TestModule>& module) -> bool {
+  const auto id = module->GetModuleIdentifier();
+  return ctx.RegisterModule(module, false) && ctx.ActiveModule(id) &&
+         ctx.ListenEvent(id, "TEST_EVENT");
+}
+
+}  // namespace
+
+TEST_F(GpgCoreTest, CoreModuleQueueIsolationTest) {
+  Module::GlobalModuleContext ctx;
+
+  auto slow = SecureCreateSharedObject<TestModule>("test.module.slow", true);
+  auto fast = SecureCreateSharedObject<TestModule>("test.module.fast", false);
+  ASSERT_TRUE(RegisterTestModule(ctx, slow));
+  ASSERT_TRUE(RegisterTestModule(ctx, fast));
+
+  // modules registered one after another don't share a runner
+  ASSERT_NE(ctx.GetTaskRunner(QString("test.module.slow")).value(),
+            ctx.GetTaskRunner(QString("test.module.fast")).value());
+
+  // modules not registered yet fall back to the shared module runner
+  ASSERT_TRUE(ctx.GetTaskRunner(QString("test.module.unknown")).has_value());
+
+  QStringList trigger_ids;
+  for (int i = 0; i < 3; i++) {
+    auto event = SecureCreateSharedObject<Module::Event>("TEST_EVENT");
+    trigger_ids.append(event->GetTriggerIdentifier());
+    ASSERT_TRUE(ctx.TriggerEvent(event));
+  }
+
+  // the fast module doesn't wait for the slow one, which is blocked
+  ASSERT_TRUE(WaitUntil([&]() {
+    return ctx.GetModuleExecStatistics("test.module.fast").executed == 3;
+  }));
+  ASSERT_EQ(fast->TriggerIds(), trigger_ids);
+  ASSERT_EQ(ctx.GetModuleExecStatistics("test.module.fast").queue_depth, 0);
+
+  ASSERT_EQ(slow->executed, 0);
+  ASSERT_EQ(ctx.GetModuleExecStatistics("test.module.slow").queue_depth, 3);
+
+  slow->Open();
+  ASSERT_TRUE(WaitUntil([&]() {
+    return ctx.GetModuleExecStatistics("test.module.slow").executed == 3;
+  }));
+
+  // the events of a module run in the order they were triggered
+  ASSERT_EQ(slow->TriggerIds(), trigger_ids);
+  ASSERT_EQ(ctx.GetModuleExecStatistics("test.module.slow").queue_depth, 0);
+}
+
+TEST_F(GpgCoreTest, CoreModuleRunnerPoolTest) {
+  Module::GlobalModuleContext ctx;
+
+  // many modules share a bounded number of runners
+  QSet<QSharedPointer<Thread::TaskRunner>> runners;
+  for (int i = 0; i < 32; i++) {
+    auto module = SecureCreateSharedObject<TestModule>(
+        QString("test.module.pool.%1").arg(i), false);
+    ASSERT_TRUE(RegisterTestModule(ctx, module));
+
+    auto runner = ctx.GetTaskRunner(module->GetModuleIdentifier());
+    ASSERT_TRUE(runner.has_value());
+    ASSERT_EQ(runner.value(), ctx.GetTaskRunner(module.get()).value());
+    runners.insert(runner.value());
+  }
+  ASSERT_GT(runners.size(), 1);
+  ASSERT_LT(runners.size(), 32);
+}
+
+TEST_F(GpgCoreTest, CoreModuleQueueCoTenantTest) {
+  Module::GlobalModuleContext ctx;
+
+  // more modules than runners, so some of them live on the same runner
+  QContainer<QSharedPointer<TestModule>> modules;
+  for (int i = 0; i < 8; i++) {
+    auto module = SecureCreateSharedObject<TestModule>(
+        QString("test.module.tenant.%1").arg(i), i == 0);
+    ASSERT_TRUE(RegisterTestModule(ctx, module));
+    modules.append(module);
+  }
+
+  auto event = SecureCreateSharedObject<Module::Event>("TEST_EVENT");
+  ASSERT_TRUE(ctx.TriggerEvent(event));
+
+  // no module waits for the blocked one, not even the ones sharing its
+  // runner
+  ASSERT_TRUE(WaitUntil([&]() {
+    for (int i = 1; i < modules.size(); i++) {
+      if (modules[i]->executed != 1) return false;
+    }
+    return true;
+  }));
+  ASSERT_EQ(modules.front()->executed, 0);
+
+  modules.front()->Open();
+  ASSERT_TRUE(WaitUntil([&]() { return modules.front()->executed == 1; }));
+}
+
+}  // namespace GpgFrontend::Test
@@ -0,0 +1,138 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "GpgCoreTest.h"
+#include "core/thread/ReadinessBarrier.h"
+
+namespace GpgFrontend::Test {
+
+TEST_F(GpgCoreTest, CoreReadinessBarrierDependencyTest) {
+  Thread::ReadinessBarrier barrier;
+  barrier.AddStage("a");
+  barrier.AddStage("b", {"a"});
+  barrier.AddStage("c");
+
+  int calls = 0;
+  bool result = false;
+  barrier.OnReady([&](bool succeed) {
+    calls++;
+    result = succeed;
+  });
+
+  // b is done but waits for a
+  barrier.Resolve("b");
+  barrier.Resolve("c");
+  ASSERT_EQ(calls, 0);
+  ASSERT_FALSE(barrier.IsReady());
+
+  barrier.Resolve("a");
+  ASSERT_EQ(calls, 1);
+  ASSERT_TRUE(result);
+  ASSERT_TRUE(barrier.IsReady());
+
+  // repeated reports change nothing
+  barrier.Resolve("a");
+  ASSERT_EQ(calls, 1);
+
+  auto timings = barrier.GetTimings();
+  ASSERT_EQ(timings.size(), 3);
+  ASSERT_EQ(timings[0].stage, QString("a"));
+  ASSERT_EQ(timings[1].stage, QString("b"));
+  for (const auto& t : timings) ASSERT_EQ(t.state, 1);
+  ASSERT_GE(timings[1].resolved_ms, timings[0].resolved_ms);
+
+  // late listeners are called at once
+  bool late = false;
+  barrier.OnReady([&](bool succeed) { late = succeed; });
+  ASSERT_TRUE(late);
+}
+
+TEST_F(GpgCoreTest, CoreReadinessBarrierFailureTest) {
+  Thread::ReadinessBarrier barrier;
+  barrier.AddStage("a");
+  barrier.AddStage("b");
+
+  int calls = 0;
+  bool result = true;
+  barrier.OnReady([&](bool succeed) {
+    calls++;
+    result = succeed;
+  });
+
+  barrier.Resolve("a", false);
+  barrier.Resolve("b");
+  ASSERT_EQ(calls, 1);
+  ASSERT_FALSE(result);
+  ASSERT_FALSE(barrier.IsReady());
+}
+
+TEST_F(GpgCoreTest, CoreReadinessBarrierStartTest) {
+  Thread::ReadinessBarrier barrier;
+  barrier.AddStage("a");
+  barrier.AddStage("b");
+
+  // b only counts the time since it started
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  barrier.Start("b");
+  barrier.Resolve("a");
+  barrier.Resolve("b");
+  ASSERT_TRUE(barrier.IsReady());
+
+  auto timings = barrier.GetTimings();
+  ASSERT_EQ(timings.size(), 2);
+  ASSERT_EQ(timings[0].started_ms, -1);
+  ASSERT_GE(timings[1].started_ms, 50);
+  ASSERT_EQ(timings[1].own_ms,
+            timings[1].resolved_ms - timings[1].started_ms);
+}
+
+TEST_F(GpgCoreTest, CoreReadinessBarrierConcurrentTest) {
+  Thread::ReadinessBarrier barrier;
+  const int stages = 64;
+  for (int i = 0; i < stages; i++) barrier.AddStage(QString::number(i));
+
+  std::atomic_int calls = 0;
+  barrier.OnReady([&](bool) { calls++; });
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < stages; i++) {
+    threads.emplace_back([&barrier, i]() {
+      barrier.Resolve(QString::number(i));
+    });
+  }
+  for (auto& t : threads) t.join();
+
+  ASSERT_EQ(calls, 1);
+  ASSERT_TRUE(barrier.IsReady());
+}
+
+}  // namespace GpgFrontend::Test
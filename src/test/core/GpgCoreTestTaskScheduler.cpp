@@ -0,0 +1,97 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#include <chrono>
+#include <thread>
+
+#include "GpgCoreTest.h"
+#include "core/thread/TaskScheduler.h"
+
+namespace GpgFrontend::Test {
+
+TEST_F(GpgCoreTest, CoreTaskSchedulerDelayedTest) {
+  Thread::TaskScheduler scheduler;
+  scheduler.Start();
+
+  std::atomic_int fired = 0;
+  scheduler.PostDelayedTask("test_delayed", nullptr, [&]() { fired++; }, 100);
+  auto cancelled = scheduler.PostDelayedTask(
+      "test_cancelled", nullptr, [&]() { fired += 100; }, 200);
+  ASSERT_TRUE(scheduler.Cancel(cancelled));
+  ASSERT_FALSE(scheduler.Cancel(cancelled));
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  ASSERT_EQ(fired.load(), 0);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(400));
+  ASSERT_EQ(fired.load(), 1);
+  ASSERT_EQ(scheduler.GetPendingTaskCount(), 0);
+}
+
+TEST_F(GpgCoreTest, CoreTaskSchedulerPeriodicTest) {
+  Thread::TaskScheduler scheduler;
+  scheduler.Start();
+
+  std::atomic_int fired = 0;
+  auto id = scheduler.PostPeriodicTask(
+      "test_periodic", nullptr, [&]() { fired++; }, 50, "test_periodic");
+
+  // coalesced into the pending task
+  ASSERT_EQ(scheduler.PostPeriodicTask(
+                "test_periodic", nullptr, [&]() { fired += 100; }, 50,
+                "test_periodic"),
+            id);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(530));
+  ASSERT_TRUE(scheduler.Cancel(id));
+
+  auto count = fired.load();
+  ASSERT_GE(count, 5);
+  ASSERT_LE(count, 11);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  ASSERT_EQ(fired.load(), count);
+}
+
+TEST_F(GpgCoreTest, CoreTaskSchedulerLongDelayTest) {
+  Thread::TaskScheduler scheduler;
+  scheduler.Start();
+
+  // lands on a higher level of the wheel and has to cascade down
+  std::atomic_int fired = 0;
+  scheduler.PostDelayedTask("test_long", nullptr, [&]() { fired++; }, 1500);
+  scheduler.PostDelayedTask("test_short", nullptr, [&]() { fired++; }, 20);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1300));
+  ASSERT_EQ(fired.load(), 1);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(600));
+  ASSERT_EQ(fired.load(), 2);
+}
+
+}  // namespace GpgFrontend::Test
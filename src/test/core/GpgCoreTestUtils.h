@@ -0,0 +1,97 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+namespace GpgFrontend::Test {
+
+/**
+ * @brief skip the current benchmark unless the environment variable sets
+ * its scale, which is stored in var.
+ *
+ */
+#define GF_TEST_BENCH_SCALE(var, env)                  \
+  const auto var = qEnvironmentVariableIntValue(env); \
+  if ((var) <= 0) GTEST_SKIP() << env " not set"
+
+/**
+ * @brief deterministic test payload which doesn't repeat within 256 bytes
+ *
+ * @param size
+ * @return QByteArray
+ */
+inline auto MakeTestData(qsizetype size) -> QByteArray {
+  QByteArray data(size, Qt::Uninitialized);
+  for (qsizetype i = 0; i < size; i++) {
+    data[i] = static_cast<char>((i * 131) & 0xFF);
+  }
+  return data;
+}
+
+/**
+ * @brief
+ *
+ * @tparam Function
+ * @param f
+ * @return double wall time of f in seconds
+ */
+template <typename Function>
+auto MeasureSeconds(Function&& f) -> double {
+  const auto begin = std::chrono::steady_clock::now();
+  std::forward<Function>(f)();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       begin)
+      .count();
+}
+
+/**
+ * @brief poll the condition until it holds or the timeout is reached
+ *
+ * @tparam Predicate
+ * @param predicate
+ * @param timeout
+ * @return true if the condition holds
+ */
+template <typename Predicate>
+auto WaitUntil(Predicate&& predicate,
+               std::chrono::milliseconds timeout = std::chrono::seconds(30))
+    -> bool {
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (!predicate()) {
+    if (std::chrono::steady_clock::now() > deadline) return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return true;
+}
+
+}  // namespace GpgFrontend::Test
@@ -65,6 +65,15 @@ class UISignalStation : public QObject {
    */
   void SignalKeyDatabaseRefreshDone();
 
+  /**
+   * @brief only the given keys of the channel were re-listed, listeners
+   * update them in place instead of reloading the whole key database
+   *
+   * @param channel
+   * @param fprs
+   */
+  void SignalKeysChanged(int channel, QStringList fprs);
+
   /**
    * @brief
    *
@@ -98,6 +98,10 @@ CommonUtils::CommonUtils() : QWidget(nullptr) {
   connect(this, &CommonUtils::SignalKeyDatabaseRefreshDone,
           UISignalStation::GetInstance(),
           &UISignalStation::SignalKeyDatabaseRefreshDone);
+  connect(CoreSignalStation::GetInstance(),
+          &CoreSignalStation::SignalKeysChanged,
+          UISignalStation::GetInstance(),
+          &UISignalStation::SignalKeysChanged);
 
   // directly connect to SignalKeyStatusUpdated
   // to avoid the delay of signal emitting
@@ -193,16 +197,9 @@ void CommonUtils::SlotImportKeys(QWidget *parent, int channel,
   auto info =
       GpgKeyImportExporter::GetInstance(channel).ImportKey(GFBuffer(in_buffer));
 
-  auto *connection = new QMetaObject::Connection;
-  *connection =
-      connect(UISignalStation::GetInstance(),
-              &UISignalStation::SignalKeyDatabaseRefreshDone, this, [=]() {
-                (new KeyImportDetailDialog(channel, info, parent));
-                QObject::disconnect(*connection);
-                delete connection;
-              });
-
-  emit SignalKeyStatusUpdated();
+  refresh_imported_keys(channel, info, [=]() {
+    (new KeyImportDetailDialog(channel, info, parent));
+  });
 }
 
 void CommonUtils::SlotImportKeyFromFile(QWidget *parent, int channel) {
@@ -221,19 +218,39 @@ void CommonUtils::SlotImportKeyFromFile(QWidget *parent, int channel) {
     return;
   }
 
-  if (file_info.size() > static_cast<qint64>(1024 * 1024)) {
-    QMessageBox::critical(parent, tr("Error"),
-                          tr("The target file is too large for a keyring."));
-    return;
-  }
+  // gpgme reads the keyring straight from the file, so large keyrings
+  // don't need to be loaded into memory first
+  LOG_D() << "try to import key(s) from file: " << file_name
+          << "to channel: " << channel;
+
+  QPointer<QWidget> w_parent = parent;
+  auto *task = new Thread::Task(
+      [=](const DataObjectPtr &data_object) -> int {
+        auto info =
+            GpgKeyImportExporter::GetInstance(channel).ImportKey(file_name);
+        data_object->Swap({info});
+        return info != nullptr ? 0 : -1;
+      },
+      "import_key_from_file", TransferParams(),
+      [=](int ret, const DataObjectPtr &data_object) {
+        if (ret < 0 ||
+            !data_object->Check<QSharedPointer<GpgImportInformation>>()) {
+          QMessageBox::critical(w_parent, tr("Error"),
+                                tr("Failed to import key(s) from file: %1")
+                                    .arg(file_name));
+          return;
+        }
 
-  QByteArray key_buffer;
-  if (!ReadFile(file_name, key_buffer)) {
-    QMessageBox::critical(nullptr, tr("File Open Failed"),
-                          tr("Failed to open file: ") + file_name);
-    return;
-  }
-  SlotImportKeys(parent, channel, key_buffer);
+        auto info = ExtractParams<QSharedPointer<GpgImportInformation>>(
+            data_object, 0);
+        refresh_imported_keys(channel, info, [=]() {
+          (new KeyImportDetailDialog(channel, info, w_parent));
+        });
+      });
+
+  Thread::TaskRunnerGetter::GetInstance()
+      .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_GPG)
+      ->PostTask(task);
 }
 
 void CommonUtils::SlotImportKeyFromKeyServer(QWidget *parent, int channel) {
@@ -494,17 +511,40 @@ void CommonUtils::slot_update_key_from_server_finished(
     return;
   }
 
-  // refresh the key database
-  emit UISignalStation::GetInstance() -> SignalKeyDatabaseRefresh();
-
-  auto *connection = new QMetaObject::Connection;
-  *connection =
-      connect(UISignalStation::GetInstance(),
-              &UISignalStation::SignalKeyDatabaseRefreshDone, this, [=]() {
-                (new KeyImportDetailDialog(channel, info, this));
-                QObject::disconnect(*connection);
-                delete connection;
-              });
+  refresh_imported_keys(channel, info, [=]() {
+    (new KeyImportDetailDialog(channel, info, this));
+  });
+}
+
+void CommonUtils::refresh_imported_keys(
+    int channel, const QSharedPointer<GpgImportInformation> &info,
+    const std::function<void()> &callback) {
+  QStringList fprs;
+  for (const auto &imported_key : info->imported_keys) {
+    if (!imported_key.fpr.isEmpty()) fprs.append(imported_key.fpr);
+  }
+
+  SlotRefreshKeys(channel, fprs, callback);
+}
+
+void CommonUtils::SlotRefreshKeys(int channel, const QStringList &fprs,
+                                  const std::function<void()> &callback) {
+  auto *refresh_task = new Thread::Task(
+      [channel, fprs](DataObjectPtr) -> int {
+        LOG_D() << "refreshing" << fprs.size()
+                << "key(s) at channel: " << channel;
+        GpgAbstractKeyGetter::GetInstance(channel).RefreshKeys(fprs);
+        return 0;
+      },
+      "refresh_keys_task");
+
+  if (callback) {
+    connect(refresh_task, &Thread::Task::SignalTaskEnd, this, callback);
+  }
+
+  Thread::TaskRunnerGetter::GetInstance()
+      .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_GPG)
+      ->PostTask(refresh_task);
 }
 
 void CommonUtils::SlotRestartApplication(int code) {
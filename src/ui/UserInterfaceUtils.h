@@ -272,6 +272,18 @@ class CommonUtils : public QWidget {
    */
   void SlotRestartApplication(int);
 
+  /**
+   * @brief re-list only the given keys instead of flushing the whole key
+   * database, listeners hear about them through
+   * UISignalStation::SignalKeysChanged
+   *
+   * @param channel
+   * @param fprs
+   * @param callback called when the keys are re-listed, may be empty
+   */
+  void SlotRefreshKeys(int channel, const QStringList& fprs,
+                       const std::function<void()>& callback = {});
+
  private slots:
 
   /**
@@ -291,6 +303,18 @@ class CommonUtils : public QWidget {
  private:
   static QScopedPointer<CommonUtils> instance;  ///<
 
+  /**
+   * @brief re-list only the keys touched by an import, then call the
+   * callback
+   *
+   * @param channel
+   * @param info
+   * @param callback
+   */
+  void refresh_imported_keys(int channel,
+                             const QSharedPointer<GpgImportInformation>& info,
+                             const std::function<void()>& callback);
+
   bool application_need_to_restart_at_once_ = false;
 };
 
@@ -62,4 +62,19 @@ WaitingDialog::WaitingDialog(const QString& title, bool range, QWidget* parent)
 void WaitingDialog::SlotUpdateValue(int value) {
   if (pb_->maximum() > 0) pb_->setValue(value);
 }
+
+void WaitingDialog::SlotEnableCancel() {
+  if (cancel_button_ != nullptr) return;
+
+  cancel_button_ = new QPushButton(tr("Cancel"));
+  connect(cancel_button_, &QPushButton::clicked, this, [this]() {
+    // the operations already running are still waited for
+    cancel_button_->setEnabled(false);
+    cancel_button_->setText(tr("Cancelling..."));
+    emit SignalCancelRequested();
+  });
+
+  this->layout()->addWidget(cancel_button_);
+  this->setFixedSize(240, this->sizeHint().height());
+}
 }  // namespace GpgFrontend::UI
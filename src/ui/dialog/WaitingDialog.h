@@ -57,6 +57,13 @@ class WaitingDialog : public GeneralDialog {
    */
   void SlotUpdateValue(int value);
 
+  /**
+   * @brief show a cancel button which emits SignalCancelRequested(), the
+   * dialog stays open until the caller closes it.
+   *
+   */
+  void SlotEnableCancel();
+
  signals:
 
   /**
@@ -66,8 +73,15 @@ class WaitingDialog : public GeneralDialog {
    */
   void SignalUpdateValue(int value);
 
+  /**
+   * @brief
+   *
+   */
+  void SignalCancelRequested();
+
  private:
   QProgressBar* pb_;
+  QPushButton* cancel_button_ = nullptr;
 };
 
 }  // namespace GpgFrontend::UI
@@ -34,6 +34,7 @@
 #include "ui_ModuleControllerDialog.h"
 
 //
+#include "core/module/GlobalModuleContext.h"
 #include "core/module/ModuleManager.h"
 #include "ui/widgets/ModuleListView.h"
 
@@ -160,6 +161,43 @@ void ModuleControllerDialog::slot_load_module_details(
 
   info << Qt::endl;
 
+  const auto timings = module_manager_->GetModuleTimings();
+  if (timings.contains(module_id)) {
+    const auto timing = timings.value(module_id);
+
+    info << "# " << tr("STARTUP TIMING") << Qt::endl << Qt::endl;
+
+    info << " - " << tr("Load") << ": " << timing.load_us << " us"
+         << Qt::endl;
+    info << " - " << tr("Register") << ": " << timing.register_us << " us"
+         << Qt::endl;
+    info << " - " << tr("Activate") << ": " << timing.activate_us << " us"
+         << Qt::endl;
+
+    info << Qt::endl;
+  }
+
+  const auto stats = module_manager_->GetModuleExecStatistics(module_id);
+  if (stats.executed > 0 || stats.queue_depth > 0) {
+    info << "# " << tr("EVENT EXECUTION") << Qt::endl << Qt::endl;
+
+    info << " - " << tr("Queue Depth") << ": " << stats.queue_depth
+         << Qt::endl;
+    info << " - " << tr("Executed") << ": " << stats.executed << Qt::endl;
+    info << " - " << tr("Failed") << ": " << stats.failed << Qt::endl;
+    info << " - " << tr("Average Latency") << ": "
+         << (stats.executed > 0 ? stats.total_latency_us /
+                                      static_cast<qint64>(stats.executed)
+                                : 0)
+         << " us" << Qt::endl;
+    info << " - " << tr("Max Latency") << ": " << stats.max_latency_us << " us"
+         << Qt::endl;
+    info << " - " << tr("Max Wait") << ": " << stats.max_wait_us << " us"
+         << Qt::endl;
+
+    info << Qt::endl;
+  }
+
   info << "# " << tr("METADATA") << Qt::endl << Qt::endl;
 
 #if QT_VERSION >= QT_VERSION_CHECK(6, 4, 0)
@@ -167,8 +167,8 @@ void SmartCardControllerDialog::select_smart_card_by_serial_number(
     return;
   }
 
-  auto [err, status] =
-      GpgSmartCardManager::GetInstance(channel_).SelectCardBySerialNumber(
+  auto [err, status, card_info] =
+      GpgSmartCardManager::GetInstance(channel_).SelectAndFetchCardInfo(
           serial_number);
   if (err != GPG_ERR_NO_ERROR) {
     LOG_E() << "select card by serial number failed, err:" << CheckGpgError(err)
@@ -181,18 +181,24 @@ void SmartCardControllerDialog::select_smart_card_by_serial_number(
   LOG_D() << "selected smart card by serial number: " << serial_number;
 
   has_card_ = true;
-  fetch_smart_card_info(serial_number);
+  apply_smart_card_info(serial_number, card_info);
 }
 
 void SmartCardControllerDialog::fetch_smart_card_info(
     const QString& serial_number) {
   if (!has_card_) return;
 
+  apply_smart_card_info(
+      serial_number,
+      GpgSmartCardManager::GetInstance(channel_).FetchCardInfoBySerialNumber(
+          serial_number));
+}
+
+void SmartCardControllerDialog::apply_smart_card_info(
+    const QString& serial_number,
+    const QSharedPointer<GpgOpenPGPCard>& card_info) {
   reset_status();
 
-  auto card_info =
-      GpgSmartCardManager::GetInstance(channel_).FetchCardInfoBySerialNumber(
-          serial_number);
   if (card_info == nullptr) {
     LOG_E() << "card info is nullptr, serial number:" << serial_number;
     reset_status();
@@ -536,8 +542,8 @@ void SmartCardControllerDialog::modify_key_attribute(const QString& attr) {
     }
   }
 
-  auto [err, status] =
-      GpgSmartCardManager::GetInstance(channel_).ModifyAttr(attr, value);
+  auto [err, status] = GpgSmartCardManager::GetInstance(channel_).ModifyAttr(
+      ui_->currentCardComboBox->currentText(), attr, value);
 
   if (err != GPG_ERR_NO_ERROR) {
     LOG_D() << "SCD SETATTR command failed for attr:" << attr
@@ -551,8 +557,8 @@ void SmartCardControllerDialog::modify_key_attribute(const QString& attr) {
 }
 
 void SmartCardControllerDialog::modify_key_pin(const QString& pinref) {
-  auto [err, status] =
-      GpgSmartCardManager::GetInstance(channel_).ModifyPin(pinref);
+  auto [err, status] = GpgSmartCardManager::GetInstance(channel_).ModifyPin(
+      ui_->currentCardComboBox->currentText(), pinref);
 
   if (err != GPG_ERR_NO_ERROR) {
     CommonUtils::RaiseFailureMessageBox(this, err, status);
@@ -92,6 +92,13 @@ class SmartCardControllerDialog : public GeneralDialog {
    */
   void fetch_smart_card_info(const QString& serial_number);
 
+  /**
+   * @brief show the fetched card info or reset the dialog if there is none
+   *
+   */
+  void apply_smart_card_info(const QString& serial_number,
+                             const QSharedPointer<GpgOpenPGPCard>& card_info);
+
   /**
    * @brief
    *
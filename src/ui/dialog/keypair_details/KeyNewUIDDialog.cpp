@@ -30,7 +30,7 @@
 
 #include "core/function/gpg/GpgUIDOperator.h"
 #include "core/utils/CommonUtils.h"
-#include "ui/UISignalStation.h"
+#include "ui/UserInterfaceUtils.h"
 
 namespace GpgFrontend::UI {
 KeyNewUIDDialog::KeyNewUIDDialog(int channel, GpgKeyPtr key, QWidget* parent)
@@ -71,9 +71,11 @@ KeyNewUIDDialog::KeyNewUIDDialog(int channel, GpgKeyPtr key, QWidget* parent)
   this->setAttribute(Qt::WA_DeleteOnClose, true);
   this->setModal(true);
 
-  connect(this, &KeyNewUIDDialog::SignalUIDCreated,
-          UISignalStation::GetInstance(),
-          &UISignalStation::SignalKeyDatabaseRefresh);
+  connect(this, &KeyNewUIDDialog::SignalUIDCreated, this,
+          [channel = current_gpg_context_channel_,
+           fpr = m_key_->Fingerprint()]() {
+            CommonUtils::GetInstance()->SlotRefreshKeys(channel, {fpr});
+          });
   connect(this, &KeyNewUIDDialog::SignalUIDCreated, this,
           &KeyNewUIDDialog::close);
 }
@@ -160,6 +160,14 @@ KeyPairDetailTab::KeyPairDetailTab(int channel, GpgKeyPtr key, QWidget* parent)
   connect(UISignalStation::GetInstance(),
           &UISignalStation::SignalKeyDatabaseRefreshDone, this,
           &KeyPairDetailTab::slot_refresh_key);
+  connect(UISignalStation::GetInstance(), &UISignalStation::SignalKeysChanged,
+          this, [=](int channel, const QStringList& fprs) {
+            if (channel != current_gpg_context_channel_ ||
+                !fprs.contains(key_->Fingerprint())) {
+              return;
+            }
+            slot_refresh_key();
+          });
 
   slot_refresh_key_info();
   setAttribute(Qt::WA_DeleteOnClose, true);
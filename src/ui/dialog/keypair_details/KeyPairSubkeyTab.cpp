@@ -157,6 +157,15 @@ KeyPairSubkeyTab::KeyPairSubkeyTab(int channel, GpgKeyPtr key, QWidget* parent)
   connect(UISignalStation::GetInstance(),
           &UISignalStation::SignalKeyDatabaseRefreshDone, this,
           &KeyPairSubkeyTab::slot_refresh_subkey_list);
+  connect(UISignalStation::GetInstance(), &UISignalStation::SignalKeysChanged,
+          this, [=](int channel, const QStringList& fprs) {
+            if (channel != current_gpg_context_channel_ ||
+                !fprs.contains(key_->Fingerprint())) {
+              return;
+            }
+            slot_refresh_key_info();
+            slot_refresh_subkey_list();
+          });
 
   base_layout->setContentsMargins(0, 0, 0, 0);
 
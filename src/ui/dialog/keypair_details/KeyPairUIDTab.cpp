@@ -31,7 +31,9 @@
 #include "core/function/gpg/GpgKeyGetter.h"
 #include "core/function/gpg/GpgKeyManager.h"
 #include "core/function/gpg/GpgUIDOperator.h"
+#include "core/thread/TaskRunnerGetter.h"
 #include "ui/UISignalStation.h"
+#include "ui/UserInterfaceUtils.h"
 #include "ui/dialog/RevocationOptionsDialog.h"
 #include "ui/dialog/keypair_details/KeyNewUIDDialog.h"
 #include "ui/dialog/keypair_details/KeyUIDSignDialog.h"
@@ -107,15 +109,27 @@ KeyPairUIDTab::KeyPairUIDTab(int channel, GpgKeyPtr key, QWidget* parent)
   connect(UISignalStation::GetInstance(),
           &UISignalStation::SignalKeyDatabaseRefreshDone, this,
           &KeyPairUIDTab::slot_refresh_key);
+  connect(UISignalStation::GetInstance(), &UISignalStation::SignalKeysChanged,
+          this, [=](int channel, const QStringList& fprs) {
+            if (channel != current_gpg_context_channel_ ||
+                !fprs.contains(m_key_->Fingerprint())) {
+              return;
+            }
+            slot_refresh_key();
+          });
 
-  connect(this, &KeyPairUIDTab::SignalUpdateUIDInfo,
-          UISignalStation::GetInstance(),
-          &UISignalStation::SignalKeyDatabaseRefresh);
+  // uid and signature edits only change this key
+  connect(this, &KeyPairUIDTab::SignalUpdateUIDInfo, this, [=]() {
+    CommonUtils::GetInstance()->SlotRefreshKeys(current_gpg_context_channel_,
+                                                {m_key_->Fingerprint()});
+  });
 
   setLayout(vbox_layout);
   setAttribute(Qt::WA_DeleteOnClose, true);
 
+  // show the cached key first; it is listed without signatures and tofu info
   slot_refresh_uid_list();
+  slot_refresh_key();
 }
 
 void KeyPairUIDTab::create_uid_list() {
@@ -511,16 +525,42 @@ void KeyPairUIDTab::slot_del_sign() {
 }
 
 void KeyPairUIDTab::slot_refresh_key() {
-  // refresh the key
-  auto refreshed_key = GpgKeyGetter::GetInstance(current_gpg_context_channel_)
-                           .GetKeyPtr(m_key_->ID());
-  assert(refreshed_key != nullptr);
+  // the detailed listing asks gpg for every signature, keep it off the gui
+  auto channel = current_gpg_context_channel_;
+  auto key_id = m_key_->ID();
+  QPointer<KeyPairUIDTab> self(this);
+
+  auto* task = new Thread::Task(
+      [=](const DataObjectPtr& data_object) -> int {
+        auto key = GpgKeyGetter::GetInstance(channel).GetKeyWithDetails(key_id);
+        data_object->Swap({key});
+        return 0;
+      },
+      "key_uid_tab_refresh_key", TransferParams(),
+      [=](int ret, const DataObjectPtr& data_object) {
+        if (self == nullptr) return;
+
+        GpgKeyPtr refreshed_key;
+        if (ret >= 0 && data_object->Check<GpgKeyPtr>()) {
+          refreshed_key = ExtractParams<GpgKeyPtr>(data_object, 0);
+        }
+
+        // fall back to the cached key, it may have been deleted meanwhile
+        if (refreshed_key == nullptr) {
+          refreshed_key = GpgKeyGetter::GetInstance(channel).GetKeyPtr(key_id);
+        }
+        if (refreshed_key == nullptr) return;
+
+        std::swap(self->m_key_, refreshed_key);
 
-  std::swap(this->m_key_, refreshed_key);
+        self->slot_refresh_uid_list();
+        self->slot_refresh_tofu_info();
+        self->slot_refresh_sig_list();
+      });
 
-  this->slot_refresh_uid_list();
-  this->slot_refresh_tofu_info();
-  this->slot_refresh_sig_list();
+  Thread::TaskRunnerGetter::GetInstance()
+      .GetTaskRunner(Thread::TaskRunnerGetter::kTaskRunnerType_GPG_Worker)
+      ->PostTask(task);
 }
 
 void KeyPairUIDTab::slot_rev_uid() {
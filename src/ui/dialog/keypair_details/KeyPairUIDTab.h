@@ -123,7 +123,8 @@ class KeyPairUIDTab : public QWidget {
   void slot_del_sign();
 
   /**
-   * @brief
+   * @brief reload the key with signatures and tofu info on a gpg worker,
+   * then refresh the lists on the gui thread
    *
    */
   void slot_refresh_key();
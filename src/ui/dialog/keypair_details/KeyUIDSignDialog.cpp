@@ -29,7 +29,7 @@
 #include "KeyUIDSignDialog.h"
 
 #include "core/function/gpg/GpgKeyManager.h"
-#include "ui/UISignalStation.h"
+#include "ui/UserInterfaceUtils.h"
 #include "ui/widgets/KeyList.h"
 
 namespace GpgFrontend::UI {
@@ -98,9 +98,12 @@ KeyUIDSignDialog::KeyUIDSignDialog(int channel, const GpgKeyPtr& key,
 
   setAttribute(Qt::WA_DeleteOnClose, true);
 
-  connect(this, &KeyUIDSignDialog::SignalKeyUIDSignUpdate,
-          UISignalStation::GetInstance(),
-          &UISignalStation::SignalKeyDatabaseRefresh);
+  // only the signed key changes
+  connect(this, &KeyUIDSignDialog::SignalKeyUIDSignUpdate, this,
+          [channel = current_gpg_context_channel_,
+           fpr = m_key_->Fingerprint()]() {
+            CommonUtils::GetInstance()->SlotRefreshKeys(channel, {fpr});
+          });
 }
 
 void KeyUIDSignDialog::slot_sign_key(bool) {
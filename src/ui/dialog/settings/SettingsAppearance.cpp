@@ -63,6 +63,11 @@ AppearanceTab::AppearanceTab(QWidget* parent)
   ui_->fontSizeTextEditorLabel->setText(tr("Text Editor"));
   ui_->fontSizeInformationBoardLabel->setText(tr("Status Panel"));
 
+  ui_->textEditorBox->setTitle(tr("Text Editor"));
+  ui_->largeFileViewThresholdLabel->setText(
+      tr("Open files larger than this as read only views"));
+  ui_->largeFileViewThresholdSpinBox->setSuffix(tr(" MB"));
+
   icon_size_group_ = new QButtonGroup(this);
   icon_size_group_->addButton(ui_->smallRadioButton, 1);
   icon_size_group_->addButton(ui_->mediumRadioButton, 2);
@@ -130,6 +135,9 @@ void AppearanceTab::SetSettings() {
   }
   ui_->fontSizeTextEditorLabelSpinBox->setValue(text_editor_info_font_size);
 
+  ui_->largeFileViewThresholdSpinBox->setValue(
+      appearance.large_file_view_threshold_mb);
+
   // init available styles
   for (const auto& s : QStyleFactory::keys()) {
     ui_->themeComboBox->addItem(s.toLower());
@@ -207,6 +215,8 @@ void AppearanceTab::ApplySettings() {
       ui_->fontSizeInformationBoardSpinBox->value();
   appearance.text_editor_font_size =
       ui_->fontSizeTextEditorLabelSpinBox->value();
+  appearance.large_file_view_threshold_mb =
+      ui_->largeFileViewThresholdSpinBox->value();
 
   appearance.tool_bar_crypto_operas_type = 0;
   appearance.tool_bar_crypto_operas_type |=
@@ -51,6 +51,8 @@ GeneralTab::GeneralTab(QWidget* parent)
       tr("Import files dropped on the Key List without confirmation."));
   ui_->disableLoadingModulesCheckBox->setText(
       tr("Disable loading of all modules (including integrated modules)"));
+  ui_->batchParallelismLabel->setText(
+      tr("Files or texts processed at the same time"));
 
   ui_->langBox->setTitle(tr("Language"));
   ui_->langNoteLabel->setText(
@@ -128,6 +130,12 @@ void GeneralTab::SetSettings() {
   ui_->disableLoadingModulesCheckBox->setCheckState(
       disable_loading_all_modules ? Qt::Checked : Qt::Unchecked);
 
+  auto batch_opera_parallelism =
+      settings
+          .value("basic/batch_opera_parallelism", QThread::idealThreadCount())
+          .toInt();
+  ui_->batchParallelismSpinBox->setValue(batch_opera_parallelism);
+
   auto lang_key = settings.value("basic/lang").toString();
   auto lang_value = lang_.value(lang_key);
   if (!lang_.empty()) {
@@ -149,6 +157,8 @@ void GeneralTab::ApplySettings() {
                     ui_->importConfirmationCheckBox->isChecked());
   settings.setValue("basic/disable_loading_all_modules",
                     ui_->disableLoadingModulesCheckBox->isChecked());
+  settings.setValue("basic/batch_opera_parallelism",
+                    ui_->batchParallelismSpinBox->value());
   settings.setValue("basic/lang", lang_.key(ui_->langSelectBox->currentText()));
 }
 
@@ -28,6 +28,7 @@
 
 #include "GpgOperaHelper.h"
 
+#include "core/function/GlobalSettingStation.h"
 #include "core/function/gpg/GpgFileOpera.h"
 #include "core/function/result_analyse/GpgDecryptResultAnalyse.h"
 #include "core/function/result_analyse/GpgEncryptResultAnalyse.h"
@@ -36,11 +37,33 @@
 #include "core/model/GpgDecryptResult.h"
 #include "core/model/GpgEncryptResult.h"
 #include "core/model/GpgSignResult.h"
+#include "core/thread/AsyncBatch.h"
 #include "core/utils/GpgUtils.h"
 #include "ui/dialog/WaitingDialog.h"
 
 namespace GpgFrontend::UI {
 
+namespace {
+
+/**
+ * @brief fill the placeholder pushed by BuildOperas, results therefore keep
+ * the order of the inputs whatever order the operations finish in.
+ *
+ * @param opera_results
+ * @param slot
+ * @param result
+ */
+void SetOperaResult(QContainer<GpgOperaResult>& opera_results, qsizetype slot,
+                    GpgOperaResult result) {
+  assert(slot >= 0 && slot < opera_results.size());
+  if (slot < 0 || slot >= opera_results.size()) return;
+
+  result.size = opera_results[slot].size;
+  opera_results[slot] = std::move(result);
+}
+
+}  // namespace
+
 void GpgOperaHelper::BuildOperas(QSharedPointer<GpgOperaContextBasement>& base,
                                  int category, int channel,
                                  const GpgOperaFactory& f) {
@@ -49,16 +72,30 @@ void GpgOperaHelper::BuildOperas(QSharedPointer<GpgOperaContextBasement>& base,
   auto context = GetGpgOperaContextFromBasement(base, category);
   if (context == nullptr) return;
 
+  // every opera owns the result slot at the same index, filled in when the
+  // opera is done; those never started keep the placeholder
+  auto& opera_results = context->base->opera_results;
+  context->result_offset = opera_results.size();
+
   if (!context->paths.isEmpty()) {
     assert(context->paths.size() == context->o_paths.size());
 
     for (int i = 0; i < context->paths.size(); i++) {
+      const auto info = QFileInfo(context->paths[i]);
+      auto placeholder = GpgOperaResult{-1, "# " + tr("Operation Cancelled"),
+                                        info.fileName()};
+      if (info.isFile()) placeholder.size = info.size();
+      opera_results.push_back(placeholder);
       context->base->operas.push_back(f(context, channel, i));
     }
   }
 
   if (!context->buffers.isEmpty()) {
     for (int i = 0; i < context->buffers.size(); i++) {
+      auto placeholder =
+          GpgOperaResult{-1, "# " + tr("Operation Cancelled"), {}};
+      placeholder.size = static_cast<qint64>(context->buffers[i].Size());
+      opera_results.push_back(placeholder);
       context->base->operas.push_back(f(context, channel, i));
     }
   }
@@ -81,6 +118,7 @@ auto GpgOperaHelper::BuildSimpleGpgFileOperasHelper(
     OperaFunc opera_func) -> OperaWaitingCb {
   const auto& path = context->paths[index];
   const auto& o_path = context->o_paths[index];
+  const auto slot = context->result_offset + index;
   auto& opera_results = context->base->opera_results;
 
   return [=, &opera_results](const OperaWaitingHd& op_hd) {
@@ -91,14 +129,16 @@ auto GpgOperaHelper::BuildSimpleGpgFileOperasHelper(
           op_hd();
 
           if (CheckGpgError(err) == GPG_ERR_NOT_SUPPORTED) {
-            opera_results.append({-1, "# " + tr("Operation Not Supported"),
-                                  QFileInfo(path).fileName()});
+            SetOperaResult(opera_results, slot,
+                           {-1, "# " + tr("Operation Not Supported"),
+                            QFileInfo(path).fileName()});
             return;
           }
 
           if (CheckGpgError(err) == GPG_ERR_USER_1 || data_obj == nullptr ||
               !data_obj->Check<ResultType>()) {
-            opera_results.append(
+            SetOperaResult(
+                opera_results, slot,
                 {-1, "# " + tr("Critical Error"), QFileInfo(path).fileName()});
             return;
           }
@@ -109,7 +149,8 @@ auto GpgOperaHelper::BuildSimpleGpgFileOperasHelper(
 
           HandleExtraLogicIfNeeded(context, result_analyse);
 
-          opera_results.append(
+          SetOperaResult(
+              opera_results, slot,
               {result_analyse.GetStatus(), result_analyse.GetResultReport(),
                QFileInfo(path.isEmpty() ? o_path : path).fileName()});
         });
@@ -123,6 +164,7 @@ auto GpgOperaHelper::BuildComplexGpgFileOperasHelper(
     OperaFunc opera_func) -> OperaWaitingCb {
   const auto& path = context->paths[index];
   const auto& o_path = context->o_paths[index];
+  const auto slot = context->result_offset + index;
   auto& opera_results = context->base->opera_results;
 
   return [=, &opera_results](const OperaWaitingHd& op_hd) {
@@ -133,14 +175,16 @@ auto GpgOperaHelper::BuildComplexGpgFileOperasHelper(
           op_hd();
 
           if (CheckGpgError(err) == GPG_ERR_NOT_SUPPORTED) {
-            opera_results.append({-1, "# " + tr("Operation Not Supported"),
-                                  QFileInfo(path).fileName()});
+            SetOperaResult(opera_results, slot,
+                           {-1, "# " + tr("Operation Not Supported"),
+                            QFileInfo(path).fileName()});
             return;
           }
 
           if (CheckGpgError(err) == GPG_ERR_USER_1 || data_obj == nullptr ||
               !data_obj->Check<ResultTypeA, ResultTypeB>()) {
-            opera_results.append(
+            SetOperaResult(
+                opera_results, slot,
                 {-1, "# " + tr("Critical Error"), QFileInfo(path).fileName()});
             return;
           }
@@ -158,7 +202,8 @@ auto GpgOperaHelper::BuildComplexGpgFileOperasHelper(
 
           HandleExtraLogicIfNeeded(context, result_analyse_2);
 
-          opera_results.append(
+          SetOperaResult(
+              opera_results, slot,
               {std::min(result_analyse_1.GetStatus(),
                         result_analyse_2.GetStatus()),
                result_analyse_1.GetResultReport() +
@@ -173,6 +218,7 @@ auto GpgOperaHelper::BuildSimpleGpgOperasHelper(
     QSharedPointer<GpgOperaContext>& context, int channel, int index,
     OperaFunc opera_func) -> OperaWaitingCb {
   const auto& buffer = context->buffers[index];
+  const auto slot = context->result_offset + index;
   auto& opera_results = context->base->opera_results;
 
   return [=, &opera_results](const OperaWaitingHd& op_hd) {
@@ -182,13 +228,15 @@ auto GpgOperaHelper::BuildSimpleGpgOperasHelper(
       op_hd();
 
       if (CheckGpgError(err) == GPG_ERR_NOT_SUPPORTED) {
-        opera_results.append({-1, "# " + tr("Operation Not Supported"), {}});
+        SetOperaResult(opera_results, slot,
+                       {-1, "# " + tr("Operation Not Supported"), {}});
         return;
       }
 
       if (CheckGpgError(err) == GPG_ERR_USER_1 || data_obj == nullptr ||
           !data_obj->Check<ResultType, GFBuffer>()) {
-        opera_results.append({-1, "# " + tr("Critical Error"), {}});
+        SetOperaResult(opera_results, slot,
+                       {-1, "# " + tr("Critical Error"), {}});
         return;
       }
 
@@ -205,7 +253,7 @@ auto GpgOperaHelper::BuildSimpleGpgOperasHelper(
       auto o_buffer = ExtractParams<GFBuffer>(data_obj, 1);
       opera_result.o_buffer = o_buffer;
 
-      opera_results.append(opera_result);
+      SetOperaResult(opera_results, slot, opera_result);
     });
   };
 }
@@ -216,6 +264,7 @@ auto GpgOperaHelper::BuildComplexGpgOperasHelper(
     QSharedPointer<GpgOperaContext>& context, int channel, int index,
     OperaFunc opera_func) -> OperaWaitingCb {
   const auto& buffer = context->buffers[index];
+  const auto slot = context->result_offset + index;
   auto& opera_results = context->base->opera_results;
 
   return [=, &opera_results](const OperaWaitingHd& op_hd) {
@@ -225,13 +274,15 @@ auto GpgOperaHelper::BuildComplexGpgOperasHelper(
       op_hd();
 
       if (CheckGpgError(err) == GPG_ERR_NOT_SUPPORTED) {
-        opera_results.append({-1, "# " + tr("Operation Not Supported"), {}});
+        SetOperaResult(opera_results, slot,
+                       {-1, "# " + tr("Operation Not Supported"), {}});
         return;
       }
 
       if (CheckGpgError(err) == GPG_ERR_USER_1 || data_obj == nullptr ||
           !data_obj->Check<ResultTypeA, ResultTypeB, GFBuffer>()) {
-        opera_results.append({-1, "# " + tr("Critical Error"), {}});
+        SetOperaResult(opera_results, slot,
+                       {-1, "# " + tr("Critical Error"), {}});
         return;
       }
 
@@ -257,7 +308,7 @@ auto GpgOperaHelper::BuildComplexGpgOperasHelper(
       auto o_buffer = ExtractParams<GFBuffer>(data_obj, 2);
       opera_result.o_buffer = o_buffer;
 
-      opera_results.append(opera_result);
+      SetOperaResult(opera_results, slot, opera_result);
     });
   };
 }
@@ -449,38 +500,66 @@ auto GpgOperaHelper::BuildOperasArchiveDecryptVerify(
 
 void GpgOperaHelper::WaitForMultipleOperas(
     QWidget* parent, const QString& title,
-    const QContainer<OperaWaitingCb>& operas) {
+    const QSharedPointer<GpgOperaContextBasement>& base) {
+  const auto& operas = base->operas;
   if (operas.isEmpty()) return;
 
+  // operas[i] fills opera_results[i], see BuildOperas()
+  assert(operas.size() == base->opera_results.size());
+
+  auto parallelism =
+      GetSettings()
+          .value("basic/batch_opera_parallelism", QThread::idealThreadCount())
+          .toInt();
+  parallelism = std::max(1, parallelism);
+
+  auto batch = QSharedPointer<Thread::AsyncBatch>::create(
+      operas.size(), parallelism,
+      [operas](qsizetype index, const Thread::AsyncBatch::DoneHandler& done) {
+        operas[index](done);
+      });
+
   QEventLoop looper;
   QPointer<WaitingDialog> const dialog =
       new WaitingDialog(title, operas.size() > 1, parent);
   connect(dialog, &QDialog::finished, &looper, &QEventLoop::quit);
+
+  if (operas.size() > 1) {
+    dialog->SlotEnableCancel();
+    connect(dialog, &WaitingDialog::SignalCancelRequested, dialog,
+            [batch]() { batch->Cancel(); });
+  }
   dialog->show();
 
-  std::atomic<int> remaining_tasks(static_cast<int>(operas.size()));
-  const auto tasks_count = operas.size();
+  batch->OnProgress([dialog](qsizetype done, qsizetype total) {
+    if (dialog == nullptr) return;
 
-  for (const auto& opera : operas) {
-    QTimer::singleShot(64, parent, [=, &remaining_tasks]() {
-      opera([dialog, &remaining_tasks, tasks_count]() {
-        if (dialog == nullptr) return;
+    emit dialog->SignalUpdateValue(static_cast<int>(done * 100 / total));
+    QCoreApplication::processEvents();
+  });
 
-        const auto pg_value =
-            static_cast<double>(tasks_count - remaining_tasks + 1) * 100.0 /
-            static_cast<double>(tasks_count);
-        emit dialog->SignalUpdateValue(static_cast<int>(pg_value));
-        QCoreApplication::processEvents();
+  batch->OnFinished([dialog]() {
+    if (dialog == nullptr) return;
 
-        if (--remaining_tasks == 0) {
-          dialog->close();
-          dialog->accept();
-        }
-      });
-    });
-  }
+    dialog->close();
+    dialog->accept();
+  });
+
+  QTimer::singleShot(64, parent, [batch]() { batch->Start(); });
 
   looper.exec();
+
+  const auto statistics = batch->GetStatistics();
+  for (qsizetype i = 0; i < statistics.item_ms.size(); i++) {
+    base->opera_results[i].elapsed_ms = statistics.item_ms[i];
+  }
+  base->elapsed_ms = statistics.elapsed_ms;
+  base->parallelism = statistics.parallelism;
+
+  LOG_D() << "batch of" << statistics.total << "operas done:" << statistics.done
+          << "skipped:" << statistics.skipped
+          << "max in flight:" << statistics.max_in_flight
+          << "elapsed ms:" << statistics.elapsed_ms;
 }
 
 auto GpgOperaHelper::BuildOperasEncrypt(
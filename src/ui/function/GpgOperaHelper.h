@@ -314,10 +314,12 @@ class GpgOperaHelper : QObject {
    *
    * @param parent
    * @param title
-   * @param operas
+   * @param base operas are run at most basic/batch_opera_parallelism at a
+   * time, their timings are written back to base
    */
-  static void WaitForMultipleOperas(QWidget* parent, const QString& title,
-                                    const QContainer<OperaWaitingCb>& operas);
+  static void WaitForMultipleOperas(
+      QWidget* parent, const QString& title,
+      const QSharedPointer<GpgOperaContextBasement>& base);
 };
 
 }  // namespace GpgFrontend::UI
\ No newline at end of file
@@ -465,9 +465,12 @@ class MainWindow : public GeneralMainWindow {
    * @brief
    *
    * @param opera_results
+   * @param elapsed_ms wall time of the whole batch, -1 if unknown
+   * @param parallelism
    */
   void slot_result_analyse_show_helper(
-      const QContainer<GpgOperaResult>& opera_results);
+      const QContainer<GpgOperaResult>& opera_results, qint64 elapsed_ms = -1,
+      int parallelism = 0);
 
   /**
    * @brief
@@ -473,7 +473,8 @@ void MainWindow::slot_result_analyse_show_helper(
 }
 
 void MainWindow::slot_result_analyse_show_helper(
-    const QContainer<GpgOperaResult>& opera_results) {
+    const QContainer<GpgOperaResult>& opera_results, qint64 elapsed_ms,
+    int parallelism) {
   if (opera_results.empty()) {
     slot_refresh_info_board(0, "");
     return;
@@ -490,6 +491,11 @@ void MainWindow::slot_result_analyse_show_helper(
   int fail_count = 0;
   int warn_count = 0;
 
+  // throughput only counts what actually ran to the end, cancelled and
+  // failed items keep the size of their input placeholder
+  int completed_count = 0;
+  qint64 completed_bytes = 0;
+
   for (const auto& opera_result : opera_results) {
     // Update overall status
     overall_status = std::min(overall_status, opera_result.status);
@@ -508,9 +514,17 @@ void MainWindow::slot_result_analyse_show_helper(
       warn_count++;
     }
 
+    if (opera_result.status >= 0 && opera_result.elapsed_ms >= 0) {
+      completed_count++;
+      if (opera_result.size > 0) completed_bytes += opera_result.size;
+    }
+
     // Append detailed report for each operation
-    report.append(QString("[ %1 ] %2\n\n%3\n")
-                      .arg(status_text, opera_result.tag, opera_result.report));
+    auto title = QString("[ %1 ] %2").arg(status_text, opera_result.tag);
+    if (opera_result.elapsed_ms >= 0) {
+      title += " " + tr("(%1 ms)").arg(opera_result.elapsed_ms);
+    }
+    report.append(QString("%1\n\n%2\n").arg(title, opera_result.report));
   }
 
   // Prepare summary section
@@ -530,6 +544,22 @@ void MainWindow::slot_result_analyse_show_helper(
                    tr("Warning Objects: %1\n").arg(warning_tags.join(", ")));
   }
 
+  if (elapsed_ms >= 0) {
+    // avoid dividing by zero for batches finishing within a millisecond
+    const auto seconds = static_cast<double>(std::max<qint64>(elapsed_ms, 1)) /
+                         1000.0;
+
+    summary.append("- " + tr("Elapsed Time: %1 ms\n").arg(elapsed_ms));
+    summary.append("- " + tr("Parallelism: %1\n").arg(parallelism));
+    const auto objects_per_second =
+        static_cast<double>(completed_count) / seconds;
+    const auto mib_per_second =
+        static_cast<double>(completed_bytes) / 1048576.0 / seconds;
+    summary.append("- " + tr("Throughput: %1 objects/s, %2 MiB/s\n")
+                              .arg(objects_per_second, 0, 'f', 2)
+                              .arg(mib_per_second, 0, 'f', 2));
+  }
+
   // Display the final report in the info board
   if (opera_results.size() == 1) {
     slot_refresh_info_board(overall_status, report.join(""));
@@ -1028,9 +1058,10 @@ void MainWindow::slot_gpg_opera_buffer_show_helper(
 void MainWindow::exec_operas_helper(
     const QString& task,
     const QSharedPointer<GpgOperaContextBasement>& contexts) {
-  GpgOperaHelper::WaitForMultipleOperas(this, task, contexts->operas);
+  GpgOperaHelper::WaitForMultipleOperas(this, task, contexts);
   slot_gpg_opera_buffer_show_helper(contexts->opera_results);
-  slot_result_analyse_show_helper(contexts->opera_results);
+  slot_result_analyse_show_helper(contexts->opera_results, contexts->elapsed_ms,
+                                  contexts->parallelism);
 }
 
 }  // namespace GpgFrontend::UI
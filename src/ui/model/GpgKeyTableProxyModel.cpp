@@ -88,24 +88,7 @@ auto GpgKeyTableProxyModel::filterAcceptsRow(
 
   if (filter_keywords_.isEmpty()) return true;
 
-  QStringList infos;
-  for (int column = 0; column < sourceModel()->columnCount(); ++column) {
-    auto index = sourceModel()->index(sourceRow, column, sourceParent);
-    infos << sourceModel()->data(index).toString();
-
-    if (key->KeyType() == GpgAbstractKeyType::kGPG_KEY) {
-      auto *k = dynamic_cast<GpgKey *>(key);
-      for (const auto &uid : k->UIDs()) {
-        infos << uid.GetUID();
-      }
-    }
-  }
-
-  return std::any_of(infos.cbegin(), infos.cend(), [&](const QString &info) {
-    return info.contains(filter_keywords_, Qt::CaseInsensitive);
-  });
-
-  return false;
+  return model_->IsRowMatchKeywords(sourceRow, filter_keywords_);
 }
 
 auto GpgKeyTableProxyModel::filterAcceptsColumn(
@@ -160,7 +143,7 @@ auto GpgKeyTableProxyModel::filterAcceptsColumn(
 }
 
 void GpgKeyTableProxyModel::SetSearchKeywords(const QString &keywords) {
-  this->filter_keywords_ = keywords;
+  this->filter_keywords_ = keywords.toCaseFolded();
   invalidateFilter();
 }
 
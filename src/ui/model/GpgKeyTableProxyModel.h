@@ -96,7 +96,7 @@ class GpgKeyTableProxyModel : public QSortFilterProxyModel {
   QSharedPointer<GpgKeyTableModel> model_;
   GpgKeyTableDisplayMode display_mode_;
   GpgKeyTableColumn filter_columns_;
-  QString filter_keywords_;
+  QString filter_keywords_;  ///< case folded
   QStringList favorite_key_ids_;
   KeyFilter custom_filter_;
 
@@ -37,6 +37,8 @@ struct GpgOperaResult {
   QString report;
   QString tag;
   GFBuffer o_buffer;
+  qint64 size = -1;        ///< input size in bytes, -1 if unknown
+  qint64 elapsed_ms = -1;  ///< -1 if the operation never ran
 
   GpgOperaResult(int status, QString report, QString tag);
 };
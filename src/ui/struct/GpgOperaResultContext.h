@@ -53,6 +53,9 @@ struct GpgOperaContextBasement {
   QStringList unknown_fprs;
   bool ascii;
 
+  qint64 elapsed_ms = -1;  ///< wall time of the whole batch
+  int parallelism = 0;     ///< operations allowed to run at the same time
+
   QMap<int, GpgOperaCategory> categories;
 
   auto GetContextPath(int category) -> QStringList&;
@@ -73,6 +76,8 @@ struct GpgOperaContext {
   QStringList o_paths;
   QContainer<GFBuffer> buffers;
 
+  qsizetype result_offset = 0;  ///< first slot in base->opera_results
+
   explicit GpgOperaContext(QSharedPointer<GpgOperaContextBasement> base);
 };
 
@@ -42,6 +42,8 @@ struct AppearanceSO {
                                     GpgOperation::kDECRYPT |
                                     GpgOperation::kSIGN | GpgOperation::kVERIFY;
 
+  int large_file_view_threshold_mb = 64;
+
   bool save_window_state;
 
   explicit AppearanceSO(const QJsonObject& j) {
@@ -64,6 +66,10 @@ struct AppearanceSO {
       tool_bar_crypto_operas_type = static_cast<int>(v.toInt());
     }
 
+    if (const auto v = j["large_file_view_threshold_mb"]; v.isDouble()) {
+      large_file_view_threshold_mb = v.toInt();
+    }
+
     if (const auto v = j["save_window_state"]; v.isBool()) {
       save_window_state = v.toBool();
     }
@@ -77,6 +83,7 @@ struct AppearanceSO {
     j["tool_bar_icon_height"] = tool_bar_icon_height;
     j["tool_bar_button_style"] = tool_bar_button_style;
     j["tool_bar_crypto_operas_type"] = tool_bar_crypto_operas_type;
+    j["large_file_view_threshold_mb"] = large_file_view_threshold_mb;
 
     j["save_window_state"] = save_window_state;
     return j;
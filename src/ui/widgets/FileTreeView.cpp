@@ -31,7 +31,7 @@
 #include "core/utils/AsyncUtils.h"
 #include "core/utils/IOUtils.h"
 #include "ui/UISignalStation.h"
-#include "ui/function/GpgOperaHelper.h"
+#include "ui/dialog/WaitingDialog.h"
 
 namespace GpgFrontend::UI {
 
@@ -396,24 +396,39 @@ void FileTreeView::slot_calculate_hash() {
   if (GetSelectedPaths().empty()) return;
   auto selected_path = GetSelectedPaths().front();
 
-  GpgOperaHelper::WaitForOpera(
-      this->parentWidget(), tr("Calculating"), [=](const OperaWaitingHd& hd) {
-        RunOperaAsync(
-            [=](const DataObjectPtr& data_object) {
-              data_object->Swap({CalculateHash(selected_path)});
-              return 0;
-            },
-            [hd](int rtn, const DataObjectPtr& data_object) {
-              hd();
-              if (rtn < 0 || !data_object->Check<QString>()) {
-                return;
-              }
-              auto result = ExtractParams<QString>(data_object, 0);
-              emit UISignalStation::GetInstance() -> SignalRefreshInfoBoard(
-                  result, InfoBoardStatus::INFO_ERROR_OK);
-            },
-            "calculate_file_hash");
-      });
+  QPointer<WaitingDialog> const dialog =
+      new WaitingDialog(tr("Calculating"), true, this->parentWidget());
+
+  RunOperaAsync(
+      [=](const DataObjectPtr& data_object) {
+        auto last_percent = std::make_shared<int>(-1);
+        data_object->Swap({CalculateHash(
+            selected_path, [=](qint64 done, qint64 total) {
+              const auto percent =
+                  total > 0 ? static_cast<int>(done * 100 / total) : 100;
+              if (percent == *last_percent) return;
+              *last_percent = percent;
+
+              QMetaObject::invokeMethod(qApp, [dialog, percent]() {
+                if (dialog != nullptr) dialog->SlotUpdateValue(percent);
+              });
+            })});
+        return 0;
+      },
+      [dialog](int rtn, const DataObjectPtr& data_object) {
+        if (dialog != nullptr) {
+          dialog->close();
+          dialog->accept();
+        }
+
+        if (rtn < 0 || !data_object->Check<QString>()) {
+          return;
+        }
+        auto result = ExtractParams<QString>(data_object, 0);
+        emit UISignalStation::GetInstance() -> SignalRefreshInfoBoard(
+            result, InfoBoardStatus::INFO_ERROR_OK);
+      },
+      "calculate_file_hash");
 }
 
 void FileTreeView::slot_compress_files() {}
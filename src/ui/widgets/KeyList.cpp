@@ -30,6 +30,7 @@
 
 #include <cstddef>
 
+#include "core/function/CoreSignalStation.h"
 #include "core/function/GlobalSettingStation.h"
 #include "core/function/gpg/GpgAbstractKeyGetter.h"
 #include "core/function/gpg/GpgKeyGetter.h"
@@ -88,34 +89,12 @@ void KeyList::init() {
                                       KeyMenuAbility::kKEY_DATABASE);
   ui_->keyGroupButton->setHidden(~menu_ability_ & KeyMenuAbility::kKEY_GROUP);
 
-  auto* gpg_context_menu = new QMenu(this);
-  auto* gpg_context_groups = new QActionGroup(this);
-  gpg_context_groups->setExclusive(true);
-  auto key_db_infos = GetGpgKeyDatabaseInfos();
-
-  for (auto& key_db_info : key_db_infos) {
-    auto channel = key_db_info.channel;
-    auto key_db_name = key_db_info.name;
+  init_key_database_menu();
 
-    LOG_D() << "context grt channel: " << channel
-            << "database name: " << key_db_name;
-
-    auto* switch_context_action =
-        new QAction(QString("%1: %2").arg(channel).arg(key_db_name), this);
-    switch_context_action->setCheckable(true);
-    switch_context_action->setChecked(channel == current_gpg_context_channel_);
-    connect(switch_context_action, &QAction::toggled, this,
-            [this, channel](bool checked) {
-              if (checked) {
-                current_gpg_context_channel_ = channel;
-                ui_->channelLcdNumber->display(channel);
-                emit SignalRefreshDatabase();
-              }
-            });
-    gpg_context_groups->addAction(switch_context_action);
-    gpg_context_menu->addAction(switch_context_action);
-  }
-  ui_->switchContextButton->setMenu(gpg_context_menu);
+  // key databases other than the default one may still be loading
+  connect(CoreSignalStation::GetInstance(),
+          &CoreSignalStation::SignalKeyDatabaseReady, this,
+          &KeyList::init_key_database_menu);
 
   auto* column_type_menu = new QMenu(this);
 
@@ -315,6 +294,40 @@ auto KeyList::AddListGroupTab(
   return key_table;
 }
 
+void KeyList::init_key_database_menu() {
+  auto* gpg_context_menu = new QMenu(this);
+  auto* gpg_context_groups = new QActionGroup(gpg_context_menu);
+  gpg_context_groups->setExclusive(true);
+  auto key_db_infos = GetGpgKeyDatabaseInfos();
+
+  for (auto& key_db_info : key_db_infos) {
+    auto channel = key_db_info.channel;
+    auto key_db_name = key_db_info.name;
+
+    LOG_D() << "context grt channel: " << channel
+            << "database name: " << key_db_name;
+
+    auto* switch_context_action = new QAction(
+        QString("%1: %2").arg(channel).arg(key_db_name), gpg_context_menu);
+    switch_context_action->setCheckable(true);
+    switch_context_action->setChecked(channel == current_gpg_context_channel_);
+    connect(switch_context_action, &QAction::toggled, this,
+            [this, channel](bool checked) {
+              if (checked) {
+                current_gpg_context_channel_ = channel;
+                ui_->channelLcdNumber->display(channel);
+                emit SignalRefreshDatabase();
+              }
+            });
+    gpg_context_groups->addAction(switch_context_action);
+    gpg_context_menu->addAction(switch_context_action);
+  }
+
+  auto* old_menu = ui_->switchContextButton->menu();
+  ui_->switchContextButton->setMenu(gpg_context_menu);
+  if (old_menu != nullptr) old_menu->deleteLater();
+}
+
 void KeyList::SlotRefresh() {
   ui_->refreshKeyListButton->setDisabled(true);
   ui_->syncButton->setDisabled(true);
@@ -363,6 +363,12 @@ class KeyList : public QWidget {
    *
    */
   void filter_by_keyword();
+
+  /**
+   * @brief list the loaded key databases in the switch context menu
+   *
+   */
+  void init_key_database_menu();
 };
 
 }  // namespace GpgFrontend::UI
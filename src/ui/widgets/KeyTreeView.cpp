@@ -115,13 +115,19 @@ void KeyTreeView::init() {
                 this, model_->GetGpgContextChannel(), key);
           });
 
+  auto reload = [=] {
+    model_ = QSharedPointer<GpgKeyTreeModel>::create(
+        channel_, GpgAbstractKeyGetter::GetInstance(channel_).Fetch(),
+        [](auto) { return false; }, this);
+    proxy_model_.setSourceModel(model_.get());
+    proxy_model_.invalidate();
+  };
+
   connect(UISignalStation::GetInstance(),
-          &UISignalStation::SignalKeyDatabaseRefreshDone, this, [=] {
-            model_ = QSharedPointer<GpgKeyTreeModel>::create(
-                channel_, GpgAbstractKeyGetter::GetInstance(channel_).Fetch(),
-                [](auto) { return false; }, this);
-            proxy_model_.setSourceModel(model_.get());
-            proxy_model_.invalidate();
+          &UISignalStation::SignalKeyDatabaseRefreshDone, this, reload);
+  connect(UISignalStation::GetInstance(), &UISignalStation::SignalKeysChanged,
+          this, [=](int channel, const QStringList&) {
+            if (channel == channel_) reload();
           });
 }
 
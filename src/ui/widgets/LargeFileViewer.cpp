@@ -0,0 +1,135 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#include "ui/widgets/LargeFileViewer.h"
+
+#include <climits>
+#include <cstring>
+
+namespace GpgFrontend::UI {
+
+// a file without line breaks must not be decoded as a whole on every paint
+constexpr qint64 kMaxLineBytes = 16 * 1024;
+constexpr int kTextMargin = 4;
+
+LargeFileViewer::LargeFileViewer(const QString& path, QWidget* parent)
+    : QAbstractScrollArea(parent), file_(path) {
+  setFocusPolicy(Qt::StrongFocus);
+  viewport()->setBackgroundRole(QPalette::Base);
+
+  if (!file_.open(QIODevice::ReadOnly) || file_.size() <= 0) return;
+
+  size_ = file_.size();
+  base_ = reinterpret_cast<const char*>(file_.map(0, size_));
+  if (base_ == nullptr) return;
+
+  // index the start of every line
+  line_starts_.reserve(static_cast<size_t>(size_ / 64) + 1);
+  line_starts_.push_back(0);
+
+  qint64 pos = 0;
+  while (pos < size_) {
+    const auto* hit = static_cast<const char*>(
+        std::memchr(base_ + pos, '\n', static_cast<size_t>(size_ - pos)));
+    const auto end = hit != nullptr ? hit - base_ : size_;
+
+    max_line_length_ = std::max(max_line_length_, end - pos);
+    if (hit == nullptr) break;
+
+    pos = end + 1;
+    if (pos < size_) line_starts_.push_back(pos);
+  }
+
+  max_line_length_ = std::min(max_line_length_, kMaxLineBytes);
+  update_scroll_bars();
+}
+
+auto LargeFileViewer::IsGood() const -> bool { return base_ != nullptr; }
+
+auto LargeFileViewer::Text() const -> QString {
+  if (base_ == nullptr) return {};
+  return QString::fromUtf8(base_, static_cast<qsizetype>(size_));
+}
+
+auto LargeFileViewer::LineCount() const -> qint64 {
+  return static_cast<qint64>(line_starts_.size());
+}
+
+auto LargeFileViewer::line_text(qint64 line) const -> QString {
+  const auto begin = line_starts_[line];
+  auto end = line + 1 < LineCount() ? line_starts_[line + 1] - 1 : size_;
+  if (end > begin && base_[end - 1] == '\r') end--;
+
+  const auto length = std::min(end - begin, kMaxLineBytes);
+  return QString::fromUtf8(base_ + begin, static_cast<qsizetype>(length));
+}
+
+void LargeFileViewer::update_scroll_bars() {
+  const auto metrics = fontMetrics();
+  const auto line_height = std::max(1, metrics.lineSpacing());
+  const auto visible_lines = std::max(1, viewport()->height() / line_height);
+
+  verticalScrollBar()->setPageStep(visible_lines);
+  verticalScrollBar()->setRange(
+      0, static_cast<int>(std::max<qint64>(0, LineCount() - visible_lines)));
+
+  const auto text_width = static_cast<int>(std::min<qint64>(
+      max_line_length_ * metrics.averageCharWidth(), INT_MAX / 2));
+  horizontalScrollBar()->setPageStep(viewport()->width());
+  horizontalScrollBar()->setSingleStep(metrics.averageCharWidth());
+  horizontalScrollBar()->setRange(
+      0, std::max(0, text_width + 2 * kTextMargin - viewport()->width()));
+}
+
+void LargeFileViewer::paintEvent(QPaintEvent* /*event*/) {
+  QPainter painter(viewport());
+  painter.setFont(font());
+  painter.setPen(palette().color(QPalette::Text));
+
+  const auto metrics = fontMetrics();
+  const auto line_height = metrics.lineSpacing();
+  const auto x = kTextMargin - horizontalScrollBar()->value();
+
+  auto y = metrics.ascent();
+  for (qint64 line = verticalScrollBar()->value();
+       line < LineCount() && y - metrics.ascent() < viewport()->height();
+       line++, y += line_height) {
+    painter.drawText(x, y, line_text(line));
+  }
+}
+
+void LargeFileViewer::resizeEvent(QResizeEvent* event) {
+  QAbstractScrollArea::resizeEvent(event);
+  update_scroll_bars();
+}
+
+void LargeFileViewer::changeEvent(QEvent* event) {
+  QAbstractScrollArea::changeEvent(event);
+  if (event->type() == QEvent::FontChange) update_scroll_bars();
+}
+
+}  // namespace GpgFrontend::UI
@@ -0,0 +1,113 @@
+/**
+ * Copyright (C) 2021-2024 Saturneric <eric@bktus.com>
+ *
+ * This file is part of GpgFrontend.
+ *
+ * GpgFrontend is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * GpgFrontend is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with GpgFrontend. If not, see <https://www.gnu.org/licenses/>.
+ *
+ * The initial version of the source code is inherited from
+ * the gpg4usb project, which is under GPL-3.0-or-later.
+ *
+ * All the source code of GpgFrontend was modified and released by
+ * Saturneric <eric@bktus.com> starting on May 12, 2021.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ *
+ */
+#pragma once
+
+#include "ui/GpgFrontendUI.h"
+
+namespace GpgFrontend::UI {
+
+/**
+ * @brief a read only view of a large text file. the file is mapped into
+ * memory and only the visible lines are decoded and painted, so opening
+ * it costs one scan for line breaks instead of building a text document.
+ *
+ */
+class LargeFileViewer : public QAbstractScrollArea {
+  Q_OBJECT
+ public:
+  /**
+   * @brief Construct a new Large File Viewer object
+   *
+   * @param path
+   * @param parent
+   */
+  explicit LargeFileViewer(const QString& path, QWidget* parent = nullptr);
+
+  /**
+   * @brief
+   *
+   * @return true if the file is mapped
+   */
+  [[nodiscard]] auto IsGood() const -> bool;
+
+  /**
+   * @brief decode the whole file
+   *
+   * @return QString
+   */
+  [[nodiscard]] auto Text() const -> QString;
+
+  /**
+   * @brief
+   *
+   * @return qint64
+   */
+  [[nodiscard]] auto LineCount() const -> qint64;
+
+ protected:
+  /**
+   * @brief
+   *
+   */
+  void paintEvent(QPaintEvent*) override;
+
+  /**
+   * @brief
+   *
+   */
+  void resizeEvent(QResizeEvent*) override;
+
+  /**
+   * @brief
+   *
+   */
+  void changeEvent(QEvent*) override;
+
+ private:
+  QFile file_;
+  const char* base_ = nullptr;
+  qint64 size_ = 0;
+  std::vector<qint64> line_starts_;
+  qint64 max_line_length_ = 0;
+
+  /**
+   * @brief
+   *
+   */
+  void update_scroll_bars();
+
+  /**
+   * @brief
+   *
+   * @param line
+   * @return QString
+   */
+  [[nodiscard]] auto line_text(qint64 line) const -> QString;
+};
+
+}  // namespace GpgFrontend::UI
@@ -32,10 +32,46 @@
 #include "core/thread/FileReadTask.h"
 #include "core/thread/TaskRunnerGetter.h"
 #include "ui/struct/settings_object/AppearanceSO.h"
+#include "ui/widgets/LargeFileViewer.h"
 #include "ui_PlainTextEditor.h"
 
 namespace GpgFrontend::UI {
 
+namespace {
+
+// the first chunk matches the one FileReadTask starts with
+constexpr qint64 kInitialChunkSize = 256 * 1024;
+constexpr qint64 kMinChunkSize = 64 * 1024;
+constexpr qint64 kMaxChunkSize = 8 * 1024 * 1024;
+
+// grow the chunks while an insert fits well into a frame, shrink them
+// when it starts to make the ui stutter
+constexpr qint64 kFastInsertMs = 8;
+constexpr qint64 kSlowInsertMs = 32;
+
+/**
+ * @brief length of an incomplete utf-8 sequence at the end of the data
+ *
+ * @param data
+ * @return qsizetype
+ */
+auto IncompleteUtf8TailSize(const QByteArray &data) -> qsizetype {
+  const auto size = static_cast<qsizetype>(data.size());
+  for (qsizetype i = 1; i <= std::min<qsizetype>(3, size); i++) {
+    const auto c = static_cast<unsigned char>(data[size - i]);
+    if ((c & 0xC0) == 0x80) continue;
+
+    qsizetype need = 1;
+    if ((c & 0xE0) == 0xC0) need = 2;
+    if ((c & 0xF0) == 0xE0) need = 3;
+    if ((c & 0xF8) == 0xF0) need = 4;
+    return need > i ? i : 0;
+  }
+  return 0;
+}
+
+}  // namespace
+
 PlainTextEditorPage::PlainTextEditorPage(QString file_path, QWidget *parent)
     : QWidget(parent),
       ui_(GpgFrontend::SecureCreateSharedObject<Ui_PlainTextEditor>()),
@@ -62,9 +98,17 @@ PlainTextEditorPage::PlainTextEditorPage(QString file_path, QWidget *parent)
     // if file is loading
     if (!read_done_) return;
 
-    auto text = ui_->textPage->document()->toPlainText();
-    auto str = tr("%1 character(s)").arg(text.size());
-    this->ui_->characterLabel->setText(str);
+    // text put into a read only view (e.g. the result of an operation)
+    // replaces the view, and the page no longer stands for the file
+    if (large_file_viewer_ != nullptr) {
+      large_file_viewer_->deleteLater();
+      large_file_viewer_ = nullptr;
+      full_file_path_.clear();
+      ui_->textPage->setReadOnly(false);
+      ui_->textPage->setHidden(false);
+    }
+
+    update_character_count();
   });
 
   if (full_file_path_.isEmpty()) {
@@ -86,9 +130,21 @@ auto PlainTextEditorPage::GetTextPage() -> QPlainTextEdit * {
 }
 
 auto PlainTextEditorPage::GetPlainText() -> QString {
+  if (large_file_viewer_ != nullptr) return large_file_viewer_->Text();
   return ui_->textPage->toPlainText();
 }
 
+auto PlainTextEditorPage::IsReadOnlyView() const -> bool {
+  return large_file_viewer_ != nullptr;
+}
+
+void PlainTextEditorPage::update_character_count() {
+  // characterCount() is kept up to date by the document itself, unlike
+  // toPlainText() it doesn't copy the whole text
+  const auto count = ui_->textPage->document()->characterCount() - 1;
+  ui_->characterLabel->setText(tr("%1 character(s)").arg(count));
+}
+
 void PlainTextEditorPage::NotifyFileSaved() {
   this->is_crlf_ = false;
 
@@ -150,6 +206,16 @@ void PlainTextEditorPage::slot_format_gpg_header() {
 void PlainTextEditorPage::ReadFile() {
   read_done_ = false;
   read_bytes_ = 0;
+  pending_bytes_.clear();
+  chunk_size_ = kInitialChunkSize;
+
+  AppearanceSO appearance(SettingsObject("general_settings_state"));
+  const auto threshold =
+      static_cast<qint64>(appearance.large_file_view_threshold_mb) << 20;
+  if (threshold > 0 && QFileInfo(full_file_path_).size() > threshold &&
+      open_large_file_viewer()) {
+    return;
+  }
 
   auto *text_page = this->GetTextPage();
   text_page->setEnabled(false);
@@ -172,6 +238,13 @@ void PlainTextEditorPage::ReadFile() {
   connect(this, &PlainTextEditorPage::close, read_task,
           [=]() { emit read_task->SignalTaskShouldEnd(0); });
   connect(read_task, &FileReadTask::SignalFileBytesReadEnd, this, [=]() {
+    // whatever was held back for the next chunk
+    if (!pending_bytes_.isEmpty()) {
+      text_page->insertPlainText(QString::fromUtf8(pending_bytes_));
+      pending_bytes_.clear();
+    }
+    update_character_count();
+
     // set the UI
     FLOG_D("file read done");
     this->read_done_ = true;
@@ -186,6 +259,27 @@ void PlainTextEditorPage::ReadFile() {
   task_runner->PostTask(read_task);
 }
 
+auto PlainTextEditorPage::open_large_file_viewer() -> bool {
+  auto *viewer = new LargeFileViewer(full_file_path_, this);
+  if (!viewer->IsGood()) {
+    delete viewer;
+    return false;
+  }
+
+  viewer->setFont(ui_->textPage->font());
+  ui_->verticalLayout->insertWidget(
+      ui_->verticalLayout->indexOf(ui_->textPage), viewer);
+  ui_->textPage->setReadOnly(true);
+  ui_->textPage->setHidden(true);
+  large_file_viewer_ = viewer;
+
+  read_done_ = true;
+  ui_->loadingLabel->setHidden(true);
+  ui_->characterLabel->setText(
+      tr("%1 line(s), read only").arg(viewer->LineCount()));
+  return true;
+}
+
 auto BinaryToString(const QByteArray &source) -> QString {
   static const char kSyms[] = "0123456789ABCDEF";
   QString buffer;
@@ -195,34 +289,36 @@ auto BinaryToString(const QByteArray &source) -> QString {
 }
 
 void PlainTextEditorPage::slot_insert_text(QByteArray bytes_data) {
-  // If the previous data ended with a '\r' and the current data starts with
-  // '\n', combine them to form a complete '\r\n' to avoid incorrect line
-  // breaks.
-  if (last_insert_has_partial_cr_ && !bytes_data.isEmpty() &&
-      bytes_data.startsWith('\n')) {
-    bytes_data.prepend('\r');  // Prepend '\r' to ensure '\r\n' stays together.
-  }
+  QElapsedTimer timer;
+  timer.start();
 
-  // Check if the current data ends with '\r'.
-  if (!bytes_data.isEmpty() && bytes_data.endsWith('\r')) {
-    // If the data ends with '\r', set the flag indicating an incomplete line
-    // ending.
-    last_insert_has_partial_cr_ = true;
-    // Remove the trailing '\r' and hold it for the next chunk of data.
-    bytes_data.chop(1);
-  } else {
-    // If the data does not end with '\r', reset the flag.
-    last_insert_has_partial_cr_ = false;
-  }
+  bytes_data.prepend(pending_bytes_);
+
+  // hold back an incomplete utf-8 character so that it is decoded as a
+  // whole, and a trailing '\r' so that a '\r\n' split between two chunks
+  // doesn't turn into two line breaks.
+  auto hold = IncompleteUtf8TailSize(bytes_data);
+  if (hold == 0 && bytes_data.endsWith('\r')) hold = 1;
+  pending_bytes_ = bytes_data.right(hold);
+  bytes_data.chop(hold);
 
   read_bytes_ += bytes_data.size();
 
   // insert the text to the text page
-  this->ui_->textPage->insertPlainText(bytes_data);
-  this->ui_->characterLabel->setText(
-      tr("%1 character(s)").arg(this->GetTextPage()->toPlainText().size()));
+  this->ui_->textPage->insertPlainText(QString::fromUtf8(bytes_data));
+  update_character_count();
+
+  const auto elapsed = timer.elapsed();
+  if (elapsed < kFastInsertMs) {
+    chunk_size_ = std::min(chunk_size_ * 2, kMaxChunkSize);
+  } else if (elapsed > kSlowInsertMs) {
+    chunk_size_ = std::max(chunk_size_ / 2, kMinChunkSize);
+  }
 
-  QTimer::singleShot(25, this, &PlainTextEditorPage::SignalUIBytesDisplayed);
+  // ask for the next chunk only after the pending paint and input events
+  // have been handled, instead of sleeping for a fixed time
+  QTimer::singleShot(0, this,
+                     [=]() { emit SignalUIBytesDisplayed(chunk_size_); });
 }
 
 }  // namespace GpgFrontend::UI
@@ -32,6 +32,8 @@ class Ui_PlainTextEditor;
 
 namespace GpgFrontend::UI {
 
+class LargeFileViewer;
+
 /**
  * @brief Class for handling a single tab of the tabwidget
  *
@@ -101,6 +103,15 @@ class PlainTextEditorPage : public QWidget {
    */
   [[nodiscard]] bool ReadDone() const { return this->read_done_; }
 
+  /**
+   * @brief whether the file is too large for the editor and shown in a
+   * read only view instead
+   *
+   * @return true
+   * @return false
+   */
+  [[nodiscard]] auto IsReadOnlyView() const -> bool;
+
   /**
    * @brief notify the user that the file has been saved.
    *
@@ -112,8 +123,9 @@ class PlainTextEditorPage : public QWidget {
   /**
    * @brief this signal is emitted when the bytes has been append in texteditor.
    *
+   * @param next_chunk_size how many bytes the editor wants next
    */
-  void SignalUIBytesDisplayed();
+  void SignalUIBytesDisplayed(qint64 next_chunk_size);
 
  protected:
   QSharedPointer<Ui_PlainTextEditor> ui_;  ///<
@@ -124,7 +136,23 @@ class PlainTextEditorPage : public QWidget {
   bool read_done_ = false;  ///<
   size_t read_bytes_ = 0;   ///<
   bool is_crlf_ = false;    ///<
-  bool last_insert_has_partial_cr_ = false;
+  QByteArray pending_bytes_;  ///< a trailing '\r' or incomplete utf-8 char
+  qint64 chunk_size_ = 0;     ///< adapted to the time an insert takes
+  LargeFileViewer* large_file_viewer_ = nullptr;  ///<
+
+  /**
+   * @brief show the file in a LargeFileViewer
+   *
+   * @return true
+   * @return false
+   */
+  auto open_large_file_viewer() -> bool;
+
+  /**
+   * @brief
+   *
+   */
+  void update_character_count();
 
  private slots:
 
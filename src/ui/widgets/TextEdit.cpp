@@ -172,6 +172,17 @@ auto TextEdit::saveFile(const QString& file_name) -> bool {
   PlainTextEditorPage* page = CurPageTextEdit();
   if (page == nullptr) return false;
 
+  // a read only view is never modified, it can only be saved elsewhere
+  if (page->IsReadOnlyView()) {
+    if (file_name == page->GetFilePath()) return true;
+    if (!copy_file_atomically(page->GetFilePath(), file_name)) {
+      QMessageBox::warning(this, tr("Warning"),
+                           tr("Cannot write file %1.").arg(file_name));
+      return false;
+    }
+    return true;
+  }
+
   QFile file(file_name);
   if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
     QTextStream output_stream(&file);
@@ -196,6 +207,29 @@ auto TextEdit::saveFile(const QString& file_name) -> bool {
   return false;
 }
 
+auto TextEdit::copy_file_atomically(const QString& from, const QString& to)
+    -> bool {
+  QFile source(from);
+  if (!source.open(QIODevice::ReadOnly)) return false;
+
+  // the target is only replaced once the whole copy has been written
+  QSaveFile target(to);
+  if (!target.open(QIODevice::WriteOnly)) return false;
+
+  QApplication::setOverrideCursor(Qt::WaitCursor);
+  QByteArray chunk;
+  while (!(chunk = source.read(1024 * 1024)).isEmpty()) {
+    if (target.write(chunk) != chunk.size()) break;
+  }
+  QApplication::restoreOverrideCursor();
+
+  if (!source.atEnd()) {
+    target.cancelWriting();
+    return false;
+  }
+  return target.commit();
+}
+
 auto TextEdit::saveEMLFile(const QString& file_name) -> bool {
   if (file_name.isEmpty()) return false;
 
@@ -315,6 +315,16 @@ class TextEdit : public QWidget {
    */
   auto saveEMLFile(const QString& file_name) -> bool;
 
+  /**
+   * @brief copy a file so that the target is either fully replaced or left
+   * untouched
+   *
+   * @param from
+   * @param to
+   * @return true on success
+   */
+  auto copy_file_atomically(const QString& from, const QString& to) -> bool;
+
  private slots:
 
   /**